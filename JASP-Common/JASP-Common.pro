@@ -74,6 +74,9 @@ HEADERS += \
 	datablock.h \
 	dataset.h \
 	dirs.h \
+	enginecounters.h \
+	engineexitstatus.h \
+	engineprogress.h \
 	filereader.h \
 	ipcchannel.h \
 	label.h \
@@ -90,6 +93,7 @@ HEADERS += \
   timers.h \
   enumutilities.h \
     stringutils.h \
+    fastjson.h \
     log.h
 
 #exists(/app/lib/*) should only be true when building flatpak
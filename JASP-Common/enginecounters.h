@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ENGINECOUNTERS_H
+#define ENGINECOUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+
+static_assert(ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "engineCounters is shared between processes and needs lock free 64 bit atomics for that");
+
+///A plain copy of engineCounters, for the desktop to keep samples of and take differences between.
+struct engineCounterValues
+{
+	uint64_t	requests			= 0,
+				dataExtractionUs	= 0,
+				rEvalUs				= 0,
+				serializationUs		= 0,
+				rssKB				= 0,
+				lastUpdateMs		= 0;
+};
+
+/* engineCounters lives in the control segment of an IPCChannel, the jaspEngine adds to it while it works and the desktop simply reads it whenever it likes.
+ * Only the engine writes to it and every field is a lock free atomic, so there is no need for a mutex or for sending messages about it and the desktop never sees half of a value.
+ * The fields are independent of each other, so relaxed loads are enough and values() can be a tiny bit inconsistent between fields, which does not matter for statistics.
+ * All counters only go up (except rssKB), the desktop takes the difference between two samples to see what happened in between.
+ */
+struct engineCounters
+{
+	std::atomic<uint64_t>	requests			{ 0 },	///< Messages from the desktop the engine has handled
+							dataExtractionUs	{ 0 },	///< Time spent reading the dataset out of shared memory for R
+							rEvalUs				{ 0 },	///< Time spent running R code: analyses, filters, computed columns and rCode. Includes the data extraction and serialization that happen while R runs
+							serializationUs		{ 0 },	///< Time spent parsing incoming and writing outgoing json
+							rssKB				{ 0 },	///< Resident memory of the engine, updated every time it gets around to it
+							lastUpdateMs		{ 0 };	///< Milliseconds since the epoch of the last time rssKB was updated
+
+	engineCounterValues values() const
+	{
+		engineCounterValues copy;
+
+		copy.requests			= requests			.load(std::memory_order_relaxed);
+		copy.dataExtractionUs	= dataExtractionUs	.load(std::memory_order_relaxed);
+		copy.rEvalUs			= rEvalUs			.load(std::memory_order_relaxed);
+		copy.serializationUs	= serializationUs	.load(std::memory_order_relaxed);
+		copy.rssKB				= rssKB				.load(std::memory_order_relaxed);
+		copy.lastUpdateMs		= lastUpdateMs		.load(std::memory_order_relaxed);
+
+		return copy;
+	}
+};
+
+///Adds the time between construction and destruction in microseconds to one of the counters, does nothing when counters is nullptr.
+class engineCounterTimer
+{
+public:
+	engineCounterTimer(engineCounters * counters, std::atomic<uint64_t> engineCounters::* counter)
+		: _counter(counters ? &(counters->*counter) : nullptr), _started(std::chrono::steady_clock::now()) {}
+
+	~engineCounterTimer()
+	{
+		if(_counter)
+			_counter->fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _started).count(), std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint64_t>					*	_counter;
+	std::chrono::steady_clock::time_point		_started;
+};
+
+#endif // ENGINECOUNTERS_H
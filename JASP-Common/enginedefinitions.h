@@ -7,6 +7,7 @@ DECLARE_ENUM(engineState,			initializing, idle, analysis, filter, rCode, compute
 DECLARE_ENUM(performType,			init, run, abort, saveImg, editImg, rewriteImgs);
 DECLARE_ENUM(analysisResultStatus,	validationError, fatalError, imageSaved, imageEdited, imagesRewritten, complete, inited, running, changed, waiting);
 DECLARE_ENUM(moduleStatus,			uninitialized, installNeeded, loadingNeeded, unloadingNeeded, readyForUse, error);
+DECLARE_ENUM(zygoteRequest,			forkEngine, preloadPackages, stopRequested);
 DECLARE_ENUM(engineAnalysisStatus,	empty, toInit, initing, inited, toRun, running, changed, complete, error, exception, aborted, stopped, saveImg, editImg, rewriteImgs, synchingData);
 
 #endif // ENGINEDEFINITIONS_H
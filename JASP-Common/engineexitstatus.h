@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ENGINEEXITSTATUS_H
+#define ENGINEEXITSTATUS_H
+
+#include <atomic>
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "engineExitStatus is shared between processes and needs lock free atomics for that");
+
+/* engineExitStatus lives in the control segment of the IPCChannel of a jaspEngine and is only used when that engine was forked by the zygote (see enginezygote.h).
+ * The zygote is the parent of such an engine, so it is the one that can waitpid for it, and it writes the exit status here as soon as it did.
+ * Until then the PID cannot be reused by another process, so while exited() is false the desktop knows the PID still belongs to its engine.
+ */
+struct engineExitStatus
+{
+	std::atomic<int>	exitCode	{ 0 },	///< -1 when it did not exit by itself
+						signal		{ 0 },	///< The signal that ended it, 0 if none did
+						pid			{ 0 };	///< Of the engine that exited, written last
+
+	void set(int exitedPid, int newExitCode, int newSignal)
+	{
+		exitCode.store(newExitCode,	std::memory_order_relaxed);
+		signal	.store(newSignal,	std::memory_order_relaxed);
+		pid		.store(exitedPid,	std::memory_order_release);
+	}
+
+	bool exited(int enginePid)	const { return pid.load(std::memory_order_acquire) == enginePid;									}
+	bool crashed()				const { return exitCode.load(std::memory_order_relaxed) != 0 || signal.load(std::memory_order_relaxed) != 0;	}
+};
+
+#endif // ENGINEEXITSTATUS_H
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ENGINEPROGRESS_H
+#define ENGINEPROGRESS_H
+
+#include <atomic>
+#include <cstdint>
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "engineProgress is shared between processes and needs lock free atomics for that");
+
+/* engineProgress lives next to the engineCounters in the control segment of an IPCChannel and holds the progressbar of the analysis the jaspEngine is running.
+ * A tick of a progressbar only changes a few ints here, instead of sending the (partial) results all over again, and EngineRepresentation picks it up whenever it polls its engine.
+ * The fields are guarded by updates as a seqlock: the engine makes it odd before it writes them and even again after, the desktop reads updates before and after the fields and throws away what it read when updates was odd or changed in between.
+ * That way the desktop never combines the analysis of one tick with the progress of another, and it ignores progress that belongs to another analysis or revision.
+ */
+struct engineProgress
+{
+	std::atomic<int>		analysisId	{ -1 },
+							revision	{ -1 },
+							progress	{ -1 };
+	std::atomic<uint32_t>	updates		{ 0 };
+
+	///Only the jaspEngine writes, and only from one thread
+	void set(int newAnalysisId, int newRevision, int newProgress)
+	{
+		uint32_t writing = updates.load(std::memory_order_relaxed) + 1;
+
+		updates		.store(writing,			std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		analysisId	.store(newAnalysisId,	std::memory_order_relaxed);
+		revision	.store(newRevision,		std::memory_order_relaxed);
+		progress	.store(newProgress,		std::memory_order_relaxed);
+
+		updates		.store(writing + 1,		std::memory_order_release);
+	}
+
+	///Returns false when the engine was writing at the same time, then the arguments are garbage and it is best to look again at the next poll.
+	bool read(int & readAnalysisId, int & readRevision, int & readProgress, uint32_t & readUpdates) const
+	{
+		readUpdates		= updates.load(std::memory_order_acquire);
+
+		if(readUpdates % 2 == 1)
+			return false;
+
+		readAnalysisId	= analysisId.load(std::memory_order_relaxed);
+		readRevision	= revision	.load(std::memory_order_relaxed);
+		readProgress	= progress	.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		return updates.load(std::memory_order_relaxed) == readUpdates;
+	}
+};
+
+#endif // ENGINEPROGRESS_H
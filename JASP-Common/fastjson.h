@@ -0,0 +1,425 @@
+#ifndef FASTJSON_H
+#define FASTJSON_H
+
+#ifndef JSON_JSON_H_INCLUDED
+#include "jsonredirect.h"
+#endif
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <clocale>
+
+///Compact writer and lean parser for the Json that goes between engine and desktop.
+///toStyledString indents everything and Json::Reader tokenizes, collects errors and looks for comments, these skip all of that.
+///Header-only so that jaspResults can use it when it is built as an R package.
+class fastJson
+{
+public:
+	///Same Json as Json::FastWriter but without the trailing newline and written straight into one string
+	inline static std::string write(const Json::Value & value)
+	{
+		std::string out;
+		out.reserve(256);
+		write(out, value);
+		return out;
+	}
+
+	inline static void write(std::string & out, const Json::Value & value)
+	{
+		switch(value.type())
+		{
+		case Json::nullValue:		out += "null";								return;
+		case Json::booleanValue:	out += value.asBool() ? "true" : "false";	return;
+#ifdef JSON_HAS_INT64
+		case Json::intValue:		writeInteger(out, value.asLargestInt());	return;
+		case Json::uintValue:		writeUnsigned(out, value.asLargestUInt());	return;
+#else
+		case Json::intValue:		writeInteger(out, value.asInt());			return;
+		case Json::uintValue:		writeUnsigned(out, value.asUInt());			return;
+#endif
+		case Json::realValue:		out += Json::valueToString(value.asDouble());	return;
+		case Json::stringValue:		writeString(out, value.asCString());		return;
+
+		case Json::arrayValue:
+			out.push_back('[');
+			for(Json::Value::UInt i=0; i<value.size(); i++)
+			{
+				if(i > 0) out.push_back(',');
+				write(out, value[i]);
+			}
+			out.push_back(']');
+			return;
+
+		case Json::objectValue:
+		{
+			out.push_back('{');
+			bool first = true;
+			for(Json::Value::const_iterator it = value.begin(); it != value.end(); ++it)
+			{
+				if(!first) out.push_back(',');
+				first = false;
+
+				writeString(out, it.memberName());
+				out.push_back(':');
+				write(out, *it);
+			}
+			out.push_back('}');
+			return;
+		}
+		}
+	}
+
+	///Replaces out with the parsed document, returns false on malformed input (including anything but whitespace after the document) just like Json::Reader::parse.
+	inline static bool parse(const std::string & in, Json::Value & out)
+	{
+		const char	*	cur = in.data(),
+					*	end = cur + in.size();
+
+		out = Json::Value();
+
+		if(!parseValue(cur, end, out))
+			return false;
+
+		skipWhitespace(cur, end);
+
+		return cur == end;
+	}
+
+private:
+	inline static void writeUnsigned(std::string & out, unsigned long long number)
+	{
+		char	buffer[24];
+		int		pos = sizeof(buffer);
+
+		do	{ buffer[--pos] = '0' + (number % 10); number /= 10; }
+		while(number > 0);
+
+		out.append(buffer + pos, sizeof(buffer) - pos);
+	}
+
+	inline static void writeInteger(std::string & out, long long number)
+	{
+		if(number < 0)
+		{
+			out.push_back('-');
+			writeUnsigned(out, 0ULL - static_cast<unsigned long long>(number));
+		}
+		else
+			writeUnsigned(out, number);
+	}
+
+	inline static void writeString(std::string & out, const char * str)
+	{
+		static const char hex[] = "0123456789abcdef";
+
+		out.push_back('"');
+
+		const char * plainStart = str;
+
+		for(const char * kar = str; ; kar++)
+		{
+			unsigned char code = static_cast<unsigned char>(*kar);
+
+			if(code != 0 && code >= 0x20 && code != '"' && code != '\\')
+				continue;
+
+			out.append(plainStart, kar - plainStart);
+			plainStart = kar + 1;
+
+			switch(code)
+			{
+			case 0:		out.push_back('"');	return;
+			case '"':	out += "\\\"";		break;
+			case '\\':	out += "\\\\";		break;
+			case '\b':	out += "\\b";		break;
+			case '\f':	out += "\\f";		break;
+			case '\n':	out += "\\n";		break;
+			case '\r':	out += "\\r";		break;
+			case '\t':	out += "\\t";		break;
+			default:
+				out += "\\u00";
+				out.push_back(hex[code >> 4]);
+				out.push_back(hex[code & 0xf]);
+				break;
+			}
+		}
+	}
+
+	inline static void skipWhitespace(const char *& cur, const char * end)
+	{
+		while(cur < end && (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t'))
+			cur++;
+	}
+
+	inline static bool parseLiteral(const char *& cur, const char * end, const char * literal)
+	{
+		size_t length = strlen(literal);
+
+		if(static_cast<size_t>(end - cur) < length || strncmp(cur, literal, length) != 0)
+			return false;
+
+		cur += length;
+		return true;
+	}
+
+	inline static bool parseValue(const char *& cur, const char * end, Json::Value & out)
+	{
+		skipWhitespace(cur, end);
+
+		if(cur == end)
+			return false;
+
+		switch(*cur)
+		{
+		case '{':	return parseObject(cur, end, out);
+		case '[':	return parseArray(cur, end, out);
+		case 't':	out = true;				return parseLiteral(cur, end, "true");
+		case 'f':	out = false;			return parseLiteral(cur, end, "false");
+		case 'n':	out = Json::Value();	return parseLiteral(cur, end, "null");
+		case '"':
+		{
+			std::string str;
+			if(!parseString(cur, end, str))
+				return false;
+
+			out = str;
+			return true;
+		}
+		default:	return parseNumber(cur, end, out);
+		}
+	}
+
+	inline static bool parseObject(const char *& cur, const char * end, Json::Value & out)
+	{
+		out = Json::Value(Json::objectValue);
+		cur++;
+
+		skipWhitespace(cur, end);
+		if(cur < end && *cur == '}')
+		{
+			cur++;
+			return true;
+		}
+
+		std::string name;
+
+		while(cur < end)
+		{
+			skipWhitespace(cur, end);
+			if(cur == end || *cur != '"' || !parseString(cur, end, name))
+				return false;
+
+			skipWhitespace(cur, end);
+			if(cur == end || *cur++ != ':')
+				return false;
+
+			if(!parseValue(cur, end, out[name])) //parsed in place, so no subtree gets copied
+				return false;
+
+			skipWhitespace(cur, end);
+			if(cur == end)
+				return false;
+
+			switch(*cur++)
+			{
+			case ',':	break;
+			case '}':	return true;
+			default:	return false;
+			}
+		}
+
+		return false;
+	}
+
+	inline static bool parseArray(const char *& cur, const char * end, Json::Value & out)
+	{
+		out = Json::Value(Json::arrayValue);
+		cur++;
+
+		skipWhitespace(cur, end);
+		if(cur < end && *cur == ']')
+		{
+			cur++;
+			return true;
+		}
+
+		while(cur < end)
+		{
+			if(!parseValue(cur, end, out[out.size()]))
+				return false;
+
+			skipWhitespace(cur, end);
+			if(cur == end)
+				return false;
+
+			switch(*cur++)
+			{
+			case ',':	break;
+			case ']':	return true;
+			default:	return false;
+			}
+		}
+
+		return false;
+	}
+
+	inline static int hexValue(char kar)
+	{
+		if(kar >= '0' && kar <= '9') return kar - '0';
+		if(kar >= 'a' && kar <= 'f') return kar - 'a' + 10;
+		if(kar >= 'A' && kar <= 'F') return kar - 'A' + 10;
+		return -1;
+	}
+
+	inline static bool parseHex4(const char *& cur, const char * end, unsigned int & code)
+	{
+		if(end - cur < 4)
+			return false;
+
+		code = 0;
+		for(int i=0; i<4; i++)
+		{
+			int digit = hexValue(*cur++);
+			if(digit < 0)
+				return false;
+			code = (code << 4) | digit;
+		}
+
+		return true;
+	}
+
+	inline static void appendUtf8(std::string & out, unsigned int code)
+	{
+		if(code < 0x80)				out.push_back(static_cast<char>(code));
+		else if(code < 0x800)		{ out.push_back(static_cast<char>(0xc0 | (code >> 6)));		out.push_back(static_cast<char>(0x80 | (code & 0x3f))); }
+		else if(code < 0x10000)		{ out.push_back(static_cast<char>(0xe0 | (code >> 12)));	out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));	out.push_back(static_cast<char>(0x80 | (code & 0x3f))); }
+		else						{ out.push_back(static_cast<char>(0xf0 | (code >> 18)));	out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));	out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));	out.push_back(static_cast<char>(0x80 | (code & 0x3f))); }
+	}
+
+	inline static bool parseString(const char *& cur, const char * end, std::string & out)
+	{
+		out.clear();
+		cur++;
+
+		const char * plainStart = cur;
+
+		while(cur < end)
+		{
+			char kar = *cur;
+
+			if(kar == '"')
+			{
+				out.append(plainStart, cur - plainStart);
+				cur++;
+				return true;
+			}
+
+			if(kar != '\\')
+			{
+				cur++;
+				continue;
+			}
+
+			out.append(plainStart, cur - plainStart);
+
+			if(++cur == end)
+				return false;
+
+			switch(*cur++)
+			{
+			case '"':	out.push_back('"');		break;
+			case '\\':	out.push_back('\\');	break;
+			case '/':	out.push_back('/');		break;
+			case 'b':	out.push_back('\b');	break;
+			case 'f':	out.push_back('\f');	break;
+			case 'n':	out.push_back('\n');	break;
+			case 'r':	out.push_back('\r');	break;
+			case 't':	out.push_back('\t');	break;
+			case 'u':
+			{
+				unsigned int code;
+				if(!parseHex4(cur, end, code))
+					return false;
+
+				if(code >= 0xd800 && code <= 0xdbff) //high surrogate, must be followed by the low one
+				{
+					unsigned int low;
+					if(end - cur < 2 || cur[0] != '\\' || cur[1] != 'u')
+						return false;
+
+					cur += 2;
+					if(!parseHex4(cur, end, low) || low < 0xdc00 || low > 0xdfff)
+						return false;
+
+					code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+				}
+
+				appendUtf8(out, code);
+				break;
+			}
+			default:
+				return false;
+			}
+
+			plainStart = cur;
+		}
+
+		return false;
+	}
+
+	///Integers become Int when they fit, UInt when they are too big for that and double otherwise, just as in Json::Reader
+	inline static bool parseNumber(const char *& cur, const char * end, Json::Value & out)
+	{
+		const char	*	start		= cur;
+		bool			isDouble	= false,
+						isNegative	= cur < end && *cur == '-';
+
+		if(isNegative)
+			cur++;
+
+		const char * digitsStart = cur;
+
+		while(cur < end && ((*cur >= '0' && *cur <= '9') || *cur == '.' || *cur == 'e' || *cur == 'E' || *cur == '+' || *cur == '-'))
+		{
+			if(*cur < '0' || *cur > '9')
+				isDouble = true;
+			cur++;
+		}
+
+		if(cur == digitsStart)
+			return false;
+
+		if(!isDouble && cur - digitsStart < 19)
+		{
+			unsigned long long value = 0;
+			for(const char * digit = digitsStart; digit < cur; digit++)
+				value = value * 10 + (*digit - '0');
+
+			if(isNegative && value <= 0ULL - static_cast<unsigned long long>(Json::Value::minInt))	{ out = static_cast<Json::Value::Int>(0LL - static_cast<long long>(value));	return true; }
+			if(!isNegative && value <= static_cast<unsigned long long>(Json::Value::maxInt))			{ out = static_cast<Json::Value::Int>(value);									return true; }
+			if(!isNegative && value <= static_cast<unsigned long long>(Json::Value::maxUInt))			{ out = static_cast<Json::Value::UInt>(value);									return true; }
+		}
+
+		std::string		number(start, cur);
+
+		//strtod follows the C locale, which Qt sets to that of the user on Unix, so the point has to become whatever decimal separator that locale expects (json_writer does the reverse)
+		const char * decimalPoint = localeconv()->decimal_point;
+		if(decimalPoint != nullptr && std::strcmp(decimalPoint, ".") != 0)
+		{
+			size_t point = number.find('.');
+			if(point != std::string::npos)
+				number.replace(point, 1, decimalPoint);
+		}
+
+		char		*	numberEnd;
+		double			value = strtod(number.c_str(), &numberEnd);
+
+		if(numberEnd != number.c_str() + number.size())
+			return false;
+
+		out = value;
+		return true;
+	}
+};
+
+#endif // FASTJSON_H
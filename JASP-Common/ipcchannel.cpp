@@ -28,7 +28,7 @@ using namespace boost::posix_time;
 
 IPCChannel::IPCChannel(std::string name, size_t channelNumber, bool isSlave)
 	:
-	  _baseName(		name + "#" + std::to_string(channelNumber)	),
+	  _baseName(		controlName(name, channelNumber)			),
 	  _nameControl(		name + "_control"							),
 	  _nameMtS(			name + "_MasterToSlave"						),
 	  _nameStM(			name + "_SlaveToMaster"						),
@@ -39,6 +39,9 @@ IPCChannel::IPCChannel(std::string name, size_t channelNumber, bool isSlave)
 
 	_sizeMtoS				= _memoryControl->find_or_construct<size_t>("sizeMasterToSlave")(1024 * 1024 * 8);
 	_sizeStoM				= _memoryControl->find_or_construct<size_t>("sizeSlaveToMaster")(1024 * 1024 * 8);
+	_counters				= _memoryControl->find_or_construct<engineCounters>("engineCounters")();
+	_progress				= _memoryControl->find_or_construct<engineProgress>("engineProgress")();
+	_exitStatus				= _memoryControl->find_or_construct<engineExitStatus>("engineExitStatus")();
 
 	_memoryMasterToSlave	= new interprocess::managed_shared_memory(interprocess::open_or_create, _nameMtS.c_str(), *_sizeMtoS);
 	_memorySlaveToMaster	= new interprocess::managed_shared_memory(interprocess::open_or_create, _nameStM.c_str(), *_sizeStoM);
@@ -211,6 +214,7 @@ void IPCChannel::send(string &data, bool alreadyLockedMutex)
 	try
 	{
 		_dataOut->assign(data.begin(), data.end());
+		_bytesSent += data.size();
 	}
 	catch (boost::interprocess::bad_alloc &e)	{ goto retryAfterDoublingMemory; }
 	catch (std::length_error &e)				{ goto retryAfterDoublingMemory; }
@@ -253,6 +257,7 @@ bool IPCChannel::receive(string &data, int timeout)
 		{
 			rebindMemoryInIfSizeChanged();
 			data.assign(_dataIn->c_str(), _dataIn->size());
+			_bytesReceived += data.size();
 		}
 		catch(std::exception & e)
 		{
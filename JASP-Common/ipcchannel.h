@@ -36,6 +36,9 @@
 
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/container/string.hpp>
+#include "enginecounters.h"
+#include "engineprogress.h"
+#include "engineexitstatus.h"
 
 typedef boost::interprocess::allocator<char,	boost::interprocess::managed_shared_memory::segment_manager	> CharAllocator;
 typedef boost::container::basic_string<char,	std::char_traits<char>, CharAllocator						> String;
@@ -53,6 +56,14 @@ public:
 
 	size_t channelNumber() { return _channelNumber; }
 
+	engineCounters	*	counters()				{ return _counters;			}
+	engineProgress	*	progress()				{ return _progress;			}
+	engineExitStatus*	exitStatus()			{ return _exitStatus;		}
+
+	static std::string	controlName(const std::string & name, size_t channelNumber) { return name + "#" + std::to_string(channelNumber); } ///< Of the shared memory that holds counters(), progress() and exitStatus()
+	size_t				bytesSent()		const	{ return _bytesSent;		}
+	size_t				bytesReceived()	const	{ return _bytesReceived;	}
+
 private:
 	bool tryWait(int timeout = 0);
 
@@ -80,7 +91,12 @@ private:
 												*	_sizeIn					= nullptr,
 												*	_sizeOut				= nullptr,
 													_previousSizeIn,
-													_previousSizeOut;
+													_previousSizeOut,
+													_bytesSent				= 0,
+													_bytesReceived			= 0;
+	engineCounters								*	_counters				= nullptr;
+	engineProgress								*	_progress				= nullptr;
+	engineExitStatus							*	_exitStatus				= nullptr;
 	std::string										_mutexInName,
 													_mutexOutName,
 													_dataInName,
@@ -1,5 +1,6 @@
 #define ENUM_DECLARATION_CPP
 #include "log.h"
+#include "timers.h"
 #include "boost/nowide/cstdio.hpp"
 #include <chrono>
 #ifdef WIN32
@@ -118,6 +119,7 @@ Json::Value	Log::createLogCfgMsg()
 	Json::Value json	= Json::objectValue;
 
 	json["where"]		= logTypeToString(_where);
+	json["tracing"]		= JaspTimer::enabled();
 
 	return json;
 }
@@ -125,6 +127,7 @@ Json::Value	Log::createLogCfgMsg()
 void Log::parseLogCfgMsg(const Json::Value & json)
 {
 	setWhere(logTypeFromString(json["where"].asString()));
+	JaspTimer::setEnabled(json.get("tracing", JaspTimer::enabled()).asBool());
 }
 
 std::ostream & Log::log()
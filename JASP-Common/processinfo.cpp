@@ -20,8 +20,20 @@
 #ifdef _WIN32
 #include <windows.h>
 #include <tlhelp32.h>
+#include <psapi.h>
 #else
 #include "unistd.h"
+#include <sys/resource.h>
+#endif
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#include <sstream>
+#include <string>
 #endif
 
 unsigned long ProcessInfo::currentPID()
@@ -89,3 +101,150 @@ bool ProcessInfo::isParentRunning()
 	return getppid() != 1;
 #endif
 }
+
+bool ProcessInfo::memoryUsage(unsigned long pid, processMemory & memory)
+{
+	memory = processMemory();
+
+#ifdef __linux__
+	const std::string procDir = "/proc/" + std::to_string(pid) + "/";
+
+	//smaps_rollup (kernel 4.14+) has the shared and private pages summed over all mappings, which is exactly what we need to see what the forks share.
+	std::ifstream rollup(procDir + "smaps_rollup");
+
+	if(rollup.is_open())
+	{
+		std::string line;
+
+		while(std::getline(rollup, line))
+		{
+			std::istringstream	fields(line);
+			std::string			field;
+			unsigned long		kB = 0;
+
+			if(!(fields >> field >> kB))
+				continue;
+
+			if		(field == "Rss:")											memory.rss				 = kB;
+			else if	(field == "Pss:")											memory.pss				 = kB;
+			else if	(field == "Shared_Clean:"	|| field == "Shared_Dirty:")	memory.sharedMemory		+= kB;
+			else if	(field == "Private_Clean:"	|| field == "Private_Dirty:")	memory.privateMemory	+= kB;
+		}
+
+		return memory.rss > 0;
+	}
+
+	//statm only knows about resident and file-backed shared pages, but that is better than nothing
+	std::ifstream statm(procDir + "statm");
+	unsigned long size, resident, shared;
+
+	if(!(statm >> size >> resident >> shared))
+		return false;
+
+	const unsigned long pageKB = sysconf(_SC_PAGESIZE) / 1024;
+
+	memory.rss				= resident * pageKB;
+	memory.sharedMemory		= shared * pageKB;
+	memory.privateMemory	= (resident - shared) * pageKB;
+
+	return true;
+#else
+	(void)pid;
+	return false;
+#endif
+}
+
+unsigned long long ProcessInfo::cpuTimeMs()
+{
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+
+	if(!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+		return 0;
+
+	auto toMs = [](const FILETIME & time) { return ((unsigned long long)(time.dwHighDateTime) << 32 | time.dwLowDateTime) / 10000; }; //FILETIME counts 100ns
+
+	return toMs(kernel) + toMs(user);
+#else
+	rusage usage;
+
+	if(getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	return	(unsigned long long)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+			(unsigned long long)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#endif
+}
+
+unsigned long ProcessInfo::currentRSS()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize / 1024 : 0;
+#elif defined(__APPLE__)
+	mach_task_basic_info		info;
+	mach_msg_type_number_t		count = MACH_TASK_BASIC_INFO_COUNT;
+
+	return task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS ? info.resident_size / 1024 : 0;
+#elif defined(__linux__)
+	std::ifstream	statm("/proc/self/statm");
+	unsigned long	size, resident;
+
+	return statm >> size >> resident ? resident * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+#else
+	return 0;
+#endif
+}
+
+unsigned long ProcessInfo::peakRSS()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize / 1024 : 0;
+#else
+#ifdef __linux__
+	//VmHWM is what resetPeakRSS resets, ru_maxrss is not
+	std::ifstream	status("/proc/self/status");
+	std::string		line;
+
+	while(std::getline(status, line))
+		if(line.compare(0, 6, "VmHWM:") == 0)
+			return std::stoul(line.substr(6));
+#endif
+	rusage usage;
+
+	if(getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024; //bytes on macOS
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+bool ProcessInfo::resetPeakRSS()
+{
+#ifdef __linux__
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+
+	return clearRefs.good();
+#else
+	return false;
+#endif
+}
+
+unsigned long ProcessInfo::currentDataSize()
+{
+#ifdef __linux__
+	std::ifstream	status("/proc/self/status");
+	std::string		line;
+
+	while(std::getline(status, line))
+		if(line.compare(0, 7, "VmData:") == 0)
+			return std::stoul(line.substr(7));
+#endif
+	return 0;
+}
@@ -18,6 +18,15 @@
 #ifndef PROCESSINFO_H
 #define PROCESSINFO_H
 
+///Memory of a process in kB, shared is what it has in common with other processes (like the pages a forked jaspEngine still shares with the zygote)
+struct processMemory
+{
+	unsigned long	rss				= 0,
+					pss				= 0,	///< Proportional set size: shared pages divided by the number of processes sharing them
+					sharedMemory	= 0,
+					privateMemory	= 0;
+};
+
 class ProcessInfo
 {
 public:
@@ -27,6 +36,20 @@ public:
 
 	static bool isParentRunning();
 
+	///Only implemented on Linux for now, returns false if the memory of pid could not be read.
+	static bool memoryUsage(unsigned long pid, processMemory & memory);
+
+	///User plus system CPU time of this process in ms
+	static unsigned long long	cpuTimeMs();
+	///Resident memory of this process in kB
+	static unsigned long		currentRSS();
+	///Highest resident memory of this process in kB, since the start or since the last successful resetPeakRSS()
+	static unsigned long		peakRSS();
+	///Only possible on Linux, returns false if peakRSS() still covers the whole lifetime of the process
+	static bool					resetPeakRSS();
+	///VmData of this process in kB, which is what RLIMIT_DATA limits, only on Linux and 0 elsewhere
+	static unsigned long		currentDataSize();
+
 };
 
 #endif // PROCESS_H
@@ -1,34 +1,252 @@
 #include "timers.h"
 
-#ifdef PROFILE_JASP
-#include  <iostream>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <sstream>
+#include "boost/nowide/fstream.hpp"
+#include "processinfo.h"
+#include "log.h"
 
-static std::map<std::string, boost::timer::cpu_timer *> * timers = nullptr;
-
-boost::timer::cpu_timer * _getTimer(std::string timerName)
+namespace
 {
+	struct traceEvent
+	{
+		const char	*	name;
+		uint64_t		ns;
+		char			phase;
+	};
+
+	///Only the thread it belongs to writes in it, writeTrace might read it meanwhile and could then see a torn event at the very start of the ring, which is acceptable for a trace.
+	struct threadBuffer
+	{
+		static const size_t		size = 1 << 16;
+
+		std::vector<traceEvent>	events;
+		std::atomic<uint64_t>	written;
+		size_t					tid;
 
-	//Log::log() << "getTimer! "<< timerName << std::endl;
+		threadBuffer(size_t threadIndex) : events(size), written(0), tid(threadIndex) {}
+	};
 
-	if(timers == nullptr)
-		timers = new std::map<std::string, boost::timer::cpu_timer *>();
+	std::mutex									registryMutex;
+	std::vector<std::shared_ptr<threadBuffer>>	registry;			///< Keeps the buffers of threads that are already gone as well
+	thread_local threadBuffer				*	localBuffer		= nullptr;
+	std::string									traceFileName,
+												processName		= "JASP";
 
-	if(timers->count(timerName) == 0)
+	///The steady clock only means something within this process, the system clock is paired with it once to get timestamps that are comparable between processes
+	struct clockPair
 	{
-		(*timers)[timerName] = new boost::timer::cpu_timer(); //starts automatically
-		(*timers)[timerName]->stop();
+		uint64_t	steadyNs;
+		double		systemUs;
+
+		clockPair()
+			: steadyNs(JaspTimer::nowNs()),
+			  systemUs(double(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count()))
+		{}
+	};
+
+	const clockPair & clockAlignment()
+	{
+		static clockPair pair;
+		return pair;
 	}
 
-	return (*timers)[timerName];
+	std::string jsonEscape(const char * str)
+	{
+		std::string escaped;
+
+		for(const char * c = str; *c != '\0'; c++)
+			switch(*c)
+			{
+			case '"':	escaped += "\\\"";	break;
+			case '\\':	escaped += "\\\\";	break;
+			case '\n':	escaped += "\\n";	break;
+			case '\t':	escaped += "\\t";	break;
+			default:	escaped += *c;		break;
+			}
+
+		return escaped;
+	}
+
+	///Calls func(buffer, event) for every event still in the rings, oldest first per thread
+	template<typename FUNC> void forAllEvents(FUNC func)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+
+		for(const std::shared_ptr<threadBuffer> & buffer : registry)
+		{
+			uint64_t written	= buffer->written.load(std::memory_order_acquire),
+					 first		= written > threadBuffer::size ? written - threadBuffer::size : 0;
+
+			for(uint64_t i = first; i < written; i++)
+				func(*buffer, buffer->events[i % threadBuffer::size]);
+		}
+	}
+}
+
+std::atomic<bool> JaspTimer::_enabled(std::getenv("JASP_TRACE") != nullptr);
+
+uint64_t JaspTimer::nowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double JaspTimer::alignedUs(uint64_t ns)
+{
+	const clockPair & pair = clockAlignment();
+
+	return pair.systemUs + (double(ns) - double(pair.steadyNs)) / 1000.0;
 }
 
-void _printAllTimers()
+void JaspTimer::setEnabled(bool enabled)
 {
-	if(timers == nullptr)
+	if(_enabled.exchange(enabled) == enabled)
 		return;
 
-	for(auto keyval : *timers)
-		Log::log() << keyval.first << " ran for " << keyval.second->format() << std::endl;
+	Log::log() << "Tracing turned " << (enabled ? "on" : "off") << " for " << processName << std::endl;
+
+	if(!enabled)
+		writeTrace();
+}
+
+void JaspTimer::setTraceFileName(const std::string & fileName)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	traceFileName = fileName;
+}
+
+void JaspTimer::setProcessName(const std::string & name)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	processName = name;
 }
 
-#endif
+void JaspTimer::record(const char * name, char phase, uint64_t ns)
+{
+	if(localBuffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+
+		registry.push_back(std::make_shared<threadBuffer>(registry.size()));
+		localBuffer = registry.back().get();
+	}
+
+	uint64_t written = localBuffer->written.load(std::memory_order_relaxed);
+
+	localBuffer->events[written % threadBuffer::size] = { name, ns, phase };
+	localBuffer->written.store(written + 1, std::memory_order_release);
+}
+
+void JaspTimer::clear()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	for(const std::shared_ptr<threadBuffer> & buffer : registry)
+		buffer->written.store(0, std::memory_order_release);
+}
+
+size_t JaspTimer::writeTraceEvents(std::ostream & out, bool & first)
+{
+	const unsigned long	pid			= ProcessInfo::currentPID();
+	size_t				count		= 0;
+	char				timestamp[32];
+
+	auto separator = [&]() -> std::ostream & { out << (first ? "" : ",\n"); first = false; return out; };
+
+	forAllEvents([&](const threadBuffer & buffer, const traceEvent & event)
+	{
+		std::snprintf(timestamp, sizeof(timestamp), "%.3f", alignedUs(event.ns));
+		separator() << "{\"ph\":\"" << event.phase << "\",\"name\":\"" << jsonEscape(event.name) << "\",\"pid\":" << pid << ",\"tid\":" << buffer.tid << ",\"ts\":" << timestamp << "}";
+		count++;
+	});
+
+	if(count > 0)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+
+		separator() << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid << ",\"args\":{\"name\":\"" << jsonEscape(processName.c_str()) << "\"}}";
+
+		for(const std::shared_ptr<threadBuffer> & buffer : registry)
+			separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << buffer->tid << ",\"args\":{\"name\":\"" << (buffer->tid == 0 ? "main" : "thread " + std::to_string(buffer->tid)) << "\"}}";
+	}
+
+	return count;
+}
+
+bool JaspTimer::writeTrace()
+{
+	std::string fileName;
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		fileName = traceFileName;
+	}
+
+	std::stringstream	events;
+	bool				first	= true;
+	size_t				count	= writeTraceEvents(events, first);
+
+	if(fileName == "" || count == 0)
+		return false;
+
+	boost::nowide::ofstream out(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+	if(!out.is_open())
+	{
+		Log::log() << "Could not open tracefile " << fileName << std::endl;
+		return false;
+	}
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" << events.str() << "\n]}\n";
+
+	Log::log() << "Wrote " << count << " trace events to " << fileName << std::endl;
+
+	return out.good();
+}
+
+void JaspTimer::logTotal(const std::string & name)
+{
+	uint64_t							total	= 0,
+										times	= 0;
+	std::map<size_t, std::vector<uint64_t>>	openPerThread;
+
+	forAllEvents([&](const threadBuffer & buffer, const traceEvent & event)
+	{
+		if(name != event.name)
+			return;
+
+		std::vector<uint64_t> & open = openPerThread[buffer.tid];
+
+		if(event.phase == 'B')
+			open.push_back(event.ns);
+		else if(!open.empty())
+		{
+			total += event.ns - open.back();
+			times++;
+			open.pop_back();
+		}
+	});
+
+	if(times > 0)
+		Log::log() << name << " ran for " << (total / 1000000.0) << "ms in " << times << " runs" << std::endl;
+}
+
+void JaspTimer::logTotals()
+{
+	std::vector<std::string> names;
+
+	forAllEvents([&](const threadBuffer &, const traceEvent & event)
+	{
+		if(event.phase == 'B' && std::find(names.begin(), names.end(), event.name) == names.end())
+			names.push_back(event.name);
+	});
+
+	for(const std::string & name : names)
+		logTotal(name);
+}
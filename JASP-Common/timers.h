@@ -1,31 +1,70 @@
 #ifndef TIMERS_H
 #define TIMERS_H
 
-#ifdef PROFILE_JASP
-
-#include <boost/timer/timer.hpp>
+#include <atomic>
 #include <string>
-#include <map>
+#include <cstdint>
+#include <ostream>
+
+/* JaspTimer is a tracer that is always compiled in and can be switched on and off while running.
+ * When it is off a JASPTIMER_* costs a single relaxed atomic load, when it is on it appends a begin or end event with a nanosecond timestamp to a ring buffer of the current thread.
+ * The buffers are only read when the trace gets written, in the Chrome trace format, which happens when tracing is turned off again and when the process stops.
+ * Timestamps are written as microseconds since the epoch (aligned through a single pairing of the steady and system clocks),
+ * so the traces of the desktop and of the engines line up and can simply be merged.
+ *
+ * Tracing starts enabled when the environment variable JASP_TRACE is set, otherwise the desktop switches it for itself and (through the logCfg message) for the engines.
+ * The names passed to begin/end/complete are not copied and must outlive the trace, the macros below only pass string literals.
+ */
+class JaspTimer
+{
+public:
+	static bool		enabled()								{ return _enabled.load(std::memory_order_relaxed); }
+	static void		setEnabled(bool enabled);				///< Turning it off writes the trace to the tracefile
+	static void		setTraceFileName(const std::string & fileName);
+	static void		setProcessName(	const std::string & processName);
+
+	static void		begin(		const char * name)						{ if(enabled())				record(name, 'B', nowNs());								}
+	static void		end(		const char * name)						{ if(enabled())				record(name, 'E', nowNs());								}
+	///For when the name is only known at the end, startNs should be startNs() from when it began
+	static void		complete(	const char * name, uint64_t startNs)	{ if(enabled() && startNs)	{ record(name, 'B', startNs); record(name, 'E', nowNs()); } }
+	static uint64_t	startNs()											{ return enabled() ? nowNs() : 0;														}
+
+	static uint64_t	nowNs();
+	static double	alignedUs(uint64_t ns);					///< Microseconds since the epoch for a nowNs(), comparable between processes
+	static double	nowAlignedUs()							{ return alignedUs(nowNs()); }
+
+	static bool		writeTrace();							///< To the tracefile, unless there is nothing to write, returns false if nothing was written
+	static size_t	writeTraceEvents(std::ostream & out, bool & first); ///< Writes the events as a comma separated list of json objects, for merging them with other traces
+	static void		logTotal(const std::string & name);
+	static void		logTotals();
+	static void		clear();								///< Forgets all events, a forked engine uses this to not report what the zygote did
+
+private:
+	static void		record(const char * name, char phase, uint64_t ns);
+
+	static std::atomic<bool>	_enabled;
+};
+
+///Begins on construction and ends on destruction
+class JaspTimerScope
+{
+public:
+	JaspTimerScope(const char * name) : _name(name)	{ JaspTimer::begin(_name);	}
+	~JaspTimerScope()								{ JaspTimer::end(_name);	}
 
+private:
+	const char * _name;
+};
 
-boost::timer::cpu_timer * _getTimer(std::string timerName);
-void _printAllTimers();
+#define JASPTIMER_CONCAT_(A, B)	A ## B
+#define JASPTIMER_CONCAT( A, B)	JASPTIMER_CONCAT_(A, B)
 
-#define JASPTIMER_START(  TIMERNAME ) _getTimer( #TIMERNAME )->start()
-#define JASPTIMER_RESUME( TIMERNAME ) _getTimer( #TIMERNAME )->resume()
-#define JASPTIMER_STOP(   TIMERNAME ) _getTimer( #TIMERNAME )->stop()
-#define JASPTIMER_PRINT(  TIMERNAME ) Log::log() << #TIMERNAME << " ran for " << _getTimer( #TIMERNAME )->format() << std::endl
+#define JASPTIMER_START(  TIMERNAME ) JaspTimer::begin( #TIMERNAME )
+#define JASPTIMER_RESUME( TIMERNAME ) JaspTimer::begin( #TIMERNAME )
+#define JASPTIMER_STOP(   TIMERNAME ) JaspTimer::end( #TIMERNAME )
+#define JASPTIMER_SCOPE(  TIMERNAME ) JaspTimerScope JASPTIMER_CONCAT(_jaspTimerScope, __LINE__)( #TIMERNAME )
+#define JASPTIMER_PRINT(  TIMERNAME ) JaspTimer::logTotal( #TIMERNAME )
 #define JASPTIMER_FINISH( TIMERNAME ) JASPTIMER_STOP(TIMERNAME); JASPTIMER_PRINT(TIMERNAME)
-#define JASPTIMER_PRINTALL() _printAllTimers()
-
-#else
-//No timers please!
-#define JASPTIMER_START(  TIMERNAME ) /* TIMERNAME */
-#define JASPTIMER_RESUME( TIMERNAME ) /* TIMERNAME */
-#define JASPTIMER_STOP(   TIMERNAME ) /* TIMERNAME */
-#define JASPTIMER_PRINT(  TIMERNAME ) /* TIMERNAME */
-#define JASPTIMER_FINISH( TIMERNAME ) /* TIMERNAME */
-#define JASPTIMER_PRINTALL() /* bla bla bla */
-#endif
+#define JASPTIMER_PRINTALL() (JaspTimer::logTotals(), JaspTimer::writeTrace())
 
 #endif // TIMERS_H
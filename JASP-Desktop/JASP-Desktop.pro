@@ -1,4 +1,4 @@
-QT += webengine webchannel svg network printsupport xml qml quick quickwidgets quickcontrols2
+QT += webengine webchannel svg network printsupport xml qml quick quickwidgets quickcontrols2 concurrent
 DEFINES += JASP_USES_QT_HERE
 
 QTQUICK_COMPILER_SKIPPED_RESOURCES += html/html.qrc
@@ -44,7 +44,7 @@ windows:CONFIG(DebugBuild) {
 }
 
    macx:LIBS += -lboost_filesystem-clang-mt-1_64 -lboost_system-clang-mt-1_64 -larchive -lz
-windows:LIBS += -lole32 -loleaut32
+windows:LIBS += -lole32 -loleaut32 -lpsapi
 
 linux {
     LIBS += -larchive
@@ -52,12 +52,6 @@ linux {
     LIBS += -lboost_filesystem -lboost_system -lrt
 }
 
-$$JASPTIMER_USED {
-    windows:CONFIG(ReleaseBuild)    LIBS += -llibboost_timer-vc141-mt-1_64 -llibboost_chrono-vc141-mt-1_64
-    windows:CONFIG(DebugBuild)      LIBS += -llibboost_timer-vc141-mt-gd-1_64 -llibboost_chrono-vc141-mt-gd-1_64
-    linux:                          LIBS += -lboost_timer -lboost_chrono
-    macx:                           LIBS += -lboost_timer-clang-mt-1_64 -lboost_chrono-clang-mt-1_64
-}
 
 macx:QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter -Wno-unused-local-typedef
 macx:QMAKE_CXXFLAGS += -Wno-c++11-extensions
@@ -245,6 +239,7 @@ HEADERS += \
     data/importers/spss/variablerecord.h \
     data/importers/spss/verylongstringrecord.h \
     data/importers/codepageconvert.h \
+    data/importers/columnfingerprint.h \
     data/importers/convertedstringcontainer.h \
     data/importers/csv.h \
     data/importers/csvimportcolumn.h \
@@ -255,6 +250,7 @@ HEADERS += \
     data/importers/importerutils.h \
     data/importers/jaspimporter.h \
     data/importers/odsimporter.h \
+    data/importers/sourcechunkindex.h \
     data/importers/spssimporter.h \
     data/asyncloader.h \
     data/asyncloaderthread.h \
@@ -268,8 +264,10 @@ HEADERS += \
     data/fileevent.h \
     analysis/options/variableinfo.h \
     engine/enginerepresentation.h \
+    engine/engineperformance.h \
     engine/enginesync.h \
     engine/rscriptstore.h \
+    engine/zygoterepresentation.h \
     gui/aboutdialog.h \
     qquick/datasetview.h \
     modules/analysisentry.h \
@@ -287,8 +285,11 @@ HEADERS += \
     osf/osfnam.h \
     utilities/appdirs.h \
     utilities/application.h \
+    utilities/headlessbatch.h \
     utilities/jsonutilities.h \
+    utilities/lrucache.h \
     utilities/qutils.h \
+    utilities/resultschannel.h \
     utilities/resultsjsinterface.h \
     utilities/settings.h \
     utilities/simplecrypt.h \
@@ -335,6 +336,7 @@ HEADERS += \
     widgets/listmodellayersassigned.h \
     widgets/listmodelmultinomialchi2test.h  \
     data/filtermodel.h \
+    data/nativefilter.h \
     widgets/filemenu/recentfileslistmodel.h \
     widgets/filemenu/datalibraryfilesystem.h \
     widgets/filemenu/recentfilesfilesystem.h \
@@ -345,6 +347,7 @@ HEADERS += \
     widgets/filemenu/osfbreadcrumbslistmodel.h \
     resultstesting/compareresults.h \
     resultstesting/resultscomparetable.h \
+    resultstesting/testrunner.h \
     widgets/filemenu/filemenu.h \
     $$PWD/gui/messageforwarder.h \
     widgets/filemenu/filemenulistitem.h \
@@ -437,6 +440,7 @@ SOURCES += \
     data/importers/importer.cpp \
     data/importers/jaspimporter.cpp \
     data/importers/odsimporter.cpp \
+    data/importers/sourcechunkindex.cpp \
     data/importers/spssimporter.cpp \
     data/asyncloader.cpp \
     data/asyncloaderthread.cpp \
@@ -449,7 +453,9 @@ SOURCES += \
     data/datasettablemodel.cpp \
     data/fileevent.cpp \
     engine/enginerepresentation.cpp \
+    engine/engineperformance.cpp \
     engine/enginesync.cpp \
+    engine/zygoterepresentation.cpp \
     gui/aboutdialog.cpp \
     qquick/datasetview.cpp \
     modules/analysisentry.cpp \
@@ -467,6 +473,7 @@ SOURCES += \
     osf/osfnam.cpp \
     utilities/appdirs.cpp \
     utilities/application.cpp \
+    utilities/headlessbatch.cpp \
     utilities/jsonutilities.cpp \
     utilities/qutils.cpp \
     utilities/resultsjsinterface.cpp \
@@ -514,6 +521,7 @@ SOURCES += \
     widgets/listmodellayersassigned.cpp \
     widgets/listmodelmultinomialchi2test.cpp \
     data/filtermodel.cpp \
+    data/nativefilter.cpp \
     widgets/filemenu/recentfileslistmodel.cpp \
     widgets/filemenu/datalibraryfilesystem.cpp \
     widgets/filemenu/recentfilesfilesystem.cpp \
@@ -524,6 +532,7 @@ SOURCES += \
     widgets/filemenu/osfbreadcrumbslistmodel.cpp \
     resultstesting/compareresults.cpp \
     resultstesting/resultscomparetable.cpp \
+    resultstesting/testrunner.cpp \
     widgets/filemenu/filemenu.cpp \
     $$PWD/gui/messageforwarder.cpp \
     widgets/filemenu/filemenubasiclistmodel.cpp \
@@ -171,6 +171,7 @@ void Analyses::bindAnalysisHandler(Analysis* analysis)
 	connect(analysis, &Analysis::imageEditedSignal,					this, &Analyses::analysisImageEdited				);
 	connect(analysis, &Analysis::requestColumnCreation,				this, &Analyses::requestColumnCreation				);
 	connect(analysis, &Analysis::resultsChangedSignal,				this, &Analyses::analysisResultsChanged				);
+	connect(analysis, &Analysis::progressChangedSignal,				this, &Analyses::analysisProgressChanged			);
 	connect(analysis, &Analysis::requestComputedColumnCreation,		this, &Analyses::requestComputedColumnCreation		);
 	connect(analysis, &Analysis::requestComputedColumnDestruction,	this, &Analyses::requestComputedColumnDestruction	);
 
@@ -305,11 +306,30 @@ void Analyses::refreshAllAnalyses()
 		idAnalysis.second->refresh();
 }
 
+///Only the analyses on or near the screen get their plots rewritten right away, the others are marked stale and rewritten once they are scrolled into view or exported.
 void Analyses::refreshAllPlots(std::set<Analysis*> exceptThese)
 {
 	for(auto idAnalysis : _analysisMap)
 		if(exceptThese.count(idAnalysis.second) == 0)
+		{
+			if(runPriority(idAnalysis.second) != Background)	idAnalysis.second->rewriteImages();
+			else												idAnalysis.second->markImagesStale();
+		}
+}
+
+///Returns the ids of the analyses that now have their plots rewritten, anything that uses those plots should wait for them.
+std::set<size_t> Analyses::refreshStalePlots()
+{
+	std::set<size_t> rewriting;
+
+	for(auto idAnalysis : _analysisMap)
+		if(idAnalysis.second->imagesStale())
+		{
 			idAnalysis.second->rewriteImages();
+			rewriting.insert(idAnalysis.first);
+		}
+
+	return rewriting;
 }
 
 
@@ -402,6 +422,17 @@ void Analyses::applyToAll(std::function<void(Analysis *analysis)> applyThis)
 		applyThis(_analysisMap[id]);
 }
 
+Analyses::RunPriority Analyses::runPriority(const Analysis * analysis) const
+{
+	if(_visible && _currentAnalysisIndex > -1 && size_t(_currentAnalysisIndex) < _orderedIds.size() && _orderedIds[size_t(_currentAnalysisIndex)] == analysis->id())
+		return Focused;
+
+	if(_visibleInResults.count(analysis->id()) > 0)
+		return Visible;
+
+	return Background;
+}
+
 QVariant Analyses::data(const QModelIndex &index, int role)	const
 {
 	if(index.row() < 0 || index.row() > rowCount())
@@ -561,6 +592,26 @@ void Analyses::analysisTitleChangedFromResults(int id, QString title)
 		analysis->setTitleQ(title);
 }
 
+void Analyses::analysesVisibleInResults(QString visibleIdsJson)
+{
+	Json::Value visibleIds;
+	Json::Reader().parse(visibleIdsJson.toStdString(), visibleIds);
+
+	_visibleInResults.clear();
+
+	for(const Json::Value & id : visibleIds)
+		if(id.isIntegral())
+			_visibleInResults.insert(size_t(id.asInt()));
+
+	for(size_t id : _visibleInResults)
+	{
+		Analysis * analysis = get(id);
+
+		if(analysis != nullptr && analysis->imagesStale())
+			analysis->rewriteImages();
+	}
+}
+
 void Analyses::setChangedAnalysisTitle()
 {
     Analysis * analysis = dynamic_cast<Analysis*>(QObject::sender());
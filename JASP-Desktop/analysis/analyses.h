@@ -51,6 +51,9 @@ public:
 					nameRole,
 					idRole};
 
+	///Order in which waiting analyses get an engine, lower runs first.
+	enum RunPriority { Focused, Visible, Background };
+
 				Analyses(QObject * parent, DynamicModules * dynamicModules) : QAbstractListModel(parent), _dynamicModules(dynamicModules) {}
 
 	Analysis*	createFromJaspFileEntry(Json::Value analysisData, RibbonModel* ribbonModel);
@@ -59,6 +62,7 @@ public:
 
 	Analysis*	create(const QString &module, const QString &name, const QString &title)	{ return create(module, name, title, _nextId++, AppInfo::version);		}
 	Analysis*	create(Modules::AnalysisEntry * analysisEntry)								{ return create(analysisEntry, _nextId++);						}
+	Analysis*	create(const QString &module, const QString &name, const QString &title, Json::Value *options)	{ return create(module, name, title, _nextId++, AppInfo::version, options, Analysis::Initializing, false); }
 
 	Analysis*	get(size_t id) const								{ return _analysisMap.count(id) > 0 ? _analysisMap.at(id) : nullptr;	}
 	void		clear();
@@ -73,6 +77,9 @@ public:
 	///Applies function to all analyses.
 	void		applyToAll(std::function<void(Analysis *analysis)> applyThis);
 
+	///Focused is the analysis whose form is open, Visible is anything the results view reports as being in its viewport.
+	RunPriority	runPriority(const Analysis * analysis) const;
+
 	int			count() const	{ assert(_analysisMap.size() == _orderedIds.size()); return _analysisMap.size(); }
 
 	Json::Value asJson() const;
@@ -94,6 +101,7 @@ public slots:
 	void removeAnalysis(Analysis *analysis);
 	void refreshAllAnalyses();
 	void refreshAllPlots(std::set<Analysis*> exceptThese = {});
+	std::set<size_t> refreshStalePlots();
 	void refreshAnalysesUsingColumn(QString col);
 	void analysisClickedHandler(QString analysisFunction, QString analysisTitle, QString module);
 	void setCurrentAnalysisIndex(int currentAnalysisIndex);
@@ -109,6 +117,7 @@ public slots:
 	void rescanAnalysisEntriesOfDynamicModule(Modules::DynamicModule * module);
 	void setChangedAnalysisTitle();
 	void analysisTitleChangedFromResults(int id, QString title);
+	void analysesVisibleInResults(QString visibleIdsJson);
 
 signals:
 	void analysesUnselected();
@@ -123,6 +132,7 @@ signals:
 	void analysisImageEdited(			Analysis *	source);
 	void analysisRewriteImages(			Analysis *	source);
 	void analysisResultsChanged(		Analysis *	source);
+	void analysisProgressChanged(		Analysis *	source);
 	void analysisTitleChanged(			Analysis *  source);
 	void analysisOptionsChanged(		Analysis *	source);
 	void analysisNameSelected(			QString		name);
@@ -158,6 +168,7 @@ private:
 	 DynamicModules*				_dynamicModules			= nullptr;
 	 double							_currentFormHeight		= 0;
 	 bool							_visible				= false;
+	 std::set<size_t>				_visibleInResults;
 
 	 static int								_scriptRequestID;
 	 QMap<int, QPair<Analysis*, QString> >	_scriptIDMap;
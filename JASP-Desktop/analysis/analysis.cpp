@@ -114,6 +114,27 @@ void Analysis::setResults(const Json::Value & results, int progress)
 	emit resultsChangedSignal(this);
 }
 
+///For when the analysis cannot even get to an engine, the results then show the error just like one coming from R would.
+void Analysis::setFatalError(const std::string & errorMessage)
+{
+	Json::Value results		= Json::objectValue;
+	results["title"]		= _title;
+	results["error"]		= 1;
+	results["errorMessage"]	= errorMessage;
+
+	setStatus(FatalError);
+	setResults(results);
+}
+
+void Analysis::setProgress(int progress)
+{
+	if(_progress == progress)
+		return;
+
+	_progress = progress;
+	emit progressChangedSignal(this);
+}
+
 void Analysis::imageSaved(const Json::Value & results)
 {
 	_imgResults = results;
@@ -161,6 +182,7 @@ void Analysis::editImage(const Json::Value &options)
 
 void Analysis::rewriteImages()
 {
+	_imagesStale = false;
 	setStatus(Analysis::RewriteImgs);
 	emit rewriteImagesSignal(this);
 }
@@ -247,6 +269,10 @@ void Analysis::setStatus(Analysis::Status status)
 		TempFiles::deleteList(TempFiles::retrieveList(_id));
 		_version = AppInfo::version;
 	}
+
+	if (status == Analysis::Running || status == Analysis::Initing)
+		_imagesStale = false; //A run renders its plots with the current settings anyway
+
 	_status = status;
 }
 
@@ -70,6 +70,7 @@ signals:
 	void				imageEditedSignal(		Analysis * analysis);
 	void				rewriteImagesSignal(	Analysis * analysis);
 	void				resultsChangedSignal(	Analysis * analysis);
+	void				progressChangedSignal(	Analysis * analysis);
 
 	ComputedColumn *	requestComputedColumnCreation(		QString columnName, Analysis * analysis);
 	void				requestColumnCreation(				QString columnName, Analysis *source, int columnType);
@@ -86,12 +87,17 @@ public:
 	bool isDynamicModule()		{ return _moduleData == nullptr ? false : _moduleData->dynamicModule() != nullptr; }
 
 	void setResults(	const Json::Value & results, int progress = -1);
+	void setFatalError(	const std::string & errorMessage);
+	void setProgress(	int progress); ///< Only the progressbar moved, the results stay as they are
 	void imageSaved(	const Json::Value & results);
 	void saveImage(		const Json::Value & options);
 	void editImage(		const Json::Value & options);
 	void imageEdited(	const Json::Value & results);
 	void rewriteImages();
 	void imagesRewritten();
+	void markImagesStale()								{ _imagesStale = true;							}
+	void addMsInEngine(qint64 ms)						{ _msInEngine += ms;							}
+	void setResourceUsage(const Json::Value & usage)	{ _resourceUsage = usage;						}
 
 	void setRFile(const std::string &file)				{ _rfile = file;								}
 	void setUserData(Json::Value userData)				{ _userData = userData;							}
@@ -114,7 +120,11 @@ public:
 			bool				usesJaspResults()	const	{ return _useJaspResults;					}
 			Status				status()			const	{ return _status;							}
 			int					revision()			const	{ return _revision;							}
+			int					progress()			const	{ return _progress;							}
 			bool				isRefreshBlocked()	const	{ return _refreshBlocked;					}
+			bool				imagesStale()		const	{ return _imagesStale;						}
+			qint64				msInEngine()		const	{ return _msInEngine;						}
+	const	Json::Value		&	resourceUsage()		const	{ return _resourceUsage;					}
 			QString				helpFile()			const	{ return _helpFile;							}
 	const	Json::Value		&	getSaveImgOptions()	const	{ return _saveImgOptions;					}
 	const	Json::Value		&	getImgResults()		const	{ return _imgResults;						}
@@ -172,7 +182,10 @@ private:
 
 protected:
 	Status					_status			= Initializing;
-	bool					_refreshBlocked	= false;
+	bool					_refreshBlocked	= false,
+							_imagesStale	= false; ///< The plots were rendered with an older ppi or background and should be rewritten before they are shown or exported
+	qint64					_msInEngine		= 0;	 ///< Total time jaspEngines spent on requests for this analysis, reported by the regression tests
+	Json::Value				_resourceUsage	= Json::nullValue; ///< CPU time, memory and R heap of the last run as measured by the jaspEngine
 
 	Options*				_options;
 
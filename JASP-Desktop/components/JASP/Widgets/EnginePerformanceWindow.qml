@@ -0,0 +1,128 @@
+import QtQuick 2.11
+import QtQuick.Window 2.11
+import QtQuick.Controls 2.5
+import JASP.Widgets 1.0
+import JASP.Theme 1.0
+
+Window
+{
+	id:				enginePerformanceWindow
+
+	width:			900
+	height:			400
+	minimumWidth:	600
+	minimumHeight:	200
+
+	visible:				enginePerformance.visible
+	onVisibleChanged:		enginePerformance.visible = visible
+	title:					"Engine performance"
+	color:					Theme.uiBackground
+
+	Row
+	{
+		id:					buttons
+		spacing:			6
+		anchors
+		{
+			top:			parent.top
+			left:			parent.left
+			margins:		6
+		}
+
+		RectangularButton
+		{
+			text:			qsTr("Export Chrome trace")
+			toolTip:		qsTr("Write everything the engines did this session to a file for chrome://tracing or ui.perfetto.dev")
+			onClicked:		enginePerformance.exportChromeTrace()
+		}
+
+		CheckBox
+		{
+			text:			qsTr("Trace JASP")
+			checked:		enginePerformance.tracing
+			onToggled:		enginePerformance.tracing = checked
+			ToolTip.text:	qsTr("Record the JASPTIMER events of the desktop and the engines, they are merged into the exported trace")
+			ToolTip.visible:hovered
+		}
+
+		RectangularButton
+		{
+			text:			qsTr("Clear trace")
+			toolTip:		qsTr("Forget the trace collected so far")
+			onClicked:		enginePerformance.clearTrace()
+		}
+
+		Text
+		{
+			anchors.verticalCenter:	parent.verticalCenter
+			text:					enginePerformance.traceEvents + qsTr(" trace events")
+		}
+	}
+
+	ListView
+	{
+		id:					engineList
+		clip:				true
+		spacing:			4
+		model:				enginePerformance.engines
+		anchors
+		{
+			top:			buttons.bottom
+			left:			parent.left
+			right:			parent.right
+			bottom:			parent.bottom
+			margins:		6
+		}
+
+		delegate: Rectangle
+		{
+			width:			engineList.width
+			height:			engineGrid.height + 12
+			color:			Theme.white
+			border.color:	Theme.grayLighter
+			border.width:	1
+
+			Text
+			{
+				id:				engineTitle
+				x:				6
+				y:				6
+				font.bold:		true
+				text:			"jaspEngine #" + modelData.channel + " (pid " + modelData.pid + ")"
+			}
+
+			Text
+			{
+				anchors.left:		engineTitle.right
+				anchors.leftMargin:	12
+				anchors.right:		parent.right
+				y:					6
+				elide:				Text.ElideRight
+				text:				modelData.state
+			}
+
+			Grid
+			{
+				id:				engineGrid
+				columns:		6
+				columnSpacing:	18
+				rowSpacing:		2
+				x:				6
+				anchors.top:	engineTitle.bottom
+
+				Text { text: qsTr("Requests: ")			+ modelData.requests									}
+				Text { text: qsTr("R busy: ")			+ modelData.rBusyPercent.toFixed(0)			+ "%"		}
+				Text { text: qsTr("Memory: ")			+ modelData.rssMB.toFixed(1)				+ " MB"		}
+				Text { text: qsTr("IPC sent: ")			+ modelData.ipcSentKB.toFixed(0)			+ " kB"		}
+				Text { text: qsTr("IPC received: ")		+ modelData.ipcReceivedKB.toFixed(0)		+ " kB"		}
+				Text { text: qsTr("Last queue wait: ")	+ modelData.lastQueueWaitMs.toFixed(0)		+ " ms"		}
+				Text { text: qsTr("R eval: ")			+ modelData.rEvalMs.toFixed(0)				+ " ms"		}
+				Text { text: qsTr("Data extraction: ")	+ modelData.dataExtractionMs.toFixed(0)		+ " ms"		}
+				Text { text: qsTr("Serialization: ")	+ modelData.serializationMs.toFixed(0)		+ " ms"		}
+				Text { text: " " }
+				Text { text: " " }
+				Text { text: qsTr("Mean queue wait: ")	+ modelData.meanQueueWaitMs.toFixed(0)		+ " ms"		}
+			}
+		}
+	}
+}
@@ -213,6 +213,7 @@ Item
 				}
 
 				webChannel.registeredObjects: [ resultsJsInterfaceInterface ]
+				Component.onCompleted:	resultsJsInterface.registerOnWebChannel(webChannel) //Gives the results page the signals of ResultsChannel directly, the results Json doesn't need to pass through QML like that
 
 				Item
 				{
@@ -230,6 +231,7 @@ Item
 					function analysisChangedDownstream(id, model)		{ resultsJsInterface.analysisChangedDownstream(id, model)       }
 					function welcomeScreenIsCleared(callDelayedLoad)	{ resultsJsInterface.welcomeScreenIsCleared(callDelayedLoad)    }
 					function analysisTitleChangedFromResults(id, title)	{ resultsJsInterface.analysisTitleChangedFromResults(id, title) }
+					function analysesVisibleInResults(ids)				{ resultsJsInterface.analysesVisibleInResults(ids)				}
 
 
 					function showAnalysesMenu(options)
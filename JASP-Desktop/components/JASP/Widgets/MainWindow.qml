@@ -45,8 +45,9 @@ Window
 
 		if(close.accepted)
 		{
-			aboutModel.visible = false;
-			helpModel.visible  = false;
+			aboutModel.visible			= false;
+			helpModel.visible			= false;
+			enginePerformance.visible	= false;
 		}
 	}
 
@@ -63,6 +64,7 @@ Window
 		Shortcut { onActivated: mainWindow.refreshKeyPressed();		sequences: ["Ctrl+R"];											}
 		Shortcut { onActivated: mainWindow.zoomResetKeyPressed();	sequences: ["Ctrl+0"];											}
 		Shortcut { onActivated: mainWindowRoot.close();				sequences: ["Ctrl+Q", Qt.Key_Close];							}
+		Shortcut { onActivated: enginePerformance.visible = !enginePerformance.visible;	sequences: ["Ctrl+Shift+E"];			}
 
 		RibbonBar
 		{
@@ -37,9 +37,11 @@ void DataSetPackage::reset()
 	_dataFilter					= DEFAULT_FILTER;
 	_filterConstructorJSON		= DEFAULT_FILTER_JSON;
 	_computedColumns			= ComputedColumns(this);
+	_sourceIndex.clear();
 
 	setModified(false);
 	resetEmptyValues();
+	resetFingerprints();
 }
 
 void DataSetPackage::setModified(bool value)
@@ -25,6 +25,8 @@
 #include "boost/signals2.hpp"
 #include "jsonredirect.h"
 #include "computedcolumns.h"
+#include "importers/sourcechunkindex.h"
+#include "importers/columnfingerprint.h"
 
 #define DEFAULT_FILTER "# Add filters using R syntax here, see question mark for help.\n\ngeneratedFilter # by default: pass the non-R filter(s)"
 #define DEFAULT_FILTER_JSON "{\"formulas\":[]}"
@@ -33,6 +35,7 @@
 class DataSetPackage
 {
 	typedef std::map<std::string, std::map<int, std::string>> emptyValsType;
+	typedef std::map<std::string, ColumnFingerprint> fingerprintsType;
 
 public:
 			DataSetPackage();
@@ -40,6 +43,10 @@ public:
 			void				reset();
 			void				storeInEmptyValues(std::string columnName, std::map<int, std::string> emptyValues)	{ _emptyValuesMap[columnName] = emptyValues;	}
 			void				resetEmptyValues()																	{ _emptyValuesMap.clear();											}
+			void				storeFingerprint(std::string columnName, const ColumnFingerprint & fingerprint)		{ _fingerprints[columnName] = fingerprint;		}
+			void				resetFingerprints()																	{ _fingerprints.clear();											}
+			void				dropFingerprint(const std::string & columnName)										{ _fingerprints.erase(columnName);									}
+	const	ColumnFingerprint *	fingerprint(const std::string & columnName)									const	{ auto it = _fingerprints.find(columnName); return it == _fingerprints.end() ? nullptr : &it->second; }
 
 			std::string			id()								const	{ return _id;							}
 			bool				isReady()							const	{ return _analysesHTMLReady;			}
@@ -60,6 +67,7 @@ public:
 			uint				dataFileTimestamp()					const	{ return _dataFileTimestamp;					   }
 	const	Version			&	dataArchiveVersion()				const	{ return _dataArchiveVersion;						}
 	const	std::string		&	filterConstructorJson()				const	{ return _filterConstructorJSON;					}
+	const	SourceChunkIndex	&	sourceIndex()						const	{ return _sourceIndex;								}
 
 			void			setDataArchiveVersion(Version archiveVersion)	{ _dataArchiveVersion			= archiveVersion;	}
 			void			setFilterConstructorJson(std::string json)		{ _filterConstructorJSON		= json;				}
@@ -70,6 +78,7 @@ public:
 			void			setInitialMD5(std::string initialMD5)			{ _initialMD5					= initialMD5;		}
 			void			setDataFileTimestamp(uint timestamp)			{ _dataFileTimestamp			= timestamp;		}
 			void			setDataFileReadOnly(bool readOnly)				{ _dataFileReadOnly				= readOnly;			}
+			void			setSourceIndex(const SourceChunkIndex & index)	{ _sourceIndex					= index;			}
 			void			setAnalysesHTML(std::string html)				{ _analysesHTML					= html;				}
 			void			setDataFilter(std::string filter)				{ _dataFilter					= filter;			}
 			void			setDataSet(DataSet * dataSet)					{ _dataSet						= dataSet;			}
@@ -104,6 +113,7 @@ public:
 private:
 	DataSet			*	_dataSet = nullptr;
 	emptyValsType		_emptyValuesMap;
+	fingerprintsType	_fingerprints;		///< Of the columns as they were imported from the data file, so that a sync can compare them without going through the cells
 
 	std::string			_analysesHTML,
 						_id,
@@ -127,6 +137,7 @@ private:
 
 	ComputedColumns		_computedColumns;
 	bool				_synchingData;
+	SourceChunkIndex	_sourceIndex;		///< What the data file looked like when it was last read, so a sync can skip what did not change
 };
 
 #endif // FILEPACKAGE_H
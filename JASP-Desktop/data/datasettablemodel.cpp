@@ -35,6 +35,10 @@ DataSetTableModel::DataSetTableModel(QObject *parent) :
     QAbstractTableModel(parent)
 {
 	_dataSet = nullptr;
+
+	_columnWidthRefiner.setSingleShot(true);
+	_columnWidthRefiner.setInterval(0); //Runs whenever the eventloop has nothing better to do
+	connect(&_columnWidthRefiner, &QTimer::timeout, this, &DataSetTableModel::refineColumnWidths);
 }
 
 QVariant DataSetTableModel::getColumnTypesWithCorrespondingIcon() const
@@ -64,6 +68,7 @@ void DataSetTableModel::setDataSetPackage(DataSetPackage *package)
     beginResetModel();
 	_dataSet = package == nullptr ? nullptr : package->dataSet();
 	_package = package;
+	resetColumnCaches();
     endResetModel();
 
 	emit columnsFilteredCountChanged();
@@ -102,7 +107,7 @@ QVariant DataSetTableModel::data(const QModelIndex &index, int role) const
 		switch(role)
 		{
 		case Qt::DisplayRole:
-			returnThis = tq(_dataSet->column(column)[index.row()]);
+			returnThis = displayText(index.row(), column);
 			break;
 
 		case (int)specialRoles::active:
@@ -112,8 +117,8 @@ QVariant DataSetTableModel::data(const QModelIndex &index, int role) const
 		case (int)specialRoles::lines:
 		{
 			bool	iAmActive = getRowFilter(index.row()),
-					//aboveMeIsActive = index.row() > 0				&& data(this->index(index.row() - 1, index.column()), (int)specialRoles::active).toBool();
-					belowMeIsActive = index.row() < rowCount() - 1	&& data(this->index(index.row() + 1, index.column()), (int)specialRoles::active).toBool();
+					//aboveMeIsActive = index.row() > 0				&& getRowFilter(index.row() - 1);
+					belowMeIsActive = index.row() < rowCount() - 1	&& getRowFilter(index.row() + 1);
 					//iAmLastRow = index.row() == rowCount() - 1;
 
 			bool	up		= iAmActive,
@@ -135,6 +140,29 @@ QVariant DataSetTableModel::data(const QModelIndex &index, int role) const
 	return returnThis;
 }
 
+QString DataSetTableModel::displayText(int row, int column) const
+{
+	unsigned long long	key			= (static_cast<unsigned long long>(column) << 32) | static_cast<unsigned int>(row);
+	size_t				revision	= columnRevision(column);
+	CachedText		*	cached		= _displayTextCache.find(key);
+
+	if(cached != nullptr && cached->revision == revision)
+		return cached->text;
+
+	QString text = tq(_dataSet->column(column)[row]);
+	_displayTextCache.insert(key, { revision, text });
+
+	return text;
+}
+
+size_t DataSetTableModel::columnRevision(size_t columnIndex) const
+{
+	if(_columnRevisions.size() <= columnIndex)
+		_columnRevisions.resize(columnIndex + 1, 0);
+
+	return _columnRevisions[columnIndex];
+}
+
 QVariant DataSetTableModel::columnTitle(int column) const
 {
 	if(_dataSet != nullptr && column >= 0 && size_t(column) < _dataSet->columnCount())
@@ -199,31 +227,120 @@ void DataSetTableModel::resetAllFilters()
 
 int DataSetTableModel::getMaximumColumnWidthInCharacters(size_t columnIndex) const
 {
-	if(columnIndex >= _dataSet->columnCount()) return 0;
-
-	Column & col = _dataSet->column(columnIndex);
+	if(_dataSet == nullptr || columnIndex >= _dataSet->columnCount()) return 0;
 
-	int extraPad = 2;
+	if(_columnWidthsInCharacters.size() != _dataSet->columnCount())
+	{
+		_columnWidthsInCharacters.resize(_dataSet->columnCount(), -1);
+		_columnWidthLabelsSeen.resize(_dataSet->columnCount(), 0);
+	}
 
-	switch(col.columnType())
+	if(_columnWidthsInCharacters[columnIndex] == -1)
 	{
-	case Column::ColumnTypeScale:
-		return 6 + extraPad; //default precision of stringstream is 6 (and sstream is used in displaying scale values) + some padding because of dots and whatnot
+		Column & col = _dataSet->column(columnIndex);
 
-	case Column::ColumnTypeUnknown:
-		return 0;
+		switch(col.columnType())
+		{
+		case Column::ColumnTypeScale:
+			_columnWidthsInCharacters[columnIndex] = 6 + _columnWidthPadding; //default precision of stringstream is 6 (and sstream is used in displaying scale values) + some padding because of dots and whatnot
+			break;
 
-	default:
-	{
-		int tempVal = 0;
+		case Column::ColumnTypeUnknown:
+			_columnWidthsInCharacters[columnIndex] = 0;
+			break;
 
-		for(size_t labelIndex=0; labelIndex < col.labels().size(); labelIndex++)
-			tempVal = std::max(tempVal, (int)col.labels().getLabelFromRow(labelIndex).length());
+		default:
+			_columnWidthsInCharacters[columnIndex]	= _columnWidthPadding;
+			_columnWidthLabelsSeen[columnIndex]		= 0;
 
-		return tempVal + extraPad;
+			if(widenColumnWidth(columnIndex, _columnWidthSampleLabels))
+				_columnWidthRefiner.start();
+			break;
+		}
 	}
+
+	return _columnWidthsInCharacters[columnIndex];
+}
+
+//Looks at (at most) maxLabels labels that weren't seen yet and returns true if there are still more left
+bool DataSetTableModel::widenColumnWidth(size_t columnIndex, size_t maxLabels) const
+{
+	Labels &	labels	= _dataSet->column(columnIndex).labels();
+	size_t		until	= std::min(labels.size(), _columnWidthLabelsSeen[columnIndex] + maxLabels);
+	int			width	= _columnWidthsInCharacters[columnIndex] - _columnWidthPadding;
+
+	for(size_t labelIndex = _columnWidthLabelsSeen[columnIndex]; labelIndex < until; labelIndex++)
+		width = std::max(width, int(labels.getLabelFromRow(labelIndex).length()));
+
+	_columnWidthsInCharacters[columnIndex]	= width + _columnWidthPadding;
+	_columnWidthLabelsSeen[columnIndex]		= until;
+
+	return until < labels.size();
+}
+
+void DataSetTableModel::refineColumnWidths()
+{
+	if(_dataSet == nullptr || _dataSet->synchingData() || _columnWidthsInCharacters.size() != _dataSet->columnCount())
+		return;
+
+	JASPTIMER_RESUME(DataSetTableModel::refineColumnWidths);
+
+	size_t	budget			= _columnWidthLabelsPerStep;
+	int		firstWidened	= -1,
+			lastWidened		= -1;
+	bool	moreToDo		= false;
+
+	for(size_t col=0; col<_columnWidthsInCharacters.size(); col++)
+	{
+		Column & column = _dataSet->column(col);
+
+		if(_columnWidthsInCharacters[col] == -1 || column.columnType() == Column::ColumnTypeScale || column.columnType() == Column::ColumnTypeUnknown || _columnWidthLabelsSeen[col] >= column.labels().size())
+			continue;
+
+		if(budget == 0)
+		{
+			moreToDo = true;
+			break;
+		}
+
+		size_t	seenBefore	= _columnWidthLabelsSeen[col];
+		int		widthBefore	= _columnWidthsInCharacters[col];
+
+		moreToDo = widenColumnWidth(col, budget) || moreToDo;
+		budget	-= _columnWidthLabelsSeen[col] - seenBefore;
+
+		if(_columnWidthsInCharacters[col] != widthBefore)
+		{
+			if(firstWidened == -1) firstWidened = int(col);
+			lastWidened = int(col);
+		}
 	}
 
+	JASPTIMER_STOP(DataSetTableModel::refineColumnWidths);
+
+	if(firstWidened != -1)
+		emit columnWidthsChanged(firstWidened, lastWidened);
+
+	if(moreToDo)
+		_columnWidthRefiner.start();
+}
+
+void DataSetTableModel::resetColumnCaches()
+{
+	_columnWidthRefiner.stop();
+	_columnWidthsInCharacters.clear();
+	_columnWidthLabelsSeen.clear();
+	_columnRevisions.clear();
+	_displayTextCache.clear();
+}
+
+void DataSetTableModel::columnChanged(size_t columnIndex)
+{
+	if(columnIndex < _columnWidthsInCharacters.size())
+		_columnWidthsInCharacters[columnIndex] = -1;
+
+	columnRevision(columnIndex);
+	_columnRevisions[columnIndex]++;
 }
 
 QVariant DataSetTableModel::headerData ( int section, Qt::Orientation orientation, int role) const
@@ -316,6 +433,7 @@ bool DataSetTableModel::setColumnType(int columnIndex, Column::ColumnType newCol
 		return true;
 
 	bool changed = _dataSet->column(columnIndex).changeColumnType(newColumnType);
+	columnChanged(columnIndex);
 	emit headerDataChanged(Qt::Horizontal, columnIndex, columnIndex);
 
 	return changed;
@@ -330,14 +448,20 @@ void DataSetTableModel::refreshColumn(Column * column)
 {
 	for(size_t col=0; col<_dataSet->columns().columnCount(); col++)
 		if(&(_dataSet->columns()[col]) == column)
+		{
+			columnChanged(col);
 			emit dataChanged(index(0, col), index(rowCount()-1, col));
+		}
 }
 
 void DataSetTableModel::columnWasOverwritten(std::string columnName, std::string possibleError)
 {
 	for(size_t col=0; col<_dataSet->columns().columnCount(); col++)
 		if(_dataSet->columns()[col].name() == columnName)
+		{
+			columnChanged(col);
 			emit dataChanged(index(0, col), index(rowCount()-1, col));
+		}
 }
 
 int DataSetTableModel::setColumnTypeFromQML(int columnIndex, int newColumnType)
@@ -22,9 +22,11 @@
 #include <QModelIndex>
 #include <QAbstractTableModel>
 #include <QIcon>
+#include <QTimer>
 
 #include "common.h"
 #include "datasetpackage.h"
+#include "utilities/lrucache.h"
 
 
 class DataSetTableModel : public QAbstractTableModel
@@ -74,18 +76,45 @@ signals:
 				void				allFiltersReset();
 				void				dataSetChanged(DataSet * newDataSet);
 				void				columnDataTypeChanged(std::string columnName);
+				void				columnWidthsChanged(int firstColumn, int lastColumn); //Only the maxColString of these changed, which doesn't need a full headerDataChanged
 
 public slots:
-				void				refresh() { beginResetModel(); endResetModel(); }
+				void				refresh() { beginResetModel(); resetColumnCaches(); endResetModel(); }
 				void				refreshColumn(Column * column);
 				void				columnWasOverwritten(std::string columnName, std::string possibleError);
 				void				notifyColumnFilterStatusChanged(int columnIndex);
 				void				setColumnsUsedInEasyFilter(std::set<std::string> usedColumns);
     
+private slots:
+				void				refineColumnWidths();
+
+private:
+				void				resetColumnCaches();
+				void				columnChanged(size_t columnIndex);
+				size_t				columnRevision(size_t columnIndex) const;
+				bool				widenColumnWidth(size_t columnIndex, size_t maxLabels) const;
+				QString				displayText(int row, int column) const;
+
+	struct CachedText { size_t revision; QString text; };
+
 private:
 	DataSet						*_dataSet;
 	DataSetPackage				*_package;
 	std::map<std::string, bool> columnNameUsedInEasyFilter;
+
+	// Column widths are estimated from a sample of the labels so the view can show up straight away, _columnWidthRefiner looks at the rest in the background.
+	mutable std::vector<int>	_columnWidthsInCharacters;	//[col], -1 means not estimated yet
+	mutable std::vector<size_t>	_columnWidthLabelsSeen;		//[col]
+	mutable QTimer				_columnWidthRefiner;
+
+	// Formatting a cell (stringstream for scale, label lookup otherwise) is slow enough to keep the ones we showed recently, columnChanged bumps the revision.
+	mutable std::vector<size_t>							_columnRevisions;	//[col]
+	mutable LRUCache<unsigned long long, CachedText>	_displayTextCache	= LRUCache<unsigned long long, CachedText>(_displayTextCacheSize);
+
+	static const size_t			_displayTextCacheSize		= 50000,
+								_columnWidthSampleLabels	= 256,
+								_columnWidthLabelsPerStep	= 20000;
+	static const int			_columnWidthPadding			= 2;
 };
 
 #endif // DATASETTABLEMODEL_H
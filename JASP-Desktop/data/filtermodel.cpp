@@ -1,6 +1,7 @@
 #include "filtermodel.h"
 #include "variablespage/labelfiltergenerator.h"
 #include "utilities/jsonutilities.h"
+#include "nativefilter.h"
 
 void FilterModel::reset()
 {
@@ -131,7 +132,20 @@ void FilterModel::processFilterErrorMsg(QString filterErrorMsg, int requestId)
 void FilterModel::sendGeneratedAndRFilter()
 {
 	setFilterErrorMsg("");
-	emit sendFilter(_generatedFilter, _rFilter, ++_lastSentRequestId);
+	_lastSentRequestId++;
+
+	//Label filters and simple constructor filters do not need R, anything else still goes to the engine
+	std::vector<bool> nativeResult;
+	if(_package != nullptr && _package->dataSet() != nullptr && NativeFilter(_package->dataSet()).evaluate(_rFilter.toStdString(), _constructedJSON.toStdString(), nativeResult))
+	{
+		if(std::find(nativeResult.begin(), nativeResult.end(), true) == nativeResult.end())
+			processFilterErrorMsg("Filtered out all data..", _lastSentRequestId);
+		else
+			processFilterResult(nativeResult, _lastSentRequestId);
+		return;
+	}
+
+	emit sendFilter(_generatedFilter, _rFilter, _lastSentRequestId);
 }
 
 void FilterModel::updateStatusBar()
@@ -17,6 +17,7 @@
 
 #include "codepageconvert.h"
 #include <stdexcept>
+#include <cstring>
 
 using namespace std;
 
@@ -27,7 +28,7 @@ QSet<QByteArray> CodePageConvert::_knownCPs;
  * @param ianaCSNameSrc The IANA name of the source we need to read from.
  */
 CodePageConvert::CodePageConvert(const char *ianaCSNameSrc)
- : _source(0)
+ : _codec(0), _singleByte(false)
 {
 	static const string msg("Cannot find charactor set ");
 
@@ -44,16 +45,65 @@ CodePageConvert::CodePageConvert(const char *ianaCSNameSrc)
 	{
 		// do we know of this codec?
 		if (_knownCPs.find(ianaCSNameSrc) != _knownCPs.end())
-			_source = QTextCodec::codecForName(ianaCSNameSrc)->makeDecoder();
+			_codec = QTextCodec::codecForName(ianaCSNameSrc);
 		else
 			throw runtime_error(msg + ianaCSNameSrc);
+
+		_buildSingleByteTable();
 	}
 }
 
 CodePageConvert::~CodePageConvert()
 {
-	if (_source != 0)
-		delete _source;
+}
+
+/**
+ * @brief _isSingleByteMib True for the MIBs of the windows- and ISO-8859- code pages, which are single byte by definition.
+ * Their undefined bytes decode to U+FFFD, so for them that is not a sign of a multibyte codec.
+ */
+bool CodePageConvert::_isSingleByteMib(int mib)
+{
+	return	(mib >= 2250 && mib <= 2258)	// windows-1250 .. windows-1258
+		||	(mib >= 4	 && mib <= 13)		// ISO-8859-1 .. ISO-8859-10
+		||	(mib >= 109	 && mib <= 112);	// ISO-8859-13 .. ISO-8859-16
+}
+
+/**
+ * @brief _buildSingleByteTable Checks whether the codec maps every byte to exactly one character, independent of its neighbours.
+ * If so the UTF-8 for every byte is stored, this holds for the windows-, ISO-8859- and IBM code pages that SPSS files mostly use.
+ * A multibyte codec such as UTF-8 also decodes every lone byte to a single character (U+FFFD), so unless the codec is known to be single byte
+ * every byte must also encode back to itself.
+ */
+void CodePageConvert::_buildSingleByteTable()
+{
+	const bool knownSingleByte = _isSingleByteMib(_codec->mibEnum());
+
+	char allBytes[256];
+	for (int byte = 0; byte < 256; byte++)
+		allBytes[byte] = static_cast<char>(byte);
+
+	QString all = _codec->toUnicode(allBytes, 256);
+	if (all.size() != 256)
+		return;
+
+	for (int byte = 0; byte < 256; byte++)
+	{
+		QString single = _codec->toUnicode(allBytes + byte, 1);
+		if (single.size() != 1 || single[0] != all[byte] || single[0].isSurrogate())
+			return;
+
+		if (!knownSingleByte && (single[0] == QChar::ReplacementCharacter || _codec->fromUnicode(single) != QByteArray(1, allBytes[byte])))
+			return;
+
+		QByteArray utf8 = single.toUtf8();
+		if (utf8.size() < 1 || utf8.size() > 4)
+			return;
+
+		memcpy(_utf8[byte], utf8.constData(), utf8.size());
+		_utf8Len[byte] = utf8.size();
+	}
+
+	_singleByte = true;
 }
 
 /**
@@ -63,16 +113,40 @@ CodePageConvert::~CodePageConvert()
  */
 string CodePageConvert::convertCodePage(const string &instring) const
 {
+	if (_codec == 0)
+		return instring;
 
-	if (_source != 0)
+	if (_singleByte)
 	{
-
-		QString temp1 =  _source->toUnicode(instring.c_str(), instring.size());
-		QByteArray temp2 = temp1.toUtf8();
-		return string(temp2.data(), temp2.size());
+		// Most strings only hold bytes that stay the same, those are copied as is.
+		size_t unchanged = 0;
+		for (; unchanged < instring.size(); unchanged++)
+		{
+			unsigned char byte = static_cast<unsigned char>(instring[unchanged]);
+			if (_utf8Len[byte] != 1 || static_cast<unsigned char>(_utf8[byte][0]) != byte)
+				break;
+		}
+
+		if (unchanged == instring.size())
+			return instring;
+
+		string result;
+		result.reserve(unchanged + (instring.size() - unchanged) * 3);
+		result.append(instring, 0, unchanged);
+
+		for (size_t i = unchanged; i < instring.size(); i++)
+		{
+			unsigned char byte = static_cast<unsigned char>(instring[i]);
+			result.append(_utf8[byte], _utf8Len[byte]);
+		}
+
+		return result;
 	}
-	else
-		return instring;
+
+	// Passing our own state keeps the codec itself untouched.
+	QTextCodec::ConverterState state;
+	QByteArray utf8 = _codec->toUnicode(instring.c_str(), instring.size(), &state).toUtf8();
+	return string(utf8.data(), utf8.size());
 }
 
 string CodePageConvert::convertCodePage(const char *instring, size_t strLen) const
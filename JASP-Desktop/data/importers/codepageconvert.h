@@ -47,6 +47,7 @@ public:
 
 	/**
 	 * @brief convertCodePage Converts a string from one codepage (ctor source) to another (ctor destination).
+	 * Does not touch any state, so it may be called from several threads at once.
 	 * @param instring The string to convert.
 	 * @param strLen The length of the passed string.
 	 * @return The converted string.
@@ -66,7 +67,13 @@ private:
 
 	static QSet<QByteArray> _knownCPs;
 
-	QTextDecoder	*_source;
+	void _buildSingleByteTable();
+	static bool _isSingleByteMib(int mib);
+
+	QTextCodec		*_codec;			// Null when no conversion is needed, owned by Qt.
+	bool			_singleByte;		// Every byte maps to one character, so the table below does all the work.
+	char			_utf8[256][4];		// UTF-8 encoding of every byte for single byte code pages.
+	unsigned char	_utf8Len[256];
 };
 
 
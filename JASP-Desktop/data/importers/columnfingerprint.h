@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef COLUMNFINGERPRINT_H
+#define COLUMNFINGERPRINT_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <functional>
+#include <algorithm>
+#include <stdint.h>
+
+/**
+ * Rolling 64 bit hash of the values of a column as they were imported, over the whole column and per block of rows.
+ * Two imports of the same column can then be compared without going through the cells, and a column can be extended with appended rows.
+ * Only kept in memory, so std::hash is good enough for the strings.
+ */
+class ColumnFingerprint
+{
+public:
+	static const size_t blockRows = 4096;
+
+	void add(const std::string &value)	{ addHash(std::hash<std::string>()(value));	}
+	void add(double value)				{ uint64_t bits; memcpy(&bits, &value, sizeof(bits)); addHash(bits); }
+
+	size_t		rows()	const { return _rows;		}
+	uint64_t	hash()	const { return _hash ^ _rows; }
+
+	bool operator==(const ColumnFingerprint &other) const { return _rows == other._rows && _hash == other._hash;	}
+	bool operator!=(const ColumnFingerprint &other) const { return !(*this == other);								}
+
+	/**
+	 * @brief firstDifferentRow Finds the start of the first block of rows that differs.
+	 * @return rows() when the fingerprints are equal.
+	 */
+	size_t firstDifferentRow(const ColumnFingerprint &other) const
+	{
+		size_t blocks = std::min(_blocks.size(), other._blocks.size());
+
+		for (size_t block = 0; block < blocks; block++)
+			if (_blocks[block] != other._blocks[block])
+				return block * blockRows;
+
+		return std::min(_rows, other._rows);
+	}
+
+private:
+	static uint64_t mix(uint64_t hash, uint64_t value)
+	{
+		hash ^= value;
+		hash *= 0x9e3779b97f4a7c15ULL;
+		return hash ^ (hash >> 29);
+	}
+
+	void addHash(uint64_t value)
+	{
+		if (_rows % blockRows == 0)
+			_blocks.push_back(0);
+
+		_blocks.back()	= mix(_blocks.back(), value);
+		_hash			= mix(_hash, value);
+		_rows++;
+	}
+
+	size_t					_rows = 0;
+	uint64_t				_hash = 0xcbf29ce484222325ULL;
+	std::vector<uint64_t>	_blocks;
+};
+
+#endif // COLUMNFINGERPRINT_H
@@ -58,7 +58,7 @@ void CSV::open()
 	_utf8BufferStartPos = 0;
 	_utf8BufferEndPos = 0;
 
-	_stream.open(_path.c_str(), ios::in);
+	_stream.open(_path.c_str(), ios::in | ios::binary);
 
 	if ( ! _stream.is_open())
 	{
@@ -95,6 +95,9 @@ bool CSV::readRaw()
 
 	_filePosition += bytesRead;
 
+	if (bytesRead > 0 && _rawBytesCallback)
+		_rawBytesCallback(&_rawBuffer[_rawBufferEndPos], bytesRead);
+
 	if (bytesRead == 0)
 	{
 		return false;
@@ -448,6 +451,24 @@ long CSV::size()
 	return _fileSize;
 }
 
+long CSV::recordPos() const
+{
+	return _filePosition - (_rawBufferEndPos - _rawBufferStartPos) - (_utf8BufferEndPos - _utf8BufferStartPos);
+}
+
+void CSV::seek(long position)
+{
+	_stream.clear();
+	_stream.seekg(position);
+
+	_filePosition		= position;
+	_rawBufferStartPos	= 0;
+	_rawBufferEndPos	= 0;
+	_utf8BufferStartPos = 0;
+	_utf8BufferEndPos	= 0;
+	_eof				= false;
+}
+
 void CSV::close()
 {
 	_stream.close();
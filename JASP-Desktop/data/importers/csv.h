@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <boost/nowide/fstream.hpp>
+#include <boost/function.hpp>
 
 class CSV
 {
@@ -36,6 +37,11 @@ public:
 	long size();
 	void close();
 
+	bool canSeek() const { return _encoding == UTF8; }	// only then do offsets in the file match those of the text read
+	long recordPos() const;								// offset in the file of the record that readLine() will read next
+	void seek(long position);							// continues reading at the given record offset, only if canSeek()
+	void setRawBytesCallback(boost::function<void(const char *, size_t)> callback) { _rawBytesCallback = callback; } // gets every byte as it is read from the file
+
 	enum Status { OK = 0, NotRead, Empty };
 
 	Status status();
@@ -64,6 +70,7 @@ private:
 	int _utf8BufferStartPos, _utf8BufferEndPos;
 	std::string _path;
 	boost::nowide::ifstream _stream;
+	boost::function<void(const char *, size_t)> _rawBytesCallback;
 	bool _eof;
 
 	char _rawBuffer[4096];
@@ -18,6 +18,7 @@ size_t CSVImportColumn::size() const
 void CSVImportColumn::addValue(const string &value)
 {
 	_data.push_back(value);
+	_fingerprint.add(value);
 }
 
 const vector<string> &CSVImportColumn::getValues() const
@@ -19,6 +19,7 @@
 #include "csvimportcolumn.h"
 #include "csv.h"
 #include "timers.h"
+#include "log.h"
 using namespace std;
 
 CSVImporter::CSVImporter(DataSetPackage *packageData) : Importer(packageData)
@@ -31,10 +32,92 @@ ImportDataSet* CSVImporter::loadFile(const string &locator, boost::function<void
 	JASPTIMER_RESUME(CSVImporter::loadFile);
 
 	ImportDataSet* result = new ImportDataSet(this);
-	vector<string> colNames;
+	CSV csv(locator);
+
+	// The index hashes the file while it is parsed, if it turns out we cannot seek in it later it is not needed.
+	_sourceIndex.start(locator);
+	csv.setRawBytesCallback([this](const char * bytes, size_t count) { _sourceIndex.bytesRead(bytes, count); });
+	csv.open();
+
+	vector<CSVImportColumn *> importColumns = readHeader(csv, result);
+
+	if (csv.canSeek())
+		_sourceIndex.headerRead(csv.recordPos());
+	else
+	{
+		csv.setRawBytesCallback(boost::function<void(const char *, size_t)>());
+		_sourceIndex.clear();
+	}
+
+	readRows(csv, importColumns, progressCallback);
+
+	for (vector<CSVImportColumn *>::iterator it = importColumns.begin(); it != importColumns.end(); ++it)
+		result->addColumn(*it);
+
+	// Build dictionary for sync.
+	result->buildDictionary();
+
+	JASPTIMER_STOP(CSVImporter::loadFile);
+
+	return result;
+}
+
+bool CSVImporter::syncIncrementally(const string &locator, boost::function<void(const string &, int)> progressCallback)
+{
+	const SourceChunkIndex	&	previous		= _packageData->sourceIndex();
+	long						resumeOffset	= 0;
+	size_t						resumeRow		= 0;
+
+	switch (previous.compare(locator, resumeOffset, resumeRow))
+	{
+	case SourceChunkIndex::Unknown:
+		return false;
+
+	case SourceChunkIndex::Unchanged:
+		Log::log() << "Data file " << locator << " has the same contents, nothing to sync." << std::endl;
+		_sourceIndex = previous;
+		return true;
+
+	case SourceChunkIndex::Changed:
+		break;
+	}
+
 	CSV csv(locator);
 	csv.open();
 
+	if (!csv.canSeek())
+		return false;
+
+	JASPTIMER_RESUME(CSVImporter::syncIncrementally);
+
+	Log::log() << "Data file " << locator << " changed from row " << (resumeRow + 1) << " on, rereading only from there." << std::endl;
+
+	ImportDataSet				changedRows(this);
+	vector<CSVImportColumn *>	importColumns = readHeader(csv, &changedRows);
+
+	for (CSVImportColumn * column : importColumns)
+		changedRows.addColumn(column);
+
+	_sourceIndex = previous.resumedAt(resumeOffset, resumeRow);
+	csv.seek(resumeOffset);
+	csv.setRawBytesCallback([this](const char * bytes, size_t count) { _sourceIndex.bytesRead(bytes, count); });
+
+	readRows(csv, importColumns, progressCallback);
+
+	std::map<std::string, const std::vector<std::string> *> valuesPerColumn;
+	for (CSVImportColumn * column : importColumns)
+		valuesPerColumn[column->getName()] = &column->getValues();
+
+	bool synced = syncRowsFrom(resumeRow, _sourceIndex.rowCount(), valuesPerColumn, locator, progressCallback);
+
+	JASPTIMER_STOP(CSVImporter::syncIncrementally);
+
+	return synced;
+}
+
+vector<CSVImportColumn *> CSVImporter::readHeader(CSV &csv, ImportDataSet *dataSet)
+{
+	vector<string> colNames;
 	csv.readLine(colNames);
 	vector<CSVImportColumn *> importColumns;
 	importColumns.reserve(colNames.size());
@@ -75,16 +158,19 @@ ImportDataSet* CSVImporter::loadFile(const string &locator, boost::function<void
 		}
 		*it = colName;
 
-		importColumns.push_back(new CSVImportColumn(result, colName));
+		importColumns.push_back(new CSVImportColumn(dataSet, colName));
 	}
 
+	return importColumns;
+}
+
+void CSVImporter::readRows(CSV &csv, vector<CSVImportColumn *> &importColumns, boost::function<void(const string &, int)> progressCallback)
+{
 	unsigned long long progress;
 	unsigned long long lastProgress = -1;
 
-	size_t columnCount = colNames.size();
-
-//	for (size_t i = 0; i < columnCount; i++)  // columns
-//		cells.push_back(vector<string>());
+	size_t	columnCount	= importColumns.size();
+	bool	indexing	= !_sourceIndex.empty();
 
 	vector<string> line;
 	bool success = csv.readLine(line);
@@ -104,21 +190,17 @@ ImportDataSet* CSVImporter::loadFile(const string &locator, boost::function<void
 				importColumns.at(i)->addValue(line[i]);
 			for (; i < columnCount; i++)
 				importColumns.at(i)->addValue(string());
+
+			if (indexing)
+				_sourceIndex.recordRow(csv.recordPos());
 		}
 
 		line.clear();
 		success = csv.readLine(line);
 	}
 
-	for (vector<CSVImportColumn *>::iterator it = importColumns.begin(); it != importColumns.end(); ++it)
-		result->addColumn(*it);
-
-	// Build dictionary for sync.
-	result->buildDictionary();
-
-	JASPTIMER_STOP(CSVImporter::loadFile);
-
-	return result;
+	if (indexing)
+		_sourceIndex.finish(csv.size());
 }
 
 
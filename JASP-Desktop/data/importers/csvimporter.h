@@ -19,6 +19,9 @@
 #define CSVIMPORTER_H
 
 #include "importer.h"
+#include "csv.h"
+
+class CSVImportColumn;
 
 
 class CSVImporter : public Importer
@@ -29,6 +32,11 @@ public:
 protected:
 	virtual ImportDataSet* loadFile(const std::string &locator, boost::function<void(const std::string &, int)> progressCallback);
 	virtual void fillSharedMemoryColumn(ImportColumn *importColumn, Column &column);
+	virtual bool syncIncrementally(const std::string &locator, boost::function<void(const std::string &, int)> progressCallback);
+
+private:
+	std::vector<CSVImportColumn *>	readHeader(CSV &csv, ImportDataSet *dataSet);
+	void							readRows(CSV &csv, std::vector<CSVImportColumn *> &importColumns, boost::function<void(const std::string &, int)> progressCallback);
 
 };
 
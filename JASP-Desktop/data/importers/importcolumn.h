@@ -5,6 +5,7 @@
 #include <map>
 #include <vector>
 #include "column.h"
+#include "columnfingerprint.h"
 
 class ImportDataSet;
 
@@ -19,6 +20,9 @@ public:
 
 	virtual std::string getName() const;
 
+	const ColumnFingerprint &	fingerprint()		const { return _fingerprint;						}
+	bool						hasFingerprint()	const { return _fingerprint.rows() == size();		}
+
 	static bool convertToInt(const std::vector<std::string> &values, std::vector<int> &intValues, std::set<int> &uniqueValues, std::map<int, std::string> &emptyValuesMap);
 	static bool convertToDouble(const std::vector<std::string> &values, std::vector<double> &doubleValues, std::map<int, std::string> &emptyValuesMap);
 
@@ -30,6 +34,7 @@ public:
 protected:
 	ImportDataSet* _importDataSet;
 	std::string _name;
+	ColumnFingerprint _fingerprint; // Of the values as imported, filled by the subclasses while or right after loading.
 
 	static std::string _deEuropeanise(const std::string &value);
 
@@ -19,6 +19,7 @@ void Importer::loadDataSet(const std::string &locator, boost::function<void(cons
 		_packageData->pauseEngines();
 
 	ImportDataSet *importDataSet = loadFile(locator, progressCallback);
+	_packageData->setSourceIndex(_sourceIndex);
 
 	int columnCount = importDataSet->columnCount();
 	_packageData->setDataSet(SharedMemory::createDataSet()); // this is required incase the loading of the data fails so that the SharedMemory::createDataSet() can be later freed.
@@ -28,12 +29,14 @@ void Importer::loadDataSet(const std::string &locator, boost::function<void(cons
 	int rowCount = importDataSet->rowCount();
 
 	setDataSetSize(columnCount, rowCount);
+	_packageData->resetFingerprints();
 
 	int colNo = 0;
 	for (ImportColumn *importColumn : *importDataSet)
 	{
 		progressCallback("Loading Data Set", 50 + 50 * colNo / columnCount);
 		initColumn(colNo, importColumn);
+		storeFingerprint(importColumn);
 		colNo++;
 	}
 
@@ -44,6 +47,12 @@ void Importer::loadDataSet(const std::string &locator, boost::function<void(cons
 
 void Importer::syncDataSet(const std::string &locator, boost::function<void(const std::string &, int)> progress)
 {
+	if (syncIncrementally(locator, progress))
+	{
+		_packageData->setSourceIndex(_sourceIndex);
+		return;
+	}
+
 	ImportDataSet *importDataSet	= loadFile(locator, progress);
 	DataSet *dataSet				= _packageData->dataSet();
 	bool rowCountChanged			= importDataSet->rowCount() != dataSet->rowCount();
@@ -74,12 +83,21 @@ void Importer::syncDataSet(const std::string &locator, boost::function<void(cons
 		{
 			missingColumns.erase(syncColumnName);
 
-			Column &orgColumn	= orgColumns.get(syncColumnName);
-			int orgRowCount		= orgColumn.rowCount();
-			int syncRowCount	= syncColumn->size();
+			Column &orgColumn						= orgColumns.get(syncColumnName);
+			int orgRowCount							= orgColumn.rowCount();
+			int syncRowCount						= syncColumn->size();
+			const ColumnFingerprint *orgFingerprint	= _packageData->fingerprint(syncColumnName);
 
 			if (orgRowCount != syncRowCount)
 				changedColumns.push_back(std::pair<int, Column *>(syncColNo, &orgColumn));
+			else if (orgFingerprint != nullptr && orgFingerprint->rows() == size_t(orgRowCount) && syncColumn->hasFingerprint())
+			{
+				if (*orgFingerprint != syncColumn->fingerprint())
+				{
+					Log::log() << "Value Changed, col: " << syncColumnName << ", from row " << (orgFingerprint->firstDifferentRow(syncColumn->fingerprint()) + 1) << " on" << std::endl;
+					changedColumns.push_back(std::pair<int, Column *>(syncColNo, &orgColumn));
+				}
+			}
 			else
 			{
 				for (int r = 0; r < orgRowCount; r++)
@@ -98,10 +116,47 @@ void Importer::syncDataSet(const std::string &locator, boost::function<void(cons
 	std::map<std::string, Column *> changeNameColumns;
 
 	if (missingColumns.size() > 0 && newColumns.size() > 0) {
+		// Renamed columns have the same content, so new columns are looked up by fingerprint where there is one.
+		std::multimap<uint64_t, std::string> newColumnsByFingerprint;
+		for (auto newColIt = newColumns.begin(); newColIt != newColumns.end(); ++newColIt)
+		{
+			ImportColumn *newValues = importDataSet->getColumn(newColIt->first);
+			if (newValues->hasFingerprint())
+				newColumnsByFingerprint.insert(std::make_pair(newValues->fingerprint().hash(), newColIt->first));
+		}
+
+		// A new column without a fingerprint can only be matched by comparing its values.
+		bool allNewColumnsFingerprinted = newColumnsByFingerprint.size() == newColumns.size();
+
 		for (auto nameColMissing : missingColumns)
+		{
+			Column * missingColumn						= nameColMissing.second;
+			const ColumnFingerprint *missingFingerprint	= _packageData->fingerprint(nameColMissing.first);
+
+			if (missingFingerprint != nullptr && missingFingerprint->rows() == missingColumn->rowCount())
+			{
+				bool found		= false;
+				auto candidates = newColumnsByFingerprint.equal_range(missingFingerprint->hash());
+				for (auto candidate = candidates.first; candidate != candidates.second; ++candidate)
+				{
+					auto newColIt = std::find_if(newColumns.begin(), newColumns.end(), [&](const std::pair<std::string, int> & newCol) { return newCol.first == candidate->second; });
+
+					if (newColIt != newColumns.end() && importDataSet->getColumn(newColIt->first)->fingerprint() == *missingFingerprint)
+					{
+						changeNameColumns[newColIt->first] = missingColumn;
+						newColumns.erase(newColIt);
+						newColumnsByFingerprint.erase(candidate);
+						found = true;
+						break;
+					}
+				}
+
+				if (found || allNewColumnsFingerprinted)
+					continue;
+			}
+
 			for (auto newColIt = newColumns.begin(); newColIt != newColumns.end(); ++newColIt)
 			{
-				Column * missingColumn	= nameColMissing.second;
 				std::string newColName	= newColIt->first;
 				ImportColumn *newValues = importDataSet->getColumn(newColName);
 
@@ -123,13 +178,216 @@ void Importer::syncDataSet(const std::string &locator, boost::function<void(cons
 					}
 				}
 			}
+		}
 	}
 
 	_syncPackage(importDataSet, newColumns, changedColumns, missingColumns, changeNameColumns, rowCountChanged);
+	_packageData->setSourceIndex(_sourceIndex);
+
+	_packageData->resetFingerprints();
+	for (ImportColumn *syncColumn : *importDataSet)
+		storeFingerprint(syncColumn);
 
 	delete importDataSet;
 }
 
+bool Importer::syncRowsFrom(size_t firstRow, size_t rowCount, const std::map<std::string, const std::vector<std::string> *> &valuesPerColumn, const std::string &locator, boost::function<void(const std::string &, int)> progress)
+{
+	DataSet *dataSet		= _packageData->dataSet();
+	size_t	orgRowCount		= dataSet->rowCount();
+	bool	rowCountChanged	= rowCount != orgRowCount,
+			appending		= rowCountChanged && firstRow == orgRowCount;
+
+	// Rows that were inserted or removed somewhere in the middle shift everything after them, so then only a full sync will do.
+	if (rowCountChanged && !appending)
+		return false;
+
+	size_t importedColumns = 0;
+	for (Column &orgColumn : dataSet->columns())
+		if (!_packageData->isColumnComputed(orgColumn.name()))
+		{
+			if (valuesPerColumn.count(orgColumn.name()) == 0)
+				return false;
+			importedColumns++;
+		}
+
+	if (importedColumns != valuesPerColumn.size())
+		return false;
+
+	std::vector<std::string> changedColumns;
+
+	for (const auto & nameValues : valuesPerColumn)
+	{
+		if (appending)
+		{
+			changedColumns.push_back(nameValues.first);
+			continue;
+		}
+
+		Column &orgColumn = dataSet->column(nameValues.first);
+
+		for (size_t r = 0; r < nameValues.second->size(); r++)
+			if (!ImportColumn::isStringValueEqual(nameValues.second->at(r), orgColumn, firstRow + r))
+			{
+				Log::log() << "Value Changed, col: " << nameValues.first << ", row " << (firstRow + r + 1) << std::endl;
+				changedColumns.push_back(nameValues.first);
+				break;
+			}
+	}
+
+	if (changedColumns.size() == 0)
+		return true;
+
+	bool enginesLoaded = !_packageData->enginesInitializing();
+
+	if(enginesLoaded)
+		_packageData->pauseEngines();
+	_packageData->dataSet()->setSynchingData(true);
+
+	if (rowCountChanged)
+		setDataSetRowCount(rowCount);
+
+	// Changed or appended rows usually fit in the columns as they are, so only those rows are set.
+	// A column that needs new labels or another type gets refilled from a full read of just the data file.
+	std::vector<std::string> refillColumns;
+
+	for (const std::string & colName : changedColumns)
+	{
+		Column &column = _packageData->dataSet()->column(colName);
+
+		if (!setStringsInSharedMemoryColumn(*valuesPerColumn.at(colName), firstRow, column))
+			refillColumns.push_back(colName);
+	}
+
+	if (refillColumns.size() > 0)
+	{
+		ImportDataSet *importDataSet = loadFile(locator, progress);
+
+		for (const std::string & colName : refillColumns)
+		{
+			Log::log() << "Column changed " << colName << std::endl;
+			initColumn(colName, importDataSet->getColumn(colName));
+			storeFingerprint(importDataSet->getColumn(colName));
+		}
+
+		delete importDataSet;
+	}
+
+	std::vector<std::string>			missingColumns;
+	std::map<std::string, std::string>	changeNameColumns;
+
+	_packageData->dataSet()->setSynchingData(false);
+	_packageData->dataChanged(_packageData, changedColumns, missingColumns, changeNameColumns, rowCountChanged);
+
+	if(enginesLoaded)
+		_packageData->resumeEngines();
+
+	return true;
+}
+
+bool Importer::setStringsInSharedMemoryColumn(const std::vector<std::string> &values, size_t firstRow, Column &column)
+{
+	std::map<int, std::string> emptyValuesMap, appendedEmptyValues;
+
+	auto orgEmptyValues = _packageData->emptyValuesMap().find(column.name());
+	if (orgEmptyValues != _packageData->emptyValuesMap().end())
+		emptyValuesMap = orgEmptyValues->second;
+
+	switch (column.columnType())
+	{
+	case Column::ColumnTypeScale:
+	{
+		std::vector<double> doubleValues;
+		if (!ImportColumn::convertToDouble(values, doubleValues, appendedEmptyValues))
+			return false;
+
+		for (size_t r = 0; r < doubleValues.size(); r++)
+			column.setValue(firstRow + r, doubleValues[r]);
+		break;
+	}
+
+	case Column::ColumnTypeNominal:
+	case Column::ColumnTypeOrdinal:
+	{
+		// Only values that already have a label, new ones might make a scale of it.
+		std::vector<int>	intValues;
+		std::set<int>		uniqueValues,
+							knownValues	= column.labels().getIntValues();
+
+		if (!ImportColumn::convertToInt(values, intValues, uniqueValues, appendedEmptyValues))
+			return false;
+
+		for (int value : uniqueValues)
+			if (knownValues.count(value) == 0)
+				return false;
+
+		for (size_t r = 0; r < intValues.size(); r++)
+			column.setValue(firstRow + r, intValues[r]);
+		break;
+	}
+
+	default:
+	{
+		// Again only values that already have a label, the labels would have to be resorted otherwise.
+		std::map<std::string, int> keys;
+		for (const Label & label : column.labels())
+			keys[column.labels().getValueFromKey(label.value())] = label.value();
+
+		std::vector<int> intValues;
+		intValues.reserve(values.size());
+
+		for (const std::string & value : values)
+		{
+			if (Column::isEmptyValue(value))
+			{
+				if (!value.empty())
+					appendedEmptyValues[intValues.size()] = value;
+				intValues.push_back(INT_MIN);
+				continue;
+			}
+
+			auto key = keys.find(value);
+			if (value.size() > 128 || key == keys.end())
+				return false;
+
+			intValues.push_back(key->second);
+		}
+
+		for (size_t r = 0; r < intValues.size(); r++)
+			column.setValue(firstRow + r, intValues[r]);
+		break;
+	}
+	}
+
+	emptyValuesMap.erase(emptyValuesMap.lower_bound(int(firstRow)), emptyValuesMap.end()); // values runs to the end of the column
+
+	for (const auto & rowValue : appendedEmptyValues)
+		emptyValuesMap[firstRow + rowValue.first] = rowValue.second;
+
+	_packageData->storeInEmptyValues(column.name(), emptyValuesMap);
+
+	// The fingerprint rolls on over appended values, just as if the whole file was read, but it cannot be rewound for changed rows.
+	const ColumnFingerprint *orgFingerprint = _packageData->fingerprint(column.name());
+	if (orgFingerprint != nullptr && orgFingerprint->rows() == firstRow)
+	{
+		ColumnFingerprint fingerprint = *orgFingerprint;
+		for (const std::string & value : values)
+			fingerprint.add(value);
+
+		_packageData->storeFingerprint(column.name(), fingerprint);
+	}
+	else if (orgFingerprint != nullptr)
+		_packageData->dropFingerprint(column.name());
+
+	return true;
+}
+
+void Importer::storeFingerprint(ImportColumn *importColumn)
+{
+	if (importColumn->hasFingerprint())
+		_packageData->storeFingerprint(importColumn->getName(), importColumn->fingerprint());
+}
+
 void Importer::fillSharedMemoryColumnWithStrings(const std::vector<std::string> &values, Column &column)
 {
 	// try to make the column nominal
@@ -5,6 +5,7 @@
 #include <boost/function.hpp>
 #include "../datasetpackage.h"
 #include "importdataset.h"
+#include "sourcechunkindex.h"
 
 class ImportDataSet;
 class ImportColumn;
@@ -23,7 +24,14 @@ protected:
 
 	void fillSharedMemoryColumnWithStrings(const std::vector<std::string> &values, Column &column);
 
-	DataSetPackage *_packageData;
+	///Lets an importer that keeps a _sourceIndex sync only what changed in the file, returns false when a full sync is needed instead.
+	virtual bool syncIncrementally(const std::string &locator, boost::function<void(const std::string &, int)> progressCallback) { return false; }
+
+	///Syncs using only the rows from firstRow on, valuesPerColumn holds those per column. Returns false if that is not enough.
+	bool syncRowsFrom(size_t firstRow, size_t rowCount, const std::map<std::string, const std::vector<std::string> *> &valuesPerColumn, const std::string &locator, boost::function<void(const std::string &, int)> progressCallback);
+
+	DataSetPackage		*_packageData;
+	SourceChunkIndex	_sourceIndex; ///< Filled by loadFile of importers that support syncIncrementally, handed to the package after loading or syncing.
 
 private:
 	DataSet* setDataSetSize(int columnCount, int rowCount);
@@ -38,6 +46,9 @@ private:
 			std::map<std::string, Column *> &changeNameColumns,
 			bool rowCountChanged);
 
+	void storeFingerprint(ImportColumn *importColumn);
+	bool setStringsInSharedMemoryColumn(const std::vector<std::string> &values, size_t firstRow, Column &column);
+
 	void initColumn(int colNo,				ImportColumn *importColumn);
 	void initColumn(std::string colName,	ImportColumn *importColumn);
 };
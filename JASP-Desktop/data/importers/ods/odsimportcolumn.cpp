@@ -118,6 +118,13 @@ void ODSImportColumn::postLoadProcess()
 {
 }
 
+void ODSImportColumn::buildFingerprint()
+{
+	_fingerprint = ColumnFingerprint();
+	for (Cases::const_iterator i = _rows.begin(); i != _rows.end(); ++i)
+		_fingerprint.add(i->valueAsString());
+}
+
 vector<string> ODSImportColumn::getData()
 {
 	vector<string> values;
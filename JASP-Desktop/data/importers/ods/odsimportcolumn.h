@@ -104,6 +104,11 @@ public:
 	 */
 	void postLoadProcess();
 
+	/**
+	 * @brief buildFingerprint Fingerprints the cells, call once all rows are there.
+	 */
+	void buildFingerprint();
+
 	Column::ColumnType	columnType() const { return _columnType; }
 
 	// Getters.
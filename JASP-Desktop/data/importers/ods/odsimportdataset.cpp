@@ -99,5 +99,6 @@ void ODSImportDataSet::postLoadProcess()
 	{
 		ODSImportColumn * col = static_cast<ODSImportColumn *>(*colI);
 		col->createSpace(numRows - 1);
+		col->buildFingerprint();
 	}
 }
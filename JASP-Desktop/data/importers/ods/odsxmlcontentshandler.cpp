@@ -1,5 +1,6 @@
 #include "odsxmlcontentshandler.h"
 #include "../importerutils.h"
+#include <sstream>
 
 using namespace std;
 using namespace ods;
@@ -30,8 +31,7 @@ const QString XmlContentsHandler::_typeTime("time");
 
 
 XmlContentsHandler::XmlContentsHandler(ODSImportDataSet *dta)
- : XmlHandler(dta)
- , _docDepth(not_in_doc)
+ : _docDepth(not_in_doc)
  , _row(0)
  , _column(0)
  , _lastNotEmptyColumn(-1)
@@ -39,27 +39,40 @@ XmlContentsHandler::XmlContentsHandler(ODSImportDataSet *dta)
  , _lastType(odsType_unknown)
  , _colRepeat(1)
  , _rowRepeat(1)
-
+ , _cellTextDone(false)
+ , _dataSet(dta)
 {
 
 }
 
+/**
+ * @brief processToken Handles the token the reader is currently at.
+ * @param xml The reader.
+ */
+void XmlContentsHandler::processToken(const QXmlStreamReader &xml)
+{
+	switch(xml.tokenType())
+	{
+	case QXmlStreamReader::StartElement:	startElement(xml.name(), xml.attributes());	break;
+	case QXmlStreamReader::EndElement:		endElement(xml.name());						break;
+	case QXmlStreamReader::Characters:		characters(xml.text());						break;
+	default:																			break;
+	}
+}
+
 /**
  * @brief startElement Called on the start of an element.
- * @param namespaceURI - the URI.
  * @param localName - local name (name without prefix).
- * @param qName - Qualified name.
  * @param atts- Attributes.
- * @return true on no error found.
  *
  * Called when a <tag ...> construction found.
  *
  */
-bool XmlContentsHandler::startElement(const QString &namespaceURI, const QString &localName, const QString &qName, const QXmlAttributes &atts)
+void XmlContentsHandler::startElement(const QStringRef &localName, const QXmlStreamAttributes &atts)
 {
 	if (_tableRead == false)
 	{
-		DEBUG_COUT6("XmlContentsHandler::startElement. docDepth: ", _docDepth, ", localName: ", localName.toStdString(), ", qName: ", qName.toStdString());
+		DEBUG_COUT4("XmlContentsHandler::startElement. docDepth: ", _docDepth, ", localName: ", localName.toString().toStdString());
 		
 		// Where were we?
 		switch(_docDepth)
@@ -95,6 +108,7 @@ bool XmlContentsHandler::startElement(const QString &namespaceURI, const QString
 
 				// Get it's type and value.
 				_setLastTypeGetValue(_currentCell, atts);
+				_cellTextDone = !_currentCell.isEmpty();
 				
 				// Find column span for this cell.
 				_colRepeat = _findColRepeat(atts);
@@ -110,26 +124,20 @@ bool XmlContentsHandler::startElement(const QString &namespaceURI, const QString
 			break;
 		}
 	} // if ! table read.
-
-	return true;
 }
 
 /**
  * @brief endElement Called on the end of an element.
- * @param namespaceURI - the URI.
  * @param localName - local name (name without prefix).
- * @param qName - Qualified name.
- * @param atts- Attributes.
- * @return true on no error found.
  *
  * Called when a </tag> construction found.
  *
  */
-bool XmlContentsHandler::endElement(const QString &namespaceURI, const QString &localName, const QString &qName)
+void XmlContentsHandler::endElement(const QStringRef &localName)
 {
 	if (_tableRead == false)
 	{
-		DEBUG_COUT6("XmlContentsHandler::endElement. docDepth: ", _docDepth, ", localName: ", localName.toStdString(), ", qName: ", qName.toStdString());
+		DEBUG_COUT4("XmlContentsHandler::endElement. docDepth: ", _docDepth, ", localName: ", localName.toString().toStdString());
 		
 		switch(_docDepth)
 		{
@@ -222,37 +230,33 @@ bool XmlContentsHandler::endElement(const QString &namespaceURI, const QString &
 				_column += _colRepeat;
 				_colRepeat = 1;
 				_currentCell.clear();
+				_cellTextDone = false;
 			}
 			break;
 
 		case text:
 			if (localName == _nameText)
+			{
 				_docDepth = table_cell;
+				_cellTextDone = _cellTextDone || !_currentCell.isEmpty();
+			}
 			break;
 		}
 	}
-
-	return true;
 }
 
 
 /**
- * @brief characters Called when char data found.
+ * @brief characters Called when char data found, possibly more than once for a single text.
  * @param ch The found data.
- * @return true on no error.
  */
-bool XmlContentsHandler::characters(const QString &ch)
+void XmlContentsHandler::characters(const QStringRef &ch)
 {
-
-	if (_tableRead == false)
+	if ((_tableRead == false) && (_docDepth == text) && !_cellTextDone)
 	{
-		if ((_docDepth == text) && (ch.isEmpty() == false) && _currentCell.isEmpty())
-		{
-			DEBUG_COUT2("Characters: ", ch.toStdString());
-			_currentCell = ch;
-		}
+		DEBUG_COUT2("Characters: ", ch.toString().toStdString());
+		_currentCell.append(ch);
 	}
-	return true;
 }
 
 
@@ -269,6 +273,7 @@ void XmlContentsHandler::resetDocument()
 	_lastType = odsType_unknown;
 	_colRepeat = 1;
 	_rowRepeat = 1;
+	_cellTextDone = false;
 	
 	_dataSet->clear();
 }
@@ -276,13 +281,13 @@ void XmlContentsHandler::resetDocument()
 /**
  * @brief XmlContentsHandler::setLastType Sets the lastType value, and gets value
  * @param QValue value OUTPIT value found.
- * @param QXmlAttributes atts Attriutes to find.
+ * @param QXmlStreamAttributes atts Attriutes to find.
  * @return value of lastType;
  */
-XmlDatatype XmlContentsHandler::_setLastTypeGetValue(QString &value, const QXmlAttributes &atts)
+XmlDatatype XmlContentsHandler::_setLastTypeGetValue(QString &value, const QXmlStreamAttributes &atts)
 {
 	_lastType = odsType_unknown;
-	QString fromfile = atts.value(_attValueType);
+	QStringRef fromfile = atts.value(_attValueType);
 
 	if (fromfile == _typeFloat)
 		_lastType = odsType_float;
@@ -304,16 +309,16 @@ XmlDatatype XmlContentsHandler::_setLastTypeGetValue(QString &value, const QXmlA
 	case odsType_float:
 	case odsType_currency:
 	case odsType_percent:
-		value = atts.value(_attValue);
+		value = atts.value(_attValue).toString();
 		break;
 	case odsType_boolean:
-		value = atts.value(_attBoolValue);
+		value = atts.value(_attBoolValue).toString();
 		break;
 	case odsType_date:
-		value = atts.value(_attDateValue);
+		value = atts.value(_attDateValue).toString();
 		break;
 	case odsType_time:
-		value = atts.value(_attTimeValue);
+		value = atts.value(_attTimeValue).toString();
 		break;
 	case odsType_string:
 	case odsType_unknown:
@@ -329,7 +334,7 @@ XmlDatatype XmlContentsHandler::_setLastTypeGetValue(QString &value, const QXmlA
  * @param defaultValue The value to return if not found.
  * @return The found value or default.
  */
-int XmlContentsHandler::_findColRepeat(const QXmlAttributes &atts, int defaultValue)
+int XmlContentsHandler::_findColRepeat(const QXmlStreamAttributes &atts, int defaultValue)
 {
 	int result = 0;
 	bool okay = false;
@@ -337,7 +342,7 @@ int XmlContentsHandler::_findColRepeat(const QXmlAttributes &atts, int defaultVa
 	return (okay) ? result : defaultValue;
 }
 
-int XmlContentsHandler::_findRowRepeat(const QXmlAttributes &atts, int defaultValue)
+int XmlContentsHandler::_findRowRepeat(const QXmlStreamAttributes &atts, int defaultValue)
 {
 	int result = 0;
 	bool okay = false;
@@ -2,14 +2,21 @@
 #define ODSXMLCONTENTSHANDLER_H
 
 #include <vector>
+#include <QXmlStreamReader>
 
-#include "odsxmlhandler.h"
+#include "odsimportdataset.h"
 #include "odstypes.h"
 
 namespace ods
 {
 
-class XmlContentsHandler : public XmlHandler
+/**
+ * @brief The XmlContentsHandler class - Fills the dataset from the tokens of a QXmlStreamReader.
+ *
+ * The contents are pulled through the reader a block at a time by ODSImporter::readContents,
+ * so the (possibly huge) content.xml never has to be in memory as a whole.
+ */
+class XmlContentsHandler
 {
 	// Depth in XML document.
 	typedef enum e_docDepth
@@ -27,38 +34,41 @@ class XmlContentsHandler : public XmlHandler
 public:
 	XmlContentsHandler(ODSImportDataSet *dta);
 
+	/**
+	 * @brief processToken Handles the token the reader is currently at.
+	 * @param xml The reader.
+	 */
+	void processToken(const QXmlStreamReader &xml);
+
 	/**
 	 * @brief startElement Called on the start of an element.
-	 * @param namespaceURI - the URI.
 	 * @param localName - local name (name without prefix).
-	 * @param qName - Qualified name.
 	 * @param atts- Attributes.
-	 * @return true on no error found.
 	 *
 	 * Called when a <tag ...> construction found.
 	 *
 	 */
-	virtual bool startElement(const QString &namespaceURI, const QString &localName, const QString &qName, const QXmlAttributes &atts);
+	void startElement(const QStringRef &localName, const QXmlStreamAttributes &atts);
 
 	/**
 	 * @brief endElement Called on the end of an element.
-	 * @param namespaceURI - the URI.
 	 * @param localName - local name (name without prefix).
-	 * @param qName - Qualified name.
-	 * @param atts- Attributes.
-	 * @return true on no error found.
 	 *
 	 * Called when a </tag> construction found.
 	 *
 	 */
-	virtual bool endElement(const QString &namespaceURI, const QString &localName, const QString &qName);
+	void endElement(const QStringRef &localName);
 
 	/**
-	 * @brief characters Called when char data found.
+	 * @brief characters Called when char data found, possibly more than once for a single text.
 	 * @param ch The found data.
-	 * @return true on no error.
 	 */
-	virtual bool characters(const QString &ch);
+	void characters(const QStringRef &ch);
+
+	/**
+	 * @brief tableRead Whether the first table was read completely, after which the rest of the document can be skipped.
+	 */
+	bool tableRead() const { return _tableRead; }
 
 	/**
 	 * @brief resetDocument Reset level, row and column, clears data.
@@ -75,6 +85,8 @@ private:
 	int				_colRepeat;			///< Number cells this XML element spans.
 	int				_rowRepeat;
 	QString			_currentCell;
+	bool			_cellTextDone;		///< True once the text of the current cell is complete, only the first paragraph is used.
+	ODSImportDataSet *	_dataSet;
 
 	// Names we search for.
 	static const QString _nameDocContent;
@@ -107,10 +119,10 @@ private:
 	/**
 	 * @brief XmlContentsHandler::setLastType Sets the lastType value, and gets value
 	 * @param QValue value OUTPIT value found.
-	 * @param QXmlAttributes atts Attriutes to find.
+	 * @param QXmlStreamAttributes atts Attriutes to find.
 	 * @return value of lastType;
 	 */
-	XmlDatatype _setLastTypeGetValue(QString &value, const QXmlAttributes &atts);
+	XmlDatatype _setLastTypeGetValue(QString &value, const QXmlStreamAttributes &atts);
 
 	/**
 	 * @brief _findColRepeat/_findRowRepeat Finds the column/row repeat from attributes.
@@ -118,8 +130,8 @@ private:
 	 * @param defaultValue The value to return if not found.
 	 * @return The found value or default.
 	 */
-	static int _findColRepeat(const QXmlAttributes &atts, int defaultValue = 1);
-	static int _findRowRepeat(const QXmlAttributes &atts, int defaultValue = 1);
+	static int _findColRepeat(const QXmlStreamAttributes &atts, int defaultValue = 1);
+	static int _findRowRepeat(const QXmlStreamAttributes &atts, int defaultValue = 1);
 
 };
 
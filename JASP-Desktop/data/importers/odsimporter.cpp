@@ -23,6 +23,7 @@
 #include "filereader.h"
 
 #include <QXmlInputSource>
+#include <QXmlStreamReader>
 
 #include "timers.h"
 
@@ -93,24 +94,39 @@ void ODSImporter::readManifest(const std::string &path, ODSImportDataSet *datase
 
 void ODSImporter::readContents(const std::string &path, ODSImportDataSet *dataset)
 {
-
-	FileReader contents(path, dataset->getContentFilename());
-
-	QXmlInputSource src;
+	FileReader			contents(path, dataset->getContentFilename());
+	XmlContentsHandler	contentsHandler(dataset);
+	QXmlStreamReader	xml;
+	std::vector<char>	block(_contentsBlockSize);
+	bool				readAnything = false;
+
+	// The entry is inflated and parsed a block at a time, once the first table is done the rest is not even decompressed.
+	while (!contentsHandler.tableRead())
 	{
-		std::string tmp;
-		int errorCode = 0;
-		if (((tmp = contents.readAllData(4096, errorCode)).size() == 0) || (errorCode < 0))
-			throw std::runtime_error("Error reading contents in ODS.");
-		src.setData(QString::fromStdString(tmp));
-	}
-
-	{
-		XmlContentsHandler * contentsHandler = new XmlContentsHandler(dataset);
-		QXmlSimpleReader reader;
-		reader.setContentHandler(contentsHandler);
-		reader.setErrorHandler(contentsHandler);
-		reader.parse(src);
+		QXmlStreamReader::TokenType token = xml.readNext();
+
+		if (token == QXmlStreamReader::Invalid)
+		{
+			if (xml.error() != QXmlStreamReader::PrematureEndOfDocumentError)
+				throw std::runtime_error("Error parsing contents in ODS: " + xml.errorString().toStdString());
+
+			int errorCode	= 0;
+			int bytesRead	= contents.readData(block.data(), block.size(), errorCode);
+
+			if (errorCode < 0 || (bytesRead == 0 && !readAnything))
+				throw std::runtime_error("Error reading contents in ODS.");
+
+			// The whole entry is in and the document still isn't complete, so it was cut off.
+			if (bytesRead == 0)
+				throw std::runtime_error("Error parsing contents in ODS: " + xml.errorString().toStdString());
+
+			readAnything = true;
+			xml.addData(QByteArray(block.data(), bytesRead));
+		}
+		else if (token == QXmlStreamReader::EndDocument)
+			break;
+		else
+			contentsHandler.processToken(xml);
 	}
 
 	contents.close();
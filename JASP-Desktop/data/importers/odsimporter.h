@@ -43,6 +43,7 @@ protected:
 
 private:
 	static const std::string _contentFile;
+	static const int _contentsBlockSize = 1 << 16; ///< Bytes of content.xml inflated and parsed at a time.
 
 	/**
 	 * @brief readManifest Reads the ODS manifest.
@@ -0,0 +1,233 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "sourcechunkindex.h"
+#include "utils.h"
+
+#include <cstring>
+#include <algorithm>
+#include <boost/nowide/fstream.hpp>
+
+using namespace std;
+
+void SourceChunkIndex::start(const string &path)
+{
+	clear();
+
+	_path = path;
+}
+
+void SourceChunkIndex::headerRead(long headerLength)
+{
+	if (empty())
+		return;
+
+	hashUpTo(headerLength);
+
+	_headerHash		= _chunkHash.result();
+	_chunkHash		= RangeHash();
+	_headerLength	= headerLength;
+	_chunkStart		= headerLength;
+}
+
+void SourceChunkIndex::bytesRead(const char *bytes, size_t count)
+{
+	if (empty() || count == 0)
+		return;
+
+	_unhashed.append(bytes, count);
+	_lastByte = bytes[count - 1];
+}
+
+void SourceChunkIndex::hashUpTo(long offset)
+{
+	// Everything before a record boundary belongs to the current chunk, because chunks only end on those.
+	size_t count = static_cast<size_t>(std::min(offset - _unhashedOffset, static_cast<long>(_unhashed.size())));
+
+	_chunkHash.add(_unhashed.data(), count);
+	_unhashed.erase(0, count);
+	_unhashedOffset += count;
+}
+
+void SourceChunkIndex::recordRow(long nextRecordOffset)
+{
+	_rowCount++;
+
+	if (nextRecordOffset - _chunkStart >= _chunkSize)
+		closeChunk(nextRecordOffset);
+}
+
+void SourceChunkIndex::closeChunk(long end)
+{
+	hashUpTo(end);
+
+	Chunk chunk;
+	chunk.offset	= _chunkStart;
+	chunk.length	= end - _chunkStart;
+	chunk.firstRow	= _chunkFirstRow;
+	chunk.hash		= _chunkHash.result();
+
+	_chunks.push_back(chunk);
+
+	_chunkHash		= RangeHash();
+	_chunkStart		= end;
+	_chunkFirstRow	= _rowCount;
+}
+
+void SourceChunkIndex::finish(long fileSize)
+{
+	if (_chunkStart < fileSize)
+		closeChunk(fileSize);
+
+	_fileSize			= fileSize;
+	_endsWithNewline	= fileSize > 0 && (_lastByte == '\n' || _lastByte == '\r');
+
+	_unhashed.clear();
+}
+
+SourceChunkIndex::Change SourceChunkIndex::compare(const string &path, long &resumeOffset, size_t &resumeRow) const
+{
+	if (empty() || path != _path)
+		return Unknown;
+
+	long fileSize = Utils::getFileSize(path);
+	if (fileSize < _headerLength)
+		return Unknown;
+
+	boost::nowide::ifstream stream(path.c_str(), ios::in | ios::binary);
+	if (!stream.is_open() || hashRange(stream, 0, _headerLength) != _headerHash)
+		return Unknown;
+
+	for (const Chunk &chunk : _chunks)
+		if (chunk.offset + chunk.length > fileSize || hashRange(stream, chunk.offset, chunk.length) != chunk.hash)
+		{
+			resumeOffset	= chunk.offset;
+			resumeRow		= chunk.firstRow;
+			return Changed;
+		}
+
+	if (fileSize == _fileSize)
+		return Unchanged;
+
+	// Only appended to, but if the last record had no newline yet it might have been extended.
+	if (_endsWithNewline)
+	{
+		resumeOffset	= _fileSize;
+		resumeRow		= _rowCount;
+	}
+	else if (_chunks.size() > 0)
+	{
+		resumeOffset	= _chunks.back().offset;
+		resumeRow		= _chunks.back().firstRow;
+	}
+	else
+	{
+		resumeOffset	= _headerLength;
+		resumeRow		= 0;
+	}
+
+	return Changed;
+}
+
+SourceChunkIndex SourceChunkIndex::resumedAt(long resumeOffset, size_t resumeRow) const
+{
+	SourceChunkIndex resumed = *this;
+
+	while (resumed._chunks.size() > 0 && resumed._chunks.back().offset >= resumeOffset)
+		resumed._chunks.pop_back();
+
+	resumed._rowCount		= resumeRow;
+	resumed._chunkStart		= resumeOffset;
+	resumed._chunkFirstRow	= resumeRow;
+	resumed._chunkHash		= RangeHash();
+	resumed._unhashedOffset	= resumeOffset;
+	resumed._lastByte		= 0;
+	resumed._unhashed.clear();
+
+	return resumed;
+}
+
+uint64_t SourceChunkIndex::hashRange(istream &stream, long offset, long length)
+{
+	static const size_t	bufferSize = 1 << 16;
+	char				buffer[bufferSize];
+	RangeHash			hash;
+
+	stream.clear();
+	stream.seekg(offset);
+
+	while (length > 0)
+	{
+		size_t toRead = length < static_cast<long>(bufferSize) ? static_cast<size_t>(length) : bufferSize;
+		stream.read(buffer, toRead);
+
+		size_t read = stream.gcount();
+		if (read == 0)
+			return ~hash.result(); // truncated, which should not match anything that was read completely
+
+		hash.add(buffer, read);
+		length -= read;
+	}
+
+	return hash.result();
+}
+
+void SourceChunkIndex::RangeHash::add(const char *bytes, size_t count)
+{
+	_length += count;
+
+	// Words are taken from the start of the range, however it is cut up.
+	while (count > 0 && _wordFill > 0)
+	{
+		_word[_wordFill++] = *bytes++;
+		count--;
+
+		if (_wordFill == 8)
+		{
+			uint64_t word;
+			memcpy(&word, _word, 8);
+			addWord(word);
+			_wordFill = 0;
+		}
+	}
+
+	for (; count >= 8; bytes += 8, count -= 8)
+	{
+		uint64_t word;
+		memcpy(&word, bytes, 8);
+		addWord(word);
+	}
+
+	memcpy(_word, bytes, count);
+	_wordFill = count;
+}
+
+uint64_t SourceChunkIndex::RangeHash::result() const
+{
+	uint64_t hash = _hash;
+
+	for (size_t i = 0; i < _wordFill; i++)
+	{
+		hash ^= static_cast<unsigned char>(_word[i]);
+		hash *= 0x100000001b3ULL;
+	}
+
+	hash ^= _length;
+	hash *= 0x9e3779b97f4a7c15ULL;
+
+	return hash;
+}
@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SOURCECHUNKINDEX_H
+#define SOURCECHUNKINDEX_H
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <stdint.h>
+
+/**
+ * Remembers what a row based source file (like a csv) looked like when it was read, as hashes of chunks of about a MB that start and end on record boundaries.
+ * When the file changes a sync can then find the first chunk that differs and only read the rows from there on,
+ * or skip reading altogether when nothing changed.
+ */
+class SourceChunkIndex
+{
+public:
+	enum Change { Unchanged, Changed, Unknown };
+
+	void	clear()			{ *this = SourceChunkIndex(); }
+	bool	empty()	const	{ return _path.empty(); }
+	size_t	rowCount() const { return _rowCount; }
+
+	/**
+	 * @brief start Starts indexing a file that is read from its first byte on, everything read from it should be passed to bytesRead().
+	 * Call headerRead() once the header is read, recordRow() after every row read and finish() at the end.
+	 */
+	void start(const std::string &path);
+
+	/**
+	 * @brief headerRead Marks the end of the header.
+	 * @param headerLength Number of bytes before the first record, these must stay the same for any incremental sync.
+	 */
+	void headerRead(long headerLength);
+
+	/**
+	 * @brief bytesRead Hashes the bytes as they are read from the file, so the file does not have to be read a second time for it.
+	 * @param bytes The bytes that follow those of the previous call, or that start at the offset given to resumedAt().
+	 */
+	void bytesRead(const char *bytes, size_t count);
+
+	/**
+	 * @brief recordRow Registers a row that was read.
+	 * @param nextRecordOffset Offset in the file of the record after it.
+	 */
+	void recordRow(long nextRecordOffset);
+
+	/**
+	 * @brief finish Closes the last chunk.
+	 */
+	void finish(long fileSize);
+
+	/**
+	 * @brief compare Hashes the same ranges of the file as it is now.
+	 * @param resumeOffset When Changed: where to start reading, always a record boundary.
+	 * @param resumeRow When Changed: index of the row that starts at resumeOffset.
+	 * @return Unknown when this index is about another file or its header changed.
+	 */
+	Change compare(const std::string &path, long &resumeOffset, size_t &resumeRow) const;
+
+	/**
+	 * @brief resumedAt A copy that keeps the chunks before resumeOffset, so that reading can continue from there.
+	 */
+	SourceChunkIndex resumedAt(long resumeOffset, size_t resumeRow) const;
+
+private:
+	struct Chunk
+	{
+		long		offset,
+					length;
+		size_t		firstRow;
+		uint64_t	hash;
+	};
+
+	///Hash of a range of bytes that can be fed in pieces of any size.
+	class RangeHash
+	{
+	public:
+		void		add(const char *bytes, size_t count);
+		uint64_t	result() const;
+
+	private:
+		void		addWord(uint64_t word) { _hash ^= word; _hash *= 0x9e3779b97f4a7c15ULL; _hash ^= _hash >> 32; }
+
+		uint64_t	_hash		= 0xcbf29ce484222325ULL,
+					_length		= 0;
+		char		_word[8];
+		size_t		_wordFill	= 0;
+	};
+
+	void closeChunk(long end);
+	void hashUpTo(long offset);
+
+	static uint64_t hashRange(std::istream &stream, long offset, long length);
+
+	static const long	_chunkSize = 1 << 20;
+
+	std::string			_path,
+						_unhashed;					///< Bytes that were read but might still be part of an unfinished record
+	long				_headerLength		= 0,
+						_fileSize			= 0,
+						_chunkStart			= 0,
+						_unhashedOffset		= 0;
+	uint64_t			_headerHash			= 0;
+	RangeHash			_chunkHash;					///< Of the bytes of the current chunk that are hashed so far
+	char				_lastByte			= 0;
+	bool				_endsWithNewline	= false;
+	size_t				_rowCount			= 0,
+						_chunkFirstRow		= 0;
+	std::vector<Chunk>	_chunks;
+};
+
+#endif // SOURCECHUNKINDEX_H
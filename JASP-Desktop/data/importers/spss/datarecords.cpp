@@ -41,6 +41,9 @@ DataRecords::DataRecords(SPSSImporter* importer, SPSSImportDataSet *dataset, con
  , _fileHeader(fileHeader)
  , _from(fromStream)
  , _progress(progress)
+ , _nextSlot(0)
+ , _bufferPos(0)
+ , _bufferEnd(0)
  , _fixer(fixer)
  , _numDbls(0)
  , _numStrs(0)
@@ -52,11 +55,67 @@ DataRecords::DataRecords(SPSSImporter* importer, SPSSImportDataSet *dataset, con
  */
 void DataRecords::read()
 {
+	buildSlots();
+
+	if (_slots.empty())
+		return;
+
+	_buffer.resize(_bufferSize);
 
 	if (_fileHeader.compressed() == 0)
 		readUncompressed();
 	else
 		readCompressed();
+
+	_buffer.clear();
+	_buffer.shrink_to_fit();
+}
+
+/**
+ * @brief buildSlots Fills _slots from the columns and reserves room for all cases, if their number is known.
+ */
+void DataRecords::buildSlots()
+{
+	_slots.clear();
+	_nextSlot = 0;
+
+	for (ImportColumns::iterator it = _dataset->begin(); it != _dataset->end(); ++it)
+	{
+		SPSSImportColumn *col = dynamic_cast<SPSSImportColumn*>(*it);
+
+		bool isString = col->cellType() == SPSSImportColumn::cellString;
+
+		for (size_t span = 0; span < col->columnSpan(); span++)
+			_slots.push_back({ col, isString, span > 0 });
+
+		if (!_dataset->hasNoCases())
+		{
+			if (isString)	col->strings.reserve(_dataset->numCases());
+			else			col->numerics.reserve(_dataset->numCases());
+		}
+	}
+}
+
+/**
+ * @brief fillBuffer Moves the unread bytes to the start of the buffer and fills the rest from the file.
+ * @return false if nothing more could be read.
+ */
+bool DataRecords::fillBuffer()
+{
+	if (!_from.good())
+		return false;
+
+	_importer->reportFileProgress(_from.tellg(), _progress);
+
+	size_t unread = _bufferEnd - _bufferPos;
+	memmove(_buffer.data(), _buffer.data() + _bufferPos, unread);
+
+	_from.read(_buffer.data() + unread, _buffer.size() - unread);
+
+	_bufferPos = 0;
+	_bufferEnd = unread + _from.gcount();
+
+	return _from.gcount() > 0;
 }
 
 
@@ -65,15 +124,19 @@ void DataRecords::read()
  */
 void DataRecords::readCompressed()
 {
-	unsigned char codes[ sizeof(Char_8) ];
+	const double	bias = _fileHeader.bias();
+	unsigned char	codes[ sizeof(Char_8) ];
+	const string	allSpaces(sizeof(Char_8), ' ');
 
 	bool eofFlag = false;
-	while (_from.good() && !eofFlag)
+	while (!eofFlag)
 	{
-		_importer->reportFileProgress(_from.tellg(), _progress);
-		memset(codes, code_eof, sizeof(codes));
-
-		_SPSSIMPORTER_READ_VAR(codes, _from);
+		size_t numCodes = readBytes(reinterpret_cast<char *>(codes), sizeof(codes));
+		if (numCodes < sizeof(codes))
+		{
+			memset(codes + numCodes, code_eof, sizeof(codes) - numCodes);
+			eofFlag = true;
+		}
 
 		for (size_t cnt = 0; cnt < sizeof(codes); cnt++)
 		{
@@ -83,7 +146,7 @@ void DataRecords::readCompressed()
 			case code_ignore: break;
 
 			default: // A compressed data value.
-				insertToCol(_importer->getNextColumn(_dataset), static_cast<double>(codes[cnt]) - _fileHeader.bias());
+				insertToCol(nextSlot(), static_cast<double>(codes[cnt]) - bias);
 				break;
 
 			case code_eof: // end of file found.
@@ -92,19 +155,23 @@ void DataRecords::readCompressed()
 
 			case code_notCompressed:
 				// Uncompressed data values follows..
-				readUnCompVal(_importer->getNextColumn(_dataset));
+				if (!readUnCompVal(nextSlot()))
+					eofFlag = true;
 				break;
 
 			case code_allSpaces:
-				insertToCol(_importer->getNextColumn(_dataset), string(sizeof(Char_8), ' '));
+				insertToCol(nextSlot(), allSpaces);
 				break;
 
 			case code_systmMissing:
 				// system missing value follows.
-				insertToCol(_importer->getNextColumn(_dataset), NAN);
+				insertToCol(nextSlot(), NAN);
 				break;
 
 			}
+
+			if (eofFlag)
+				break;
 		}
 	}
 }
@@ -115,11 +182,8 @@ void DataRecords::readCompressed()
  */
 void DataRecords::readUncompressed()
 {
-	while (_from.good())
-	{
-		_importer->reportFileProgress(_from.tellg(), _progress);
-		readUnCompVal(_importer->getNextColumn(_dataset));
-	}
+	while (readUnCompVal(nextSlot()))
+		;
 }
 
 
@@ -127,19 +191,19 @@ void DataRecords::readUncompressed()
  * @brief insertToCol Insrts a string into the (next) column.
  * @param str The string value to insert / append.
  */
-void DataRecords::insertToCol(SPSSImportColumn &col, const string &str)
+void DataRecords::insertToCol(const Slot &slot, const string &str)
 {
-	if (col.cellType() == SPSSImportColumn::cellString)
+	SPSSImportColumn &col = *slot.column;
+
+	if (slot.isString)
 	{
-		if (_importer->isSpaning())
+		if (slot.spanning)
 		{
 			col.append(str);
-//			DEBUG_COUT5("Appended string \"", str, "\" into column ", col.spssRawColName(), ".");
 		}
 		else
 		{
 			col.insert(str);
-//			DEBUG_COUT5("Inserted string \"", str, "\" into column ", col.spssRawColName(), ".");
 		}
 		_numStrs++;
 	}
@@ -151,13 +215,14 @@ void DataRecords::insertToCol(SPSSImportColumn &col, const string &str)
  * @brief insertToCol Insrts a string into the (next) column.
  * @param value The value to insert
  */
-void DataRecords::insertToCol(SPSSImportColumn &col, double value)
+void DataRecords::insertToCol(const Slot &slot, double value)
 {
-	if (col.cellType() == SPSSImportColumn::cellDouble)
+	SPSSImportColumn &col = *slot.column;
+
+	if (!slot.isString)
 	{
 		col.numerics.push_back(value);
 		_numDbls++;
-//		DEBUG_COUT5("Inserted double ", value, " into column ", col.spssRawColName(), ".");
 	}
 	else
 		DEBUG_COUT5("FAILED TO INSERT double ", value, " into column ", col.spssRawColName(), ".");
@@ -166,19 +231,24 @@ void DataRecords::insertToCol(SPSSImportColumn &col, double value)
 
 /**
  * @brief readUnCompVal Reads in and stores a single data value
- * @param col the column to insert into.
+ * @param slot The slot to insert into.
+ * @return false if there was no complete value left to read.
  */
-void DataRecords::readUnCompVal(SPSSImportColumn &col)
+bool DataRecords::readUnCompVal(const Slot &slot)
 {
 	SpssDataCell dta;
-	_SPSSIMPORTER_READ_VAR(dta, _from);
-	if (col.cellType() == SPSSImportColumn::cellString)
-		insertToCol(col, string(dta.chars, sizeof(dta.chars)));
+	if (readBytes(dta.chars, sizeof(dta.chars)) < sizeof(dta.chars))
+		return false;
+
+	if (slot.isString)
+		insertToCol(slot, string(dta.chars, sizeof(dta.chars)));
 	else
 	{
 		_fixer.fixup(&dta.dbl);
 
 		// TODO: Enstring date types!
-		insertToCol(col, dta.dbl);
+		insertToCol(slot, dta.dbl);
 	}
+
+	return true;
 }
@@ -22,6 +22,9 @@
 #include "fileheaderrecord.h"
 #include "../spssimporter.h"
 #include "spssimportcolumn.h"
+#include <vector>
+#include <cstring>
+#include <algorithm>
 
 namespace spss {
 
@@ -98,25 +101,82 @@ private:
 	 */
 	size_t  _numStrs;
 
+	/**
+	 * @brief The Slot struct Describes one 8 byte value of a case, the slots of a case are in file order.
+	 */
+	struct Slot
+	{
+		SPSSImportColumn	*column;
+		bool				isString;	// Cached cellType() == cellString.
+		bool				spanning;	// True if the value appends to the string started in an earlier slot.
+	};
+
+	std::vector<Slot>	_slots;		///< One per value in a case.
+	size_t				_nextSlot;
+
+	static const size_t	_bufferSize = 4 * 1024 * 1024;
+	std::vector<char>	_buffer;	///< The file is read in large blocks and the values are decoded from here.
+	size_t				_bufferPos;
+	size_t				_bufferEnd;
+
+	/**
+	 * @brief buildSlots Fills _slots from the columns and reserves room for all cases, if their number is known.
+	 */
+	void buildSlots();
+
+	/**
+	 * @brief nextSlot Gets the slot for the next value, wrapping round at the end of a case.
+	 */
+	inline const Slot &nextSlot()
+	{
+		const Slot &slot = _slots[_nextSlot];
+		if (++_nextSlot == _slots.size())
+			_nextSlot = 0;
+		return slot;
+	}
+
+	/**
+	 * @brief fillBuffer Moves the unread bytes to the start of the buffer and fills the rest from the file.
+	 * @return false if nothing more could be read.
+	 */
+	bool fillBuffer();
+
+	/**
+	 * @brief readBytes Copies count bytes from the buffer, refilling it when needed.
+	 * @return The number of bytes copied, less than count at end of file.
+	 */
+	inline size_t readBytes(char *dest, size_t count)
+	{
+		if (_bufferEnd - _bufferPos < count)
+			fillBuffer();
+
+		size_t available = std::min(count, _bufferEnd - _bufferPos);
+		memcpy(dest, _buffer.data() + _bufferPos, available);
+		_bufferPos += available;
+
+		return available;
+	}
+
 	/**
 	 * @brief insertToCol Insrts a string into the (next) column.
-	 * @param col The colum to insert into.
+	 * @param slot The slot to insert into.
 	 * @param str The teing value to insert / append.
 	 */
-	void insertToCol(SPSSImportColumn &col, const std::string &str);
+	void insertToCol(const Slot &slot, const std::string &str);
 
 	/**
 	 * @brief insertToCol Inserts a string into the (next) column.
-	 * @param col The colum to insert into.
+	 * @param slot The slot to insert into.
 	 * @param value The value to insert
 	 */
-	void insertToCol(SPSSImportColumn &col, double value);
+	void insertToCol(const Slot &slot, double value);
 
 	/**
 	 * @brief readUnCompVal Reads in and stores a single data value
-	 * @param col the cilum to insert into.
+	 * @param slot The slot to insert into.
+	 * @return false if there was no complete value left to read.
 	 */
-	void readUnCompVal(SPSSImportColumn &col);
+	bool readUnCompVal(const Slot &slot);
 
 };
 
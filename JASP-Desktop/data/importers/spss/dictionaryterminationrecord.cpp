@@ -43,6 +43,5 @@ DictionaryTermination::~DictionaryTermination()
  */
 void DictionaryTermination::process(SPSSImporter* importer, SPSSImportDataSet *dataset)
 {
-	// inin the columns iterator.
-	importer->resetNextCol(dataset);
+	// Nothing to do at the end of the dictionary, the data records that follow are read by the importer itself.
 }
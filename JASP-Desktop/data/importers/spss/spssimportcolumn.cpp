@@ -30,6 +30,9 @@ SPSSImportColumn::SPSSImportColumn(SPSSImportDataSet *spssdataset, const std::st
 	, _missingChecker(missingChecker)
 	, _charsRemaining(stringLen)
 	, _dataset(spssdataset)
+	, _stringsConverted(false)
+	, _fractionChecked(false)
+	, _hasFraction(false)
 {
 
 }
@@ -79,9 +82,10 @@ bool SPSSImportColumn::isValueEqual(Column &col, size_t row) const
 			{
 				if (row < strings.size())
 				{
-					CodePageConvert &strConvertor = _dataset->stringsConv();
-					string strValue = strConvertor.convertCodePage(strings[row]);
-					result = col.isValueEqual(row, strValue);
+					if (_stringsConverted)
+						result = col.isValueEqual(row, strings[row]);
+					else
+						result = col.isValueEqual(row, _dataset->stringsConv().convertCodePage(strings[row]));
 				}
 			}
 			else
@@ -458,6 +462,35 @@ size_t SPSSImportColumn::append(const std::string &str)
 		return 0;
 }
 
+/**
+ * @brief finishLoading Trims and code page converts the strings or checks the numerics for fractions, once all data is read.
+ * Fingerprints the values as well.
+ */
+void SPSSImportColumn::finishLoading()
+{
+	if (cellType() == cellString)
+	{
+		const CodePageConvert &strConvertor = _dataset->stringsConv();
+		for (size_t cse = 0; cse < strings.size(); cse++)
+		{
+			// Trim left and right, before converting just as before.
+			StrUtils::lTrimWSIP(strings[cse]);
+			StrUtils::rTrimWSIP(strings[cse]);
+			strings[cse] = strConvertor.convertCodePage(strings[cse]);
+			_fingerprint.add(strings[cse]);
+		}
+		_stringsConverted = true;
+	}
+	else
+	{
+		_hasFraction		= _containsFraction(numerics);
+		_fractionChecked	= true;
+
+		for (double value : numerics)
+			_fingerprint.add(value);
+	}
+}
+
 /**
  * @brief setColumnScaleData Sets floating point data into the column.
  * @param column The columns to insert into.
@@ -484,10 +517,14 @@ void SPSSImportColumn::setColumnScaleData(Column &column)
 void SPSSImportColumn::setColumnConvertStringData(Column &column)
 {
 	map<string, string> labels;
-	CodePageConvert &strConvertor = _dataset->stringsConv();
-	// Code page convert all strings.
-	for (size_t i = 0; i < strings.size(); ++i)
-		strings[i] = strConvertor.convertCodePage(strings[i]);
+	// Code page convert all strings, unless finishLoading() did so already.
+	if (!_stringsConverted)
+	{
+		CodePageConvert &strConvertor = _dataset->stringsConv();
+		for (size_t i = 0; i < strings.size(); ++i)
+			strings[i] = strConvertor.convertCodePage(strings[i]);
+		_stringsConverted = true;
+	}
 
 	for (SPSSImportColumn::LabelByValueDict::const_iterator it = spssLables.begin();
 			it != spssLables.end(); ++it)
@@ -127,7 +127,13 @@ public:
 	 * @param values VAlues to check
 	 * @return true if a fractional part found.
 	 */
-	bool containsFraction() const { return _containsFraction(numerics); }
+	bool containsFraction() const { return _fractionChecked ? _hasFraction : _containsFraction(numerics); }
+
+	/**
+	 * @brief finishLoading Trims and code page converts the strings or checks the numerics for fractions, once all data is read.
+	 * Only touches this column, so columns can be finished in parallel.
+	 */
+	void finishLoading();
 
 	/**
 	 * @brief setColumnConvertStringData Sets String data into the column, after doing a code page convert.
@@ -170,6 +176,10 @@ public:
 	// Day Zero for spss files.
 	static const QDate _beginEpoch;
 
+	bool _stringsConverted,	// strings already hold UTF-8.
+		 _fractionChecked,	// _hasFraction is known.
+		 _hasFraction;
+
 	/**
 	 * @brief _toQDateTime Convert SPSS seconds to a date/time.
 	 * @param dt - Target
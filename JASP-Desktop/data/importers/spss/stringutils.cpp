@@ -48,11 +48,10 @@ string StrUtils::rTrimWS(const string &str)
 
 void StrUtils::rTrimWSIP(string &str)
 {
-	if (str.length() == 0)
-		return;
-	else
-		while (isspace(str[str.size() -1]))
-			str = str.substr(0, str.length() - 1);
+	size_t end = str.size();
+	while (end > 0 && isspace(static_cast<unsigned char>(str[end - 1])))
+		end--;
+	str.erase(end);
 }
 
 /**
@@ -90,11 +89,10 @@ string StrUtils::lTrimWS(const std::string &str)
 */
 void StrUtils::lTrimWSIP(std::string &str)
 {
-	if (str.length() == 0)
-		return;
-	else
-		while (isspace(str[0]) )
-			str = str.substr(1);
+	size_t start = 0;
+	while (start < str.size() && isspace(static_cast<unsigned char>(str[start])))
+		start++;
+	str.erase(0, start);
 }
 
 /**
@@ -30,6 +30,9 @@
 #include "./spss/datarecords.h"
 
 #include "./convertedstringcontainer.h"
+#include <QtConcurrent>
+#include <QFutureWatcher>
+#include <QEventLoop>
 
 #include "timers.h"
 
@@ -220,7 +223,7 @@ ImportDataSet* SPSSImporter::loadFile(const std::string &locator, boost::functio
 }
 
 /**
- * @brief _processStringsPostLoad - Deals with very Long std::strings (len > 255) and CP processes all std::strings.
+ * @brief _processStringsPostLoad - Deals with very Long std::strings (len > 255) and trims and CP processes all std::strings, one thread per column.
  * Call after the data is loaded!.
  */
 void SPSSImporter::_processStringsPostLoad(SPSSImportDataSet *dataset, boost::function<void (const std::string &, int)> progress)
@@ -290,32 +293,32 @@ void SPSSImporter::_processStringsPostLoad(SPSSImportDataSet *dataset, boost::fu
 		}
 	}
 
-	// Trim trialing spaces for all std::strings in the data set.
-	size_t numCols = distance(dataset->begin(), dataset->end());
+	// Trim and convert the std::strings and check the numerics, every column on its own so they can go in parallel.
+	std::vector<SPSSImportColumn*> columns;
 	for (ImportColumns::iterator iCol = dataset->begin(); iCol != dataset->end(); ++iCol)
-	{
-		SPSSImportColumn *col = dynamic_cast<SPSSImportColumn*>(*iCol);
-		{ // report progress
-			float prog = 100.0 * ((float) distance(dataset->begin(), iCol)) / numCols;
-			static float lastProg = -1.0;
-			if ((prog - lastProg) >= 1.0)
-			{
-				progress("Processing std::strings.", (int) (prog + 0.5));
-				lastProg = prog;
-			}
-		}
+		columns.push_back(dynamic_cast<SPSSImportColumn*>(*iCol));
+
+	QFuture<void> finishing = QtConcurrent::map(columns, [](SPSSImportColumn *& col) { col->finishLoading(); });
 
-		if (col->cellType() == SPSSImportColumn::cellString)
+	// Progress is reported from here, the callback isn't meant for other threads, so the watcher signals this thread and we wait in an event loop.
+	QFutureWatcher<void>	watcher;
+	QEventLoop				waitForFinishing;
+	int						lastProg = -1;
+
+	QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, [&](int value)
+	{
+		int prog = watcher.progressMaximum() > 0 ? (100 * value) / watcher.progressMaximum() : 0;
+		if (prog != lastProg)
 		{
-			DEBUG_COUT3("Dumping column '", col->spssRawColName(), "'.");
-			for (size_t cse  = 0; cse < col->strings.size(); cse++)
-			{
-				// Trim left and right.
-				StrUtils::lTrimWSIP(col->strings[cse]);
-				StrUtils::rTrimWSIP(col->strings[cse]);
-			}
+			progress("Processing std::strings.", prog);
+			lastProg = prog;
 		}
-	}
+	});
+	QObject::connect(&watcher, &QFutureWatcher<void>::finished, &waitForFinishing, &QEventLoop::quit);
+
+	watcher.setFuture(finishing); // Also emits finished when it already is
+	waitForFinishing.exec();
+	finishing.waitForFinished();
 }
 
 void SPSSImporter::fillSharedMemoryColumn(ImportColumn *importColumn, Column &column)
@@ -369,47 +372,4 @@ void SPSSImporter::reportFileProgress(SPSSStream::pos_type position, boost::func
 	}
 }
 
-/**
- * @brief resetNextCol. reset the col iterator
- *
- */
-void SPSSImporter::resetNextCol(SPSSImportDataSet *dataset)
-{
-	_currentColIter = dataset->begin();
-	SPSSImportColumn *col = dynamic_cast<SPSSImportColumn*>(*_currentColIter);
-	_remainingColSpan = col->columnSpan();
-}
-
-
-/**
- * @brief getNextColumn Get next column wrapping as required.
- * @return
- */
-SPSSImportColumn& SPSSImporter::getNextColumn(SPSSImportDataSet *dataset)
-{
-	// Grab what will be the result.
-	SPSSImportColumn *result = dynamic_cast<SPSSImportColumn*>(*_currentColIter);
-
-	// Set the spaning var.
-	_isSpaning = result->columnSpan() != _remainingColSpan;
-
-	// Anthing left (for next time)?
-	if (--_remainingColSpan == 0)
-	{
-		// Go to next column.
-		++_currentColIter;
-		// Dropped off end?
-		if (_currentColIter == dataset->end())
-		{
-			resetNextCol(dataset);
-		}
-		else
-		{
-			SPSSImportColumn* col = dynamic_cast<SPSSImportColumn*>(*_currentColIter);
-			_remainingColSpan = col->columnSpan();
-		}
-	}
-	return *result;
-}
-
 }
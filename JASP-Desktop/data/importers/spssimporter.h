@@ -50,33 +50,12 @@ public:
 	*/
 	void reportFileProgress(SPSSStream::pos_type position, boost::function<void (const std::string &, int)> progress);
 
-	/**
-	 * @brief resetNextCol reset the next col iterator
-	 *
-	 */
-	void resetNextCol(SPSSImportDataSet *dataset);
-
-	/**
-	 * @brief getColumn Get next column wrapping as required.
-	 * @return
-	 */
-	SPSSImportColumn& getNextColumn(SPSSImportDataSet *dataset);
-
-	/**
-	 * @brief isSpaning
-	 * @return True if the last getColumn() call found a contination column.
-	 */
-	bool isSpaning() const { return _isSpaning; }
-
 protected:
 	virtual ImportDataSet* loadFile(const std::string &locator, boost::function<void(const std::string &, int)> progressCallback);
 	virtual void fillSharedMemoryColumn(ImportColumn *importColumn, Column &column);
 
 private:
 	double						_fileSize = 0.0;
-	ImportColumns::iterator		_currentColIter;
-	size_t						_remainingColSpan;
-	bool						_isSpaning;
 
 	/**
 	 * @brief _processStringsPostLoad - Delas with very Long strings (len > 255) and CP processes all strings.
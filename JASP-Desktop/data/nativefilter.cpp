@@ -0,0 +1,276 @@
+#include "nativefilter.h"
+#include "stringutils.h"
+#include "log.h"
+#include <climits>
+#include <cmath>
+#include <cctype>
+
+enum class nativeOp { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, And, Or, Add, Subtract, Multiply, Divide, Power, Modulo };
+
+static const std::map<std::string, nativeOp> nativeOps =
+{
+	{ "==", nativeOp::Equal		}, { "!=", nativeOp::NotEqual		},
+	{ "<",	nativeOp::Less		}, { "<=", nativeOp::LessEqual		},
+	{ ">",	nativeOp::Greater	}, { ">=", nativeOp::GreaterEqual	},
+	{ "&",	nativeOp::And		}, { "|",  nativeOp::Or				},
+	{ "+",	nativeOp::Add		}, { "-",  nativeOp::Subtract		},
+	{ "*",	nativeOp::Multiply	}, { "/",  nativeOp::Divide			},
+	{ "^",	nativeOp::Power		}, { "%%", nativeOp::Modulo			}
+};
+
+static double toLogical(double value)			{ return value != value ? NAN : value != 0 ? 1 : 0; }
+static double andNA(double left, double right)	{ left = toLogical(left); right = toLogical(right); return left == 0 || right == 0 ? 0 : left != left || right != right ? NAN : 1; }
+static double orNA(double left, double right)	{ left = toLogical(left); right = toLogical(right); return left == 1 || right == 1 ? 1 : left != left || right != right ? NAN : 0; }
+
+bool NativeFilter::rFilterIsDefault(const std::string & rFilter)
+{
+	std::string stripped = stringUtils::stripRComments(rFilter);
+
+	stripped.erase(std::remove_if(stripped.begin(), stripped.end(), [](char kar) { return std::isspace(static_cast<unsigned char>(kar)); }), stripped.end());
+
+	return stripped == "generatedFilter";
+}
+
+bool NativeFilter::evaluate(const std::string & rFilter, const std::string & constructedJSON, std::vector<bool> & result)
+{
+	if(_dataSet == nullptr || _dataSet->rowCount() == 0 || !rFilterIsDefault(rFilter))
+		return false;
+
+	_rowCount = _dataSet->rowCount();
+
+	try
+	{
+		std::vector<double> passes(_rowCount, 1);
+
+		applyLabelFilters(passes);
+
+		Json::Value constructed;
+		if(constructedJSON != "" && !Json::Reader().parse(constructedJSON, constructed))
+			return false;
+
+		for(const Json::Value & formula : constructed.get("formulas", Json::arrayValue))
+		{
+			Values formulaResult = evaluateNode(formula);
+
+			if(formulaResult.kind != Values::Kind::Logical)
+				throw std::runtime_error("formula does not give a logical result");
+
+			for(size_t row=0; row<_rowCount; row++)
+				passes[row] = andNA(passes[row], formulaResult.at(row));
+		}
+
+		result.resize(_rowCount);
+		for(size_t row=0; row<_rowCount; row++)
+			result[row] = passes[row] == 1;
+	}
+	catch(std::exception & e)
+	{
+		Log::log() << "NativeFilter leaves filter to R because: " << e.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void NativeFilter::applyLabelFilters(std::vector<double> & logical)
+{
+	for(Column & column : _dataSet->columns())
+		if(!column.allLabelsPassFilter())
+		{
+			if(column.columnType() == Column::ColumnTypeScale)
+				throw std::runtime_error("label filter on scale column " + column.name());
+
+			std::map<int, bool> allowed;
+			for(const Label & label : column.labels())
+				allowed[label.value()] = label.filterAllows();
+
+			for(size_t row=0; row<_rowCount; row++)
+			{
+				int		key		= column.AsInts[row];
+				auto	found	= allowed.find(key);
+				double	pass	= key == INT_MIN ? NAN : found != allowed.end() && found->second ? 1 : 0;
+
+				logical[row] = andNA(logical[row], pass);
+			}
+		}
+}
+
+NativeFilter::Values NativeFilter::evaluateNode(const Json::Value & node)
+{
+	std::string nodeType = node.get("nodeType", "").asString();
+	Values		out;
+
+	if(nodeType == "Column")
+		return columnValues(node["columnName"].asString());
+
+	if(nodeType == "Number")
+	{
+		const Json::Value & value = node["value"];
+
+		out.kind	= Values::Kind::Numeric;
+		out.values	= { value.isString() ? std::stod(value.asString()) : value.asDouble() };
+		return out;
+	}
+
+	if(nodeType == "String")
+	{
+		out.kind	= Values::Kind::Text;
+		out.text	= node["text"].asString();
+		return out;
+	}
+
+	if(nodeType == "Operator" || nodeType == "OperatorVertical")
+	{
+		if(node["leftArgument"].isNull() || node["rightArgument"].isNull())
+			throw std::runtime_error("operator is missing an argument");
+
+		return evaluateOperator(node["operator"].asString(), evaluateNode(node["leftArgument"]), evaluateNode(node["rightArgument"]));
+	}
+
+	if(nodeType == "Function")
+		return evaluateFunction(node);
+
+	throw std::runtime_error("unsupported nodeType " + nodeType);
+}
+
+NativeFilter::Values NativeFilter::columnValues(const std::string & columnName)
+{
+	Column	&	column	= _dataSet->columns()[columnName];
+	Values		out;
+
+	if(column.columnType() != Column::ColumnTypeScale)
+	{
+		out.kind	= Values::Kind::Factor;
+		out.column	= &column;
+		return out;
+	}
+
+	out.kind = Values::Kind::Numeric;
+	out.values.resize(_rowCount);
+
+	for(size_t row=0; row<_rowCount; row++)
+		out.values[row] = column.AsDoubles[row];
+
+	return out;
+}
+
+NativeFilter::Values NativeFilter::compareFactor(const Values & factor, const Values & constant, bool equal)
+{
+	std::string constantText = constant.text;
+
+	if(constant.kind == Values::Kind::Numeric)
+	{
+		double number = constant.values[0];
+
+		//R would compare the factor to as.character(number), only integers are formatted the same way here
+		if(isNA(number) || number != std::floor(number) || std::fabs(number) >= 1e15)
+			throw std::runtime_error("factor compared to a non integer number");
+
+		constantText = std::to_string(static_cast<long long>(number));
+	}
+
+	std::map<int, bool> matches;
+	for(const Label & label : factor.column->labels())
+		matches[label.value()] = label.text() == constantText;
+
+	Values out;
+	out.kind = Values::Kind::Logical;
+	out.values.resize(_rowCount);
+
+	for(size_t row=0; row<_rowCount; row++)
+	{
+		int		key		= factor.column->AsInts[row];
+		auto	found	= matches.find(key);
+		bool	match	= found != matches.end() && found->second;
+
+		out.values[row] = key == INT_MIN ? NAN : match == equal ? 1 : 0;
+	}
+
+	return out;
+}
+
+NativeFilter::Values NativeFilter::evaluateOperator(const std::string & opName, const Values & left, const Values & right)
+{
+	if(nativeOps.count(opName) == 0)
+		throw std::runtime_error("unsupported operator " + opName);
+
+	nativeOp op = nativeOps.at(opName);
+
+	auto isConstant = [](const Values & v) { return v.kind == Values::Kind::Text || (v.kind == Values::Kind::Numeric && v.values.size() == 1); };
+
+	if(op == nativeOp::Equal || op == nativeOp::NotEqual)
+	{
+		if(left.kind  == Values::Kind::Factor && isConstant(right))	return compareFactor(left, right, op == nativeOp::Equal);
+		if(right.kind == Values::Kind::Factor && isConstant(left))	return compareFactor(right, left, op == nativeOp::Equal);
+	}
+
+	if(left.kind == Values::Kind::Factor || right.kind == Values::Kind::Factor || left.kind == Values::Kind::Text || right.kind == Values::Kind::Text)
+		throw std::runtime_error("operator " + opName + " used on text or a factor");
+
+	bool	arithmetic	= op >= nativeOp::Add;
+	size_t	count		= left.values.size() == 1 && right.values.size() == 1 ? 1 : _rowCount;
+
+	Values out;
+	out.kind = arithmetic ? Values::Kind::Numeric : Values::Kind::Logical;
+	out.values.resize(count);
+
+	for(size_t i=0; i<count; i++)
+	{
+		double a = left.at(i), b = right.at(i), & v = out.values[i];
+
+		if(op == nativeOp::And)					v = andNA(a, b);
+		else if(op == nativeOp::Or)				v = orNA(a, b);
+		else if(isNA(a) || isNA(b))				v = NAN;
+		else
+			switch(op)
+			{
+			case nativeOp::Equal:			v = a == b;								break;
+			case nativeOp::NotEqual:		v = a != b;								break;
+			case nativeOp::Less:			v = a <  b;								break;
+			case nativeOp::LessEqual:		v = a <= b;								break;
+			case nativeOp::Greater:			v = a >  b;								break;
+			case nativeOp::GreaterEqual:	v = a >= b;								break;
+			case nativeOp::Add:				v = a + b;								break;
+			case nativeOp::Subtract:		v = a - b;								break;
+			case nativeOp::Multiply:		v = a * b;								break;
+			case nativeOp::Divide:			v = a / b;								break;
+			case nativeOp::Power:			v = std::pow(a, b);						break;
+			case nativeOp::Modulo:			v = a - std::floor(a / b) * b;			break; //R's %% takes the sign of the divisor
+			default:																break;
+			}
+	}
+
+	return out;
+}
+
+NativeFilter::Values NativeFilter::evaluateFunction(const Json::Value & node)
+{
+	std::string			functionName	= node["functionName"].asString();
+	const Json::Value &	arguments		= node["arguments"];
+
+	if(!arguments.isArray() || arguments.size() != 1 || arguments[0u]["argument"].isNull())
+		throw std::runtime_error("function " + functionName + " needs exactly one argument");
+
+	if(functionName != "!" && functionName != "abs" && functionName != "sqrt")
+		throw std::runtime_error("unsupported function " + functionName);
+
+	Values argument = evaluateNode(arguments[0u]["argument"]);
+
+	if(argument.kind != Values::Kind::Numeric && argument.kind != Values::Kind::Logical)
+		throw std::runtime_error("function " + functionName + " used on text or a factor");
+
+	Values out;
+	out.kind = functionName == "!" ? Values::Kind::Logical : Values::Kind::Numeric;
+	out.values.resize(argument.values.size());
+
+	for(size_t i=0; i<argument.values.size(); i++)
+	{
+		double a = argument.values[i];
+
+		if(functionName == "!")			out.values[i] = isNA(a) ? NAN : a == 0 ? 1 : 0;
+		else if(functionName == "abs")	out.values[i] = std::fabs(a);
+		else							out.values[i] = std::sqrt(a);
+	}
+
+	return out;
+}
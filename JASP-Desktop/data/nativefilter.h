@@ -0,0 +1,51 @@
+#ifndef NATIVEFILTER_H
+#define NATIVEFILTER_H
+
+#include "dataset.h"
+#include "jsonredirect.h"
+#include <vector>
+#include <map>
+
+/* NativeFilter evaluates the label filters and the filter constructor formulas straight from the Columns in shared memory.
+ * This way the common case of ticking labels on the Variables page or building a simple comparison does not need a roundtrip to R.
+ * Only the comparison, arithmetic and boolean subset of the constructor is supported, and only when the R filter is still the default.
+ * Anything else makes evaluate return false, which means the filter should be sent to R like before.
+ * It mimics R: missing values are NA, NA propagates through comparisons and &/| and a row whose result is NA does not pass.
+ */
+class NativeFilter
+{
+public:
+	NativeFilter(DataSet * dataSet) : _dataSet(dataSet) {}
+
+	bool evaluate(const std::string & rFilter, const std::string & constructedJSON, std::vector<bool> & result);
+
+	static bool rFilterIsDefault(const std::string & rFilter);
+
+private:
+	struct Values
+	{
+		enum class Kind { Numeric, Logical, Text, Factor };
+
+		Kind							kind	= Kind::Numeric;
+		std::vector<double>				values;				//NaN is NA, for Logical 0 and 1. A single value is recycled like R does.
+		std::string						text;				//for Kind::Text
+		Column						*	column	= nullptr;	//for Kind::Factor
+
+		double	at(size_t row)	const { return values.size() == 1 ? values[0] : values[row]; }
+	};
+
+	void	applyLabelFilters(			std::vector<double> & logical);
+	Values	evaluateNode(				const Json::Value & node);
+	Values	evaluateOperator(			const std::string & op, const Values & left, const Values & right);
+	Values	evaluateFunction(			const Json::Value & node);
+	Values	compareFactor(				const Values & factor, const Values & constant, bool equal);
+	Values	columnValues(				const std::string & columnName);
+
+	static bool	isNA(double value) { return value != value; }
+
+private:
+	DataSet	*	_dataSet	= nullptr;
+	size_t		_rowCount	= 0;
+};
+
+#endif // NATIVEFILTER_H
@@ -0,0 +1,376 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#include "engineperformance.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QVariantMap>
+#include <sstream>
+
+#include "gui/messageforwarder.h"
+#include "utilities/appdirs.h"
+#include "utilities/qutils.h"
+#include "fastjson.h"
+#include "log.h"
+
+EnginePerformance::EnginePerformance(const std::vector<EngineRepresentation*> & engines, QObject * parent)
+	: QObject(parent), _engines(engines)
+{
+	connect(&_sampleTimer, &QTimer::timeout, this, &EnginePerformance::sample);
+	updateSampling();
+}
+
+void EnginePerformance::updateSampling()
+{
+	bool shouldSample = _visible || tracing();
+
+	if(shouldSample == _sampleTimer.isActive())
+		return;
+
+	if(shouldSample)
+	{
+		_previousSamples.clear(); //Otherwise the first tick averages over all the time nobody was sampling
+		_sampleTimer.start(_sampleIntervalMs);
+	}
+	else
+		_sampleTimer.stop();
+}
+
+void EnginePerformance::setVisible(bool visible)
+{
+	if (_visible == visible)
+		return;
+
+	_visible = visible;
+	emit visibleChanged(_visible);
+
+	updateSampling();
+
+	if(_visible)
+		sample();
+}
+
+void EnginePerformance::setTracing(bool tracing)
+{
+	if(JaspTimer::enabled() == tracing)
+		return;
+
+	JaspTimer::setEnabled(tracing);
+	updateSampling();
+	emit tracingChanged(tracing); //EngineSync passes it on to the engines through the logCfg, they write their tracefile when it goes off
+}
+
+EnginePerformance::engineSample EnginePerformance::sampleEngine(EngineRepresentation * engine) const
+{
+	engineSample sample;
+
+	sample.counters		= engine->counters();
+	sample.ipcSent		= engine->ipcBytesSent();
+	sample.ipcReceived	= engine->ipcBytesReceived();
+	sample.atUs			= nowUs();
+
+	return sample;
+}
+
+void EnginePerformance::analysisWaiting(int analysisId)
+{
+	if(_waitingSince.count(analysisId) == 0)
+		_waitingSince[analysisId] = nowUs();
+}
+
+void EnginePerformance::requestStarted(int channelNr, const QString & category, const QString & name, int analysisId)
+{
+	if(_running.count(channelNr) > 0) //Engine was restarted or the reply got lost somehow, either way the previous request is over
+		requestFinished(channelNr);
+
+	EngineRepresentation * engine = nullptr;
+	for(EngineRepresentation * e : _engines)
+		if(e != nullptr && e->engineChannelID() == channelNr)
+			engine = e;
+
+	if(engine == nullptr)
+		return;
+
+	runningRequest & request	= _running[channelNr];
+	request.category			= category;
+	request.name				= name;
+	request.analysisId			= analysisId;
+	request.atStart				= sampleEngine(engine);
+	request.startedUs			= request.atStart.atUs;
+	request.queueWaitUs			= 0;
+
+	if(analysisId < 0 || _waitingSince.count(analysisId) == 0)
+		return;
+
+	qint64 since				= _waitingSince[analysisId];
+	request.queueWaitUs			= request.startedUs - since;
+	_waitingSince.erase(analysisId);
+
+	_lastQueueWaitUs[channelNr]		 = request.queueWaitUs;
+	_totalQueueWaitUs[channelNr]	+= request.queueWaitUs;
+	_queuedRequests[channelNr]		+= 1;
+
+	//The waiting of different analyses overlaps, async events can handle that where complete events cannot
+	Json::Value waitBegin(Json::objectValue);
+	waitBegin["ph"]		= "b";
+	waitBegin["cat"]	= "queue";
+	waitBegin["name"]	= "waiting for an engine";
+	waitBegin["id"]		= analysisId;
+	waitBegin["pid"]	= 0;
+	waitBegin["ts"]		= double(since);
+	waitBegin["args"]["analysis"]	= fq(name);
+
+	Json::Value waitEnd	= waitBegin;
+	waitEnd["ph"]		= "e";
+	waitEnd["ts"]		= double(request.startedUs);
+	waitEnd["args"]["engine"] = channelNr;
+
+	addTraceEvent(waitBegin);
+	addTraceEvent(waitEnd);
+}
+
+void EnginePerformance::requestFinished(int channelNr)
+{
+	if(_running.count(channelNr) == 0)
+		return;
+
+	runningRequest request = _running[channelNr];
+	_running.erase(channelNr);
+
+	engineSample atEnd = request.atStart;
+	atEnd.atUs = nowUs();
+
+	for(EngineRepresentation * e : _engines)
+		if(e != nullptr && e->engineChannelID() == channelNr)
+			atEnd = sampleEngine(e);
+
+	auto delta = [](uint64_t now, uint64_t then) { return now >= then ? now - then : 0; };
+
+	Json::Value event(Json::objectValue);
+	event["ph"]		= "X";
+	event["cat"]	= fq(request.category);
+	event["name"]	= fq(request.name);
+	event["pid"]	= 0;
+	event["tid"]	= channelNr;
+	event["ts"]		= double(request.startedUs);
+	event["dur"]	= double(atEnd.atUs - request.startedUs);
+
+	Json::Value & args		= event["args"];
+	args["rEvalMs"]			= usToMs(delta(atEnd.counters.rEvalUs,				request.atStart.counters.rEvalUs));
+	args["dataExtractionMs"]= usToMs(delta(atEnd.counters.dataExtractionUs,		request.atStart.counters.dataExtractionUs));
+	args["serializationMs"]	= usToMs(delta(atEnd.counters.serializationUs,		request.atStart.counters.serializationUs));
+	args["ipcSentKB"]		= delta(atEnd.ipcSent,		request.atStart.ipcSent)		/ 1024.0;
+	args["ipcReceivedKB"]	= delta(atEnd.ipcReceived,	request.atStart.ipcReceived)	/ 1024.0;
+	args["rssMB"]			= atEnd.counters.rssKB / 1024.0;
+
+	if(request.analysisId >= 0)
+	{
+		args["analysisId"]	= request.analysisId;
+		args["queueWaitMs"]	= usToMs(request.queueWaitUs);
+	}
+
+	addTraceEvent(event);
+}
+
+void EnginePerformance::sample()
+{
+	auto delta = [](uint64_t now, uint64_t then) { return now >= then ? now - then : 0; };
+
+	QVariantList summaries;
+
+	for(EngineRepresentation * engine : _engines)
+	{
+		if(engine == nullptr)
+			continue;
+
+		int				channelNr	= engine->engineChannelID();
+		engineSample	now			= sampleEngine(engine),
+						previous	= _previousSamples.count(channelNr) > 0 ? _previousSamples[channelNr] : now;
+		std::string		prefix		= "jaspEngine #" + std::to_string(channelNr);
+		double			intervalMs	= std::max(1.0, (now.atUs - previous.atUs) / 1000.0);
+
+		_previousSamples[channelNr] = now;
+
+		Json::Value memory(Json::objectValue);
+		memory["ph"]					= "C";
+		memory["name"]					= prefix + " memory";
+		memory["pid"]					= 0;
+		memory["ts"]					= double(now.atUs);
+		memory["args"]["rssMB"]			= now.counters.rssKB / 1024.0;
+
+		Json::Value time				= memory;
+		time["name"]					= prefix + " time per second";
+		time["args"]					= Json::objectValue;
+		time["args"]["rEvalMs"]			= usToMs(delta(now.counters.rEvalUs,			previous.counters.rEvalUs))				* 1000.0 / intervalMs;
+		time["args"]["dataExtractionMs"]= usToMs(delta(now.counters.dataExtractionUs,	previous.counters.dataExtractionUs))	* 1000.0 / intervalMs;
+		time["args"]["serializationMs"]	= usToMs(delta(now.counters.serializationUs,	previous.counters.serializationUs))		* 1000.0 / intervalMs;
+
+		Json::Value ipc					= memory;
+		ipc["name"]						= prefix + " ipc";
+		ipc["args"]						= Json::objectValue;
+		ipc["args"]["sentKB"]			= delta(now.ipcSent,		previous.ipcSent)		/ 1024.0;
+		ipc["args"]["receivedKB"]		= delta(now.ipcReceived,	previous.ipcReceived)	/ 1024.0;
+
+		if(tracing())
+		{
+			addTraceEvent(memory);
+			addTraceEvent(time);
+			addTraceEvent(ipc);
+		}
+
+		if(!_visible)
+			continue;
+
+		QString state = "idle";
+		if(_running.count(channelNr) > 0)
+			state = _running[channelNr].category + ": " + _running[channelNr].name + " (" + QString::number((now.atUs - _running[channelNr].startedUs) / 1000000.0, 'f', 1) + "s)";
+
+		QVariantMap summary;
+		summary["channel"]			= channelNr;
+		summary["pid"]				= qlonglong(engine->jaspEnginePID());
+		summary["state"]			= state;
+		summary["requests"]			= qulonglong(now.counters.requests);
+		summary["ipcSentKB"]		= now.ipcSent		/ 1024.0;
+		summary["ipcReceivedKB"]	= now.ipcReceived	/ 1024.0;
+		summary["dataExtractionMs"]	= usToMs(now.counters.dataExtractionUs);
+		summary["rEvalMs"]			= usToMs(now.counters.rEvalUs);
+		summary["serializationMs"]	= usToMs(now.counters.serializationUs);
+		summary["rBusyPercent"]		= std::min(100.0, usToMs(delta(now.counters.rEvalUs, previous.counters.rEvalUs)) * 100.0 / intervalMs);
+		summary["rssMB"]			= now.counters.rssKB / 1024.0;
+		summary["lastQueueWaitMs"]	= usToMs(_lastQueueWaitUs[channelNr]);
+		summary["meanQueueWaitMs"]	= _queuedRequests[channelNr] == 0 ? 0.0 : usToMs(_totalQueueWaitUs[channelNr] / _queuedRequests[channelNr]);
+
+		summaries.push_back(summary);
+	}
+
+	if(_visible)
+	{
+		_engineSummaries = summaries;
+		emit enginesChanged();
+	}
+}
+
+void EnginePerformance::addTraceEvent(const Json::Value & event)
+{
+	_traceEvents.push_back(fastJson::write(event));
+
+	while(_traceEvents.size() > _maxTraceEvents)
+		_traceEvents.pop_front();
+}
+
+void EnginePerformance::clearTrace()
+{
+	_traceEvents.clear();
+	JaspTimer::clear();
+	emit enginesChanged();
+}
+
+bool EnginePerformance::writeChromeTrace(const QString & path) const
+{
+	QFile file(path);
+
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	Json::Value process(Json::objectValue);
+	process["ph"]				= "M";
+	process["name"]				= "process_name";
+	process["pid"]				= 0;
+	process["args"]["name"]		= "jaspEngines";
+
+	file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	file.write(fastJson::write(process).c_str());
+
+	for(EngineRepresentation * engine : _engines)
+		if(engine != nullptr)
+		{
+			Json::Value thread(Json::objectValue);
+			thread["ph"]			= "M";
+			thread["name"]			= "thread_name";
+			thread["pid"]			= 0;
+			thread["tid"]			= engine->engineChannelID();
+			thread["args"]["name"]	= "jaspEngine #" + std::to_string(engine->engineChannelID());
+
+			file.write(",\n");
+			file.write(fastJson::write(thread).c_str());
+		}
+
+	for(const std::string & event : _traceEvents)
+	{
+		file.write(",\n");
+		file.write(event.c_str(), qint64(event.size()));
+	}
+
+	std::stringstream	desktopEvents;
+	bool				first = true;
+
+	if(JaspTimer::writeTraceEvents(desktopEvents, first) > 0)
+	{
+		file.write(",\n");
+		file.write(desktopEvents.str().c_str());
+	}
+
+	writeEngineTraceFiles(file);
+
+	file.write("\n]}\n");
+
+	return file.error() == QFileDevice::NoError;
+}
+
+///The engines write their own trace next to their log when tracing goes off or they stop, whatever is there from this session gets merged in
+size_t EnginePerformance::writeEngineTraceFiles(QFile & file) const
+{
+	QFileInfo	base(tq(Log::logFileNameBase));
+	QDir		logDir	= base.absoluteDir();
+	size_t		written	= 0;
+
+	for(const QFileInfo & traceFile : logDir.entryInfoList({ base.fileName() + " Engine*.trace.json" }, QDir::Filter::Files, QDir::SortFlag::Name))
+	{
+		QFile		engineFile(traceFile.absoluteFilePath());
+		Json::Value	engineTrace;
+
+		if(!engineFile.open(QIODevice::ReadOnly) || !Json::Reader().parse(engineFile.readAll().toStdString(), engineTrace) || !engineTrace["traceEvents"].isArray())
+		{
+			Log::log() << "Could not read engine trace " << traceFile.absoluteFilePath().toStdString() << std::endl;
+			continue;
+		}
+
+		for(const Json::Value & event : engineTrace["traceEvents"])
+		{
+			file.write(",\n");
+			file.write(fastJson::write(event).c_str());
+			written++;
+		}
+	}
+
+	return written;
+}
+
+void EnginePerformance::exportChromeTrace()
+{
+	QString path = MessageForwarder::browseSaveFile("Export engine trace", AppDirs::documents() + "/jasp-engines.trace.json", "Chrome trace (*.json)");
+
+	if(path.isEmpty())
+		return;
+
+	Log::log() << "Writing " << _traceEvents.size() << " engine trace events to " << path.toStdString() << std::endl;
+
+	if(!writeChromeTrace(path))
+		MessageForwarder::showWarning("Export engine trace", "Could not write the trace to " + path);
+}
@@ -0,0 +1,118 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ENGINEPERFORMANCE_H
+#define ENGINEPERFORMANCE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QFile>
+#include <QVariantList>
+#include <deque>
+#include <map>
+#include "enginerepresentation.h"
+#include "timers.h"
+
+/* EnginePerformance samples the engineCounters every jaspEngine keeps in its IPCChannel, together with the requests EngineSync hands out and how long analyses waited for an engine.
+ * It shows them live in the EnginePerformanceWindow and, while tracing, keeps (a bounded number of) them as trace events, which can be exported in the Chrome trace format.
+ * It only samples while the window is open or tracing is on, otherwise nobody would ever see the samples.
+ * Such a file can be opened in chrome://tracing or https://ui.perfetto.dev to see what all the engines were doing during a session.
+ * When tracing is on the JASPTIMER_* events of the desktop and of the engines (see timers.h) are merged into it, they share the same timebase.
+ */
+class EnginePerformance : public QObject
+{
+	Q_OBJECT
+	Q_PROPERTY(bool			visible		READ visible		WRITE setVisible	NOTIFY visibleChanged	)
+	Q_PROPERTY(QVariantList	engines		READ engines							NOTIFY enginesChanged	)
+	Q_PROPERTY(int			traceEvents	READ traceEvents						NOTIFY enginesChanged	)
+	Q_PROPERTY(bool			tracing		READ tracing		WRITE setTracing	NOTIFY tracingChanged	)
+
+public:
+	explicit EnginePerformance(const std::vector<EngineRepresentation*> & engines, QObject * parent);
+
+	bool			visible()		const { return _visible;					}
+	QVariantList	engines()		const { return _engineSummaries;			}
+	int				traceEvents()	const { return int(_traceEvents.size());	}
+	bool			tracing()		const { return JaspTimer::enabled();		}
+
+	///Called by EngineSync for every analysis that wants an engine, the first call starts the clock on its queue wait
+	void			analysisWaiting(int analysisId);
+	bool			writeChromeTrace(const QString & path) const;
+
+	Q_INVOKABLE void exportChromeTrace();
+	Q_INVOKABLE void clearTrace();
+
+public slots:
+	void setVisible(bool visible);
+	void setTracing(bool tracing);
+	void requestStarted(	int channelNr, const QString & category, const QString & name, int analysisId);
+	void requestFinished(	int channelNr);
+	void analysisRemoved(	Analysis * analysis) { _waitingSince.erase(analysis->id()); }
+
+signals:
+	void visibleChanged(bool visible);
+	void enginesChanged();
+	void tracingChanged(bool tracing);
+
+private slots:
+	void sample();
+
+private:
+	struct engineSample
+	{
+		engineCounterValues	counters;
+		size_t				ipcSent			= 0,
+							ipcReceived		= 0;
+		qint64				atUs			= 0;
+	};
+
+	struct runningRequest
+	{
+		QString			category,
+						name;
+		int				analysisId		= -1;
+		qint64			startedUs		= 0,
+						queueWaitUs		= 0;
+		engineSample	atStart;
+	};
+
+	void			updateSampling();
+	engineSample	sampleEngine(EngineRepresentation * engine) const;
+	void			addTraceEvent(const Json::Value & event);
+	size_t			writeEngineTraceFiles(QFile & file) const;
+	qint64			nowUs()	const { return qint64(JaspTimer::nowAlignedUs()); }
+
+	static double	usToMs(uint64_t us) { return us / 1000.0; }
+
+	const std::vector<EngineRepresentation*>	&	_engines;
+	bool											_visible			= false;
+	QTimer											_sampleTimer;
+	QVariantList									_engineSummaries;
+	std::map<int, qint64>							_waitingSince;		///< analysisId -> when it was first seen waiting
+	std::map<int, runningRequest>					_running;			///< channelNr -> what it is busy with
+	std::map<int, engineSample>						_previousSamples;	///< channelNr -> the sample of the last tick
+	std::map<int, qint64>							_lastQueueWaitUs,
+													_totalQueueWaitUs,
+													_queuedRequests;
+	std::deque<std::string>							_traceEvents;		///< Already written as json, to keep them small
+
+	static const size_t								_maxTraceEvents		= 100000;
+	static const int								_sampleIntervalMs	= 1000;
+};
+
+#endif // ENGINEPERFORMANCE_H
@@ -2,6 +2,12 @@
 #include "utilities/settings.h"
 #include "gui/messageforwarder.h"
 #include "log.h"
+#include "fastjson.h"
+#include <QDateTime>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
 
 EngineRepresentation::EngineRepresentation(IPCChannel * channel, QProcess * slaveProcess, QObject * parent)
 	: QObject(parent), _channel(channel)
@@ -14,10 +20,52 @@ EngineRepresentation::EngineRepresentation(IPCChannel * channel, QProcess * slav
 void EngineRepresentation::setSlaveProcess(QProcess * slaveProcess)
 {
 	_slaveProcess = slaveProcess;
+
+	if(_slaveProcess == nullptr) //Then the zygote will fork one for us
+		return;
+
 	_slaveProcess->setParent(this);
 	connect(_slaveProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),	this,	&EngineRepresentation::jaspEngineProcessFinished);
 }
 
+bool EngineRepresentation::forkedEngineAlive() const
+{
+	return _forkedPID > 0 && !_channel->exitStatus()->exited(int(_forkedPID)); //The zygote only reports it after reaping, until then the PID can't belong to anyone else
+}
+
+bool EngineRepresentation::forkedEngineDisappeared(bool zygoteRunning, bool & crashed)
+{
+	if(_forkedPID <= 0)
+		return false;
+
+	if(forkedEngineAlive())
+	{
+		if(zygoteRunning)
+			return false;
+
+		//Without the zygote nobody reports the exit, but it also took its engines with it (PR_SET_PDEATHSIG)
+		crashed = true;
+	}
+	else
+		crashed = _channel->exitStatus()->crashed();
+
+	Log::log() << "forked jaspEngine for channel " << engineChannelID() << " with PID " << _forkedPID << " is gone" << (crashed ? " and did not exit cleanly!" : ".") << std::endl;
+	logAnalysisInProgressResources();
+	finishRequest();
+
+	_forkedPID = 0;
+	return true;
+}
+
+void EngineRepresentation::killForkedEngine()
+{
+#ifndef _WIN32
+	if(forkedEngineAlive())
+		kill(pid_t(_forkedPID), SIGKILL);
+#endif
+	_forkedPID = 0;
+}
+
 EngineRepresentation::~EngineRepresentation()
 {
 	Log::log() << "~EngineRepresentation()" << std::endl;
@@ -29,6 +77,8 @@ EngineRepresentation::~EngineRepresentation()
 		_slaveProcess->kill();
 	}
 
+	killForkedEngine();
+
 	delete _channel;
 	_channel = nullptr;
 }
@@ -44,16 +94,51 @@ void EngineRepresentation::sendString(std::string str)
 void EngineRepresentation::jaspEngineProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
 	Log::log() << "jaspEngine for channel " << engineChannelID() << " finished!" << std::endl;
+	logAnalysisInProgressResources();
+	finishRequest();
 
 	_slaveProcess = nullptr;
 }
 
+Json::Value EngineRepresentation::resourceLimitsJson()
+{
+	Json::Value limits		= Json::objectValue;
+
+	limits["softMemoryMB"]	= Settings::value(Settings::ANALYSIS_SOFT_MEMORY_MB).toDouble();
+	limits["hardMemoryMB"]	= Settings::value(Settings::ANALYSIS_HARD_MEMORY_MB).toDouble();
+	limits["softSeconds"]	= Settings::value(Settings::ANALYSIS_SOFT_SECONDS).toDouble();
+	limits["hardSeconds"]	= Settings::value(Settings::ANALYSIS_HARD_SECONDS).toDouble();
+
+	return limits;
+}
+
+void EngineRepresentation::logAnalysisInProgressResources()
+{
+	if(_analysisInProgress == nullptr)
+		return;
+
+	Log::log() << "It was running analysis " << _analysisInProgress->name() << " (" << _analysisInProgress->id() << ") for " << msAnalysisInProgress() << "ms, the last it reported using was: " << fastJson::write(_analysisInProgress->resourceUsage()) << std::endl;
+}
+
 void EngineRepresentation::clearAnalysisInProgress()
 {
+	if(_engineState == engineState::analysis)
+		finishRequest();
+
 	_analysisInProgress = nullptr;
 	_engineState		= engineState::idle;
 }
 
+void EngineRepresentation::startRequest(const std::string & name, int analysisId)
+{
+	emit requestStarted(engineChannelID(), engineStateToQString(_engineState), QString::fromStdString(name), analysisId);
+}
+
+void EngineRepresentation::finishRequest()
+{
+	emit requestFinished(engineChannelID());
+}
+
 void EngineRepresentation::setAnalysisInProgress(Analysis* analysis)
 {
 	if(_engineState == engineState::analysis)
@@ -65,7 +150,29 @@ void EngineRepresentation::setAnalysisInProgress(Analysis* analysis)
 	if(_engineState != engineState::idle)	throw std::runtime_error("Engine " + std::to_string(_channel->channelNumber()) + " is not idle! Yet you are trying to set an analysis in progress on it..");
 
 	_analysisInProgress = analysis;
+	_analysisStartedAt	= QDateTime::currentMSecsSinceEpoch();
 	_engineState		= engineState::analysis;
+
+	startRequest(analysis->name(), analysis->id());
+}
+
+qint64 EngineRepresentation::msAnalysisInProgress() const
+{
+	return _engineState == engineState::analysis ? QDateTime::currentMSecsSinceEpoch() - _analysisStartedAt : 0;
+}
+
+void EngineRepresentation::preemptAnalysisInProgress()
+{
+	if(_engineState != engineState::analysis || _analysisInProgress == nullptr)
+		return;
+
+	Analysis * preempted = _analysisInProgress;
+
+	Log::log() << "Preempting analysis #" << preempted->id() << " on engine " << channelNumber() << " after " << msAnalysisInProgress() << "ms to make room for a more urgent one." << std::endl;
+
+	preempted->setStatus(Analysis::Aborting);
+	runAnalysisOnProcess(preempted);			//Sends the abort to jaspEngine and clears us
+	preempted->setStatus(Analysis::Empty);		//So that EngineSync queues it again
 }
 
 void EngineRepresentation::process()
@@ -86,7 +193,9 @@ void EngineRepresentation::process()
 #endif
 
 		Json::Value json;
-		Json::Reader().parse(data, json);
+
+		if(!fastJson::parse(data, json))
+			throw std::runtime_error("Malformed reply from engine!");
 
 		if(!json.get("typeRequest", Json::nullValue).isString() && _engineState != engineState::analysis)
 			throw std::runtime_error("Malformed reply from engine!");
@@ -107,6 +216,27 @@ void EngineRepresentation::process()
 		default:							throw std::logic_error("If you define new engineStates you should add them to the switch in EngineRepresentation::process()!");
 		}
 	}
+	else
+		processProgress(); //Only when no message is waiting, because those might carry an older progress
+}
+
+void EngineRepresentation::processProgress()
+{
+	int			analysisId, revision, progress;
+	uint32_t	updates;
+
+	if(!_channel->progress()->read(analysisId, revision, progress, updates) || updates == _progressSeen)
+		return;
+
+	_progressSeen = updates;
+
+	if(_engineState != engineState::analysis || _analysisInProgress == nullptr)
+		return;
+
+	if(analysisId != int(_analysisInProgress->id()) || revision != _analysisInProgress->revision())
+		return;
+
+	_analysisInProgress->setProgress(progress);
 }
 
 
@@ -123,9 +253,11 @@ void EngineRepresentation::runScriptOnProcess(RFilterStore * filterStore)
 	QString dataFilter = filterStore->script == "" ? "*" : filterStore->script;
 	json["filter"] = dataFilter.toStdString();
 
+	startRequest("filter #" + std::to_string(filterStore->requestId));
+
 	Log::log() << "sending filter with requestID " << filterStore->requestId << " to engine" << std::endl;
 
-	sendString(json.toStyledString());
+	sendString(fastJson::write(json));
 }
 
 void EngineRepresentation::processFilterReply(Json::Value & json)
@@ -133,6 +265,7 @@ void EngineRepresentation::processFilterReply(Json::Value & json)
 	if(_engineState != engineState::filter)
 		throw std::runtime_error("Received an unexpected filter reply!");
 	_engineState = engineState::idle;
+	finishRequest();
 
 #ifdef PRINT_ENGINE_MESSAGES
 			Log::log() << "msg is filter reply" << std::endl << std::flush;
@@ -164,7 +297,8 @@ void EngineRepresentation::runScriptOnProcess(RScriptStore * scriptStore)
 	json["rCode"]			= scriptStore->script.toStdString();
 	json["requestId"]		= scriptStore->requestId;
 
-	sendString(json.toStyledString());
+	startRequest("rCode #" + std::to_string(scriptStore->requestId));
+	sendString(fastJson::write(json));
 }
 
 
@@ -173,6 +307,7 @@ void EngineRepresentation::processRCodeReply(Json::Value & json)
 	if(_engineState != engineState::rCode)
 		throw std::runtime_error("Received an unexpected rCode reply!");
 	_engineState = engineState::idle;
+	finishRequest();
 
 	std::string rCodeResult = json.get("rCodeResult", "").asString();
 	int requestId			= json.get("requestId", -1).asInt();
@@ -194,7 +329,8 @@ void EngineRepresentation::runScriptOnProcess(RComputeColumnStore * computeColum
 	json["computeCode"]		= computeColumnStore->script.toStdString();
 	json["columnType"]		= Column::columnTypeToString(computeColumnStore->columnType);
 
-	sendString(json.toStyledString());
+	startRequest(computeColumnStore->columnName.toStdString());
+	sendString(fastJson::write(json));
 }
 
 
@@ -203,6 +339,7 @@ void EngineRepresentation::processComputeColumnReply(Json::Value & json)
 	if(_engineState != engineState::computeColumn)
 		throw std::runtime_error("Received an unexpected computeColumn reply!");
 	_engineState = engineState::idle;
+	finishRequest();
 
 
 	std::string result		= json.get("result", "some string that is not 'TRUE' or 'FALSE'").asString();
@@ -223,14 +360,19 @@ void EngineRepresentation::runAnalysisOnProcess(Analysis *analysis)
 	setAnalysisInProgress(analysis);
 
 	Json::Value json(analysis->createAnalysisRequestJson(_ppi, _imageBackground.toStdString()));
-	_channel->send(json.toStyledString());
+	json["resourceLimits"] = resourceLimitsJson();
+	_channel->send(fastJson::write(json));
 
 #ifdef PRINT_ENGINE_MESSAGES
 	Log::log() << "sending: " << json.toStyledString() << std::endl;
 #endif
 
 	if(analysis->isAborted())
+	{
+		_abortedId			= int(analysis->id());
+		_abortedRevision	= analysis->revision();
 		clearAnalysisInProgress();
+	}
 
 }
 
@@ -256,6 +398,9 @@ void EngineRepresentation::analysisRemoved(Analysis * analysis)
 		return;
 
 	runAnalysisOnProcess(analysis); //should abort
+
+	_abortedId			= int(analysis->id());
+	_abortedRevision	= analysis->revision();
 	clearAnalysisInProgress();
 }
 
@@ -280,13 +425,31 @@ void EngineRepresentation::processAnalysisReply(Json::Value & json)
 	Analysis *analysis			= _analysisInProgress;
 
 	if (analysis->id() != id || analysis->revision() < revision)
-		throw std::runtime_error("Received results for wrong analysis!");
+	{
+		if (id != _abortedId || revision != _abortedRevision)
+			throw std::runtime_error("Received results for wrong analysis!");
+
+		//An aborted or preempted analysis can still get a reply out before the jaspEngine notices, those belong to nobody anymore
+		Log::log() << "Dropping a late reply for aborted analysis #" << id << " revision " << revision << " while engine " << channelNumber() << " is running analysis #" << analysis->id() << " revision " << analysis->revision() << std::endl;
+		return;
+	}
 
 	if(analysis->revision() > revision) //I guess we changed some option or something?
 		return;
 
 	analysis->setStatus(analysisResultStatusToAnalysStatus(status, analysis));
 
+	if(status != analysisResultStatus::running)
+		analysis->addMsInEngine(msAnalysisInProgress());
+
+	if(json.isMember("resources"))
+	{
+		analysis->setResourceUsage(json["resources"]);
+
+		if(status != analysisResultStatus::running)
+			Log::log() << "Analysis " << analysis->name() << " (" << id << ") used: " << fastJson::write(json["resources"]) << std::endl;
+	}
+
 	switch(status)
 	{
 	case analysisResultStatus::imageSaved:
@@ -358,7 +521,7 @@ void EngineRepresentation::sendStopEngine()
 
 	Log::log() << "informing engine that it ought to stop" << std::endl;
 
-	sendString(json.toStyledString());
+	sendString(fastJson::write(json));
 }
 
 void EngineRepresentation::restartEngine(QProcess * jaspEngineProcess)
@@ -372,6 +535,16 @@ void EngineRepresentation::restartEngine(QProcess * jaspEngineProcess)
 		Log::log() << "EngineRepresentation::restartEngine says: Engine already has jaspEngine process!" << std::endl;
 	}
 
+	if(forkedEngineAlive())
+		Log::log() << "EngineRepresentation::restartEngine says: Engine already has a forked jaspEngine!" << std::endl;
+
+	killForkedEngine();
+
+	_loadedModules.clear();
+	_failedModules.clear();
+	_waitingModuleRequests = std::queue<Json::Value>();
+	_moduleInRequest = "";
+
 	sendString("");
 	setSlaveProcess(jaspEngineProcess);
 	_stopRequested	= false;
@@ -391,7 +564,7 @@ void EngineRepresentation::sendPauseEngine()
 
 	Log::log() << "informing engine that it ought to pause for a bit" << std::endl;
 
-	sendString(json.toStyledString());
+	sendString(fastJson::write(json));
 }
 
 void EngineRepresentation::resumeEngine()
@@ -406,7 +579,7 @@ void EngineRepresentation::resumeEngine()
 
 	Log::log() << "informing engine that it may resume" << std::endl;
 
-	sendString(json.toStyledString());
+	sendString(fastJson::write(json));
 }
 
 void EngineRepresentation::processEnginePausedReply()
@@ -433,25 +606,54 @@ void EngineRepresentation::processEngineStoppedReply()
 	_engineState = engineState::stopped;
 }
 
+void EngineRepresentation::unloadModule(const Json::Value & unloadRequest)
+{
+	const std::string moduleName = unloadRequest["moduleName"].asString();
+
+	if(!moduleLoaded(moduleName))
+		return;
+
+	forgetModule(moduleName);
+	_waitingModuleRequests.push(unloadRequest);
+}
+
+bool EngineRepresentation::runWaitingModuleRequest()
+{
+	if(!isIdle() || _waitingModuleRequests.empty())
+		return false;
+
+	runModuleRequestOnProcess(_waitingModuleRequests.front());
+	_waitingModuleRequests.pop();
+
+	return true;
+}
+
 void EngineRepresentation::runModuleRequestOnProcess(Json::Value request)
 {
 	_engineState			= engineState::moduleRequest;
+	_moduleInRequest		= request["moduleName"].asString();
 	request["typeRequest"]	= engineStateToString(_engineState);
 
-	sendString(request.toStyledString());
+	startRequest(request["moduleRequest"].asString() + " " + _moduleInRequest);
+	sendString(fastJson::write(request));
 }
 
 void EngineRepresentation::processModuleRequestReply(Json::Value & json)
 {
 	if(_engineState != engineState::moduleRequest)
 		throw std::runtime_error("Received an unexpected moduleRequest reply!");
-	_engineState = engineState::idle;
+	_engineState		= engineState::idle;
+	_moduleInRequest	= "";
+	finishRequest();
 
 	moduleStatus moduleRequest	= moduleStatusFromString(json["moduleRequest"].asString());
 	bool succes					= json["succes"].asBool();
 	QString moduleName			= QString::fromStdString(json["moduleName"].asString());
 	auto getError				= [&](){ return QString::fromStdString(json.get("error", "Unknown error").asString()); };
 
+	if(moduleRequest == moduleStatus::loadingNeeded)
+		(succes ? _loadedModules : _failedModules).insert(moduleName.toStdString());
+
 	switch(moduleRequest)
 	{
 	case moduleStatus::installNeeded:
@@ -505,7 +707,7 @@ void EngineRepresentation::sendLogCfg()
 	Json::Value msg		= Log::createLogCfgMsg();
 	msg["typeRequest"]	= engineStateToString(_engineState);
 
-	sendString(msg.toStyledString());
+	sendString(fastJson::write(msg));
 }
 
 void EngineRepresentation::processLogCfgReply()
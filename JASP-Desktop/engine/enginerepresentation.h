@@ -12,6 +12,7 @@
 #include "ipcchannel.h"
 #include "data/datasetpackage.h"
 #include <queue>
+#include <set>
 #include "enginedefinitions.h"
 #include "rscriptstore.h"
 #include "modules/dynamicmodules.h"
@@ -27,6 +28,8 @@ public:
 	void		clearAnalysisInProgress();
 	void		setAnalysisInProgress(Analysis* analysis);
 	Analysis *	analysisInProgress() const { return _analysisInProgress; }
+	qint64		msAnalysisInProgress() const;
+	void		preemptAnalysisInProgress();
 
 	bool isIdle() { return _engineState == engineState::idle; }
 
@@ -38,6 +41,13 @@ public:
 	void runAnalysisOnProcess(Analysis *analysis);
 	void runModuleRequestOnProcess(Json::Value request);
 
+	bool moduleLoaded(		const std::string & moduleName) const	{ return _loadedModules.count(moduleName) > 0;											}
+	bool moduleFailed(		const std::string & moduleName) const	{ return _failedModules.count(moduleName) > 0;											}
+	bool loadingModule(		const std::string & moduleName) const	{ return _engineState == engineState::moduleRequest && _moduleInRequest == moduleName;	}
+	void forgetModule(		const std::string & moduleName)			{ _loadedModules.erase(moduleName); _failedModules.erase(moduleName);					}
+	void unloadModule(		const Json::Value & unloadRequest);
+	bool runWaitingModuleRequest();
+
 	void stopEngine();
 	void pauseEngine();
 	void resumeEngine();
@@ -47,7 +57,13 @@ public:
 	bool resumed()		const { return _engineState != engineState::paused && _engineState != engineState::resuming;	}
 	bool stopped()		const { return _engineState == engineState::stopped;											}
 
-	bool jaspEngineStillRunning() { return  _slaveProcess != nullptr; }
+	bool jaspEngineStillRunning() { return  _slaveProcess != nullptr || forkedEngineAlive(); }
+
+	void setSlaveProcess(QProcess * slaveProcess);
+	void setForkedPID(long pid)			{ _forkedPID = pid; }
+	bool forkedEngineAlive() const;
+	bool forkedEngineDisappeared(bool zygoteRunning, bool & crashed); ///< True once when the forked engine is gone, crashed is then set like it would be for a QProcess: a signal or an exit code other than 0
+	long jaspEnginePID() const			{ return _forkedPID > 0 ? _forkedPID : _slaveProcess != nullptr ? long(_slaveProcess->processId()) : 0; }
 
 	void process();
 	void processRCodeReply(			Json::Value & json);
@@ -69,6 +85,10 @@ public:
 
 	int engineChannelID()							{ return _channel->channelNumber(); }
 
+	engineCounterValues	counters()		const		{ return _channel->counters()->values();	} ///< A copy, the jaspEngine keeps changing the original
+	size_t			ipcBytesSent()		const		{ return _channel->bytesSent();		}
+	size_t			ipcBytesReceived()	const		{ return _channel->bytesReceived();	}
+
 public slots:
 	void ppiChanged(int newPPI);
 	void imageBackgroundChanged(QString value);
@@ -95,24 +115,43 @@ signals:
 
 	void logCfgReplyReceived(int channelNr);
 
+	void requestStarted(				int channelNr, const QString & category, const QString & name, int analysisId);
+	void requestFinished(				int channelNr);
+
 private:
 	void sendPauseEngine();
 	void sendStopEngine();
 	void rerunRunningAnalysis();
 	void setChannel(IPCChannel * channel)			{ _channel = channel; }
-	void setSlaveProcess(QProcess * slaveProcess);
+	void killForkedEngine();
+	void logAnalysisInProgressResources();
+	void startRequest(const std::string & name, int analysisId = -1);
+	void finishRequest();
+	void processProgress(); ///< Reads the progress the jaspEngine left in shared memory, see engineprogress.h
+
+	static Json::Value resourceLimitsJson();
 
 private:
 	Analysis::Status analysisResultStatusToAnalysStatus(analysisResultStatus result, Analysis * analysis);
 
 	QProcess*	_slaveProcess		= nullptr;
+	long		_forkedPID			= 0; ///< Set when the jaspEngine was forked by the zygote instead of started as a QProcess
 	IPCChannel*	_channel			= nullptr;
 	Analysis*	_analysisInProgress = nullptr;
+	int			_abortedId			= -1,	///< The analysis last aborted or preempted here, the jaspEngine can still get a reply for it out before it notices
+				_abortedRevision	= -1;
+	qint64		_analysisStartedAt	= 0;
 	engineState	_engineState		= engineState::initializing;
 	int			_ppi				= 96;
 	QString		_imageBackground	= "white";
+	uint32_t	_progressSeen		= 0; ///< engineProgress::updates as it was the last time we looked
 	bool		_pauseRequested		= false,
 				_stopRequested		= false;
+
+	std::set<std::string>		_loadedModules,			///< Dynamic modules loaded in this jaspEngine, they are only loaded when an analysis needs them here
+								_failedModules;			///< Dynamic modules that failed to load in this jaspEngine, it won't be asked again until the module changes or the engine restarts
+	std::string					_moduleInRequest;
+	std::queue<Json::Value>		_waitingModuleRequests;
 };
 
 #endif // ENGINEREPRESENTATION_H
@@ -22,6 +22,7 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <algorithm>
 
 
 #include <boost/interprocess/shared_memory_object.hpp>
@@ -35,10 +36,18 @@
 #include "tempfiles.h"
 #include "timers.h"
 #include "utilities/appdirs.h"
+#include "utilities/settings.h"
 #include "log.h"
 
 using namespace boost::interprocess;
 
+const size_t initedAnalysesStartIndex =
+#ifndef JASP_DEBUG
+		1; // don't perform 'runs' on process 0, "only" inits & filters & rCode & columnComputes & moduleRequests.
+#else
+		0;
+#endif
+
 
 EngineSync::EngineSync(Analyses *analyses, DataSetPackage *package, DynamicModules *dynamicModules, QObject *parent = 0)
 	: QObject(parent), _analyses(analyses), _package(package), _dynamicModules(dynamicModules)
@@ -57,6 +66,10 @@ EngineSync::EngineSync(Analyses *analyses, DataSetPackage *package, DynamicModul
 	connect(_dynamicModules,	&DynamicModules::stopEngines,						this,					&EngineSync::stopEngines						);
 	connect(_dynamicModules,	&DynamicModules::restartEngines,					this,					&EngineSync::restartEngines						);
 
+	_performance = new EnginePerformance(_engines, this);
+	connect(_analyses,			&Analyses::analysisRemoved,							_performance,			&EnginePerformance::analysisRemoved				);
+	connect(_performance,		&EnginePerformance::tracingChanged,					this,					&EngineSync::logCfgRequest						);
+
 	// delay start so as not to increase program start up time
 	QTimer::singleShot(100, this, &EngineSync::deleteOrphanedTempFiles);
 }
@@ -66,6 +79,10 @@ EngineSync::~EngineSync()
 	if (_engineStarted)
 	{		
 		stopEngines();
+
+		if(_zygote != nullptr)
+			_zygote->stopZygote();
+
 		_engines.clear();
 		TempFiles::deleteAll();
 	}
@@ -86,9 +103,21 @@ void EngineSync::start(int ppi)
 #else
 		_engines.resize(4);
 #endif
+#ifdef __linux__
+		// The zygote uses the channel number after the last engine and forks the (already initialized) engines once it is up.
+		IPCChannel * zygoteChannel = new IPCChannel(_memoryName, _engines.size());
+		_zygote = new ZygoteRepresentation(zygoteChannel, startSlaveProcess(int(_engines.size()), true), this);
+
+		connect(_zygote,	&ZygoteRepresentation::engineForked,	this,	&EngineSync::engineForkedByZygote	);
+		connect(_zygote,	&ZygoteRepresentation::forkFailed,		this,	&EngineSync::zygoteForkFailed		);
+
+		preloadPackagesInZygote();
+#endif
+
 		for(size_t i=0; i<_engines.size(); i++)
 		{
-			_engines[i] = new EngineRepresentation(new IPCChannel(_memoryName, i), startSlaveProcess(i), this);
+			IPCChannel * channel	= new IPCChannel(_memoryName, i);
+			_engines[i]				= new EngineRepresentation(channel, _zygote != nullptr ? nullptr : startSlaveProcess(i), this);
 
 			connect(_engines[i],	&EngineRepresentation::rCodeReturned,					_analyses,		&Analyses::rCodeReturned												);
 			connect(_engines[i],	&EngineRepresentation::engineTerminated,				this,			&EngineSync::engineTerminated											);
@@ -103,12 +132,18 @@ void EngineSync::start(int ppi)
 			connect(_engines[i],	&EngineRepresentation::moduleUnloadingFinished,			this,			&EngineSync::moduleUnloadingFinishedHandler								);
 			connect(_engines[i],	&EngineRepresentation::moduleUninstallingFinished,		this,			&EngineSync::moduleUninstallingFinished									);
 			connect(_engines[i],	&EngineRepresentation::logCfgReplyReceived,				this,			&EngineSync::logCfgReplyReceived										);
+			connect(_engines[i],	&EngineRepresentation::requestStarted,					_performance,	&EnginePerformance::requestStarted										);
+			connect(_engines[i],	&EngineRepresentation::requestFinished,					_performance,	&EnginePerformance::requestFinished										);
 			connect(this,			&EngineSync::ppiChanged,								this,			&EngineSync::refreshAllPlots,					Qt::QueuedConnection	);
 			connect(this,			&EngineSync::ppiChanged,								_engines[i],	&EngineRepresentation::ppiChanged										);
 			connect(this,			&EngineSync::imageBackgroundChanged,					_engines[i],	&EngineRepresentation::imageBackgroundChanged							);
 			connect(_analyses,		&Analyses::analysisRemoved,								_engines[i],	&EngineRepresentation::analysisRemoved									);
 
 		}
+
+		if(_zygote != nullptr)
+			for(size_t i=0; i<_engines.size(); i++)
+				_zygote->requestEngine(i);
 	}
 	catch (interprocess_exception e)
 	{
@@ -119,7 +154,7 @@ void EngineSync::start(int ppi)
 	QTimer *timerProcess = new QTimer(this), *timerBeat = new QTimer(this);
 
 	connect(timerProcess,	&QTimer::timeout, this, &EngineSync::process);
-	connect(timerBeat,		&QTimer::timeout, this, &EngineSync::heartbeatTempFiles);
+	connect(timerBeat,		&QTimer::timeout, this, &EngineSync::heartbeat);
 
 	timerProcess->start(50);
 	timerBeat->start(30000);
@@ -136,20 +171,62 @@ void EngineSync::restartEngines()
 
 	for(size_t i=0; i<_engines.size(); i++)
 	{
-		_engines[i]->restartEngine(startSlaveProcess(i));
-		Log::log() << "restarted engine " << i << " but should still reload any active (dynamic) modules!"<< std::endl;
+		if(_zygote != nullptr)
+		{
+			_engines[i]->restartEngine(nullptr);
+			_zygote->requestEngine(i);
+		}
+		else
+			_engines[i]->restartEngine(startSlaveProcess(i));
+
+		Log::log() << "restarted engine " << i << std::endl;
 	}
 
-	setModuleWideCastVars(_dynamicModules->getJsonForReloadingActiveModules());
+	//Active modules get loaded again once an analysis needs them, but a module that was still being tried out needs another go.
+	std::set<std::string> interruptedLoads = _modulesFirstLoading;
+	_modulesFirstLoading.clear();
+
+	for(const std::string & moduleName : interruptedLoads)
+		_dynamicModules->registerForLoading(moduleName);
+
 	logCfgRequest();
 
 	_engineStarted = true;
 }
 
+void EngineSync::engineForkedByZygote(size_t slaveNo, long pid)
+{
+	Log::log() << "Engine " << slaveNo << " was forked by the zygote and has PID " << pid << std::endl;
+
+	_engines[slaveNo]->setForkedPID(pid);
+}
+
+void EngineSync::zygoteForkFailed(size_t slaveNo)
+{
+	Log::log() << "Zygote could not fork engine " << slaveNo << ", starting a jaspEngine process for it instead." << std::endl;
+
+	_engines[slaveNo]->setSlaveProcess(startSlaveProcess(int(slaveNo)));
+}
+
 void EngineSync::process()
 {
+	if(_zygote != nullptr)
+		_zygote->process();
+
+	bool zygoteRunning = _zygote != nullptr && _zygote->running();
+
 	for (auto engine : _engines)
+	{
 		engine->process();
+
+		bool crashed = false;
+
+		if(engine->forkedEngineDisappeared(zygoteRunning, crashed) && crashed && _engineStarted) //The same as subprocessFinished does for a QProcess
+		{
+			Log::log() << "forked engine " << engine->channelNumber() << " stopped unexpectedly" << std::endl;
+			emit engineTerminated();
+		}
+	}
 	
 	processLogCfgRequests();
 	processScriptQueue();
@@ -224,20 +301,46 @@ void EngineSync::processScriptQueue()
 
 void EngineSync::processDynamicModules()
 {
-	if(!amICastingAModuleRequestWide() && (_dynamicModules->aModuleNeedsToBeLoadedInR() || _dynamicModules->aModuleNeedsToBeUnloadedFromR()))
+	//Unloading is only needed on the engines that actually loaded the module
+	while(_dynamicModules->aModuleNeedsToBeUnloadedFromR())
 	{
-		if(_dynamicModules->aModuleNeedsToBeLoadedInR())			setModuleWideCastVars(_dynamicModules->getJsonForPackageLoadingRequest());
-		else if(_dynamicModules->aModuleNeedsToBeUnloadedFromR())	setModuleWideCastVars(_dynamicModules->getJsonForPackageUnloadingRequest());
+		Json::Value unloadRequest = _dynamicModules->getJsonForPackageUnloadingRequest();
+
+		_modulesFirstLoading.erase(unloadRequest["moduleName"].asString());
+
+		for(auto engine : _engines)
+			engine->unloadModule(unloadRequest);
 	}
 
+	for(auto engine : _engines)
+		engine->runWaitingModuleRequest();
+
 	for(auto engine : _engines)
 		if(engine->isIdle())
 		{
-			if		(_dynamicModules->aModuleNeedsPackagesInstalled())															engine->runModuleRequestOnProcess(_dynamicModules->getJsonForPackageInstallationRequest());
-			else if	(!_requestWideCastModuleJson.isNull() && _requestWideCastModuleResults.count(engine->channelNumber()) == 0)	engine->runModuleRequestOnProcess(_requestWideCastModuleJson);
+			if		(_dynamicModules->aModuleNeedsPackagesInstalled())	engine->runModuleRequestOnProcess(_dynamicModules->getJsonForPackageInstallationRequest());
+			else if	(_dynamicModules->aModuleNeedsToBeLoadedInR())
+			{
+				Json::Value loadRequest = _dynamicModules->getJsonForPackageLoadingRequest();
+				std::string moduleName	= loadRequest["moduleName"].asString();
+
+				for(auto other : _engines)
+					other->forgetModule(moduleName); //Could be a new version, so whoever had it loaded will have to load it again
+
+				_modulesFirstLoading.insert(moduleName);
+				engine->runModuleRequestOnProcess(loadRequest);
+			}
 		}
 }
 
+bool EngineSync::moduleBeingLoaded(const std::string & moduleName)
+{
+	for(auto engine : _engines)
+		if(engine->loadingModule(moduleName))
+			return true;
+	return false;
+}
+
 bool EngineSync::idleEngineAvailable()
 {
 	for(auto engine : _engines)
@@ -247,43 +350,123 @@ bool EngineSync::idleEngineAvailable()
 }
 
 void EngineSync::ProcessAnalysisRequests()
-{	
-	const size_t initedAnalysesStartIndex =
-#ifndef JASP_DEBUG
-			1; // don't perform 'runs' on process 0, "only" inits & filters & rCode & columnComputes & moduleRequests.
-#else
-			0;
-#endif
-
+{
 	for(auto engine : _engines)
 		engine->handleRunningAnalysisStatusChanges();
 
-	_analyses->applyToSome([&](Analysis * analysis)
+	// Gather everything that wants an engine and order it by priority, the stable sort keeps the order of the results within a priority.
+	std::vector<Analysis*> waiting;
+
+	_analyses->applyToAll([&](Analysis * analysis)
 	{
-		if(!idleEngineAvailable())
-			return false;
+		if (analysis == nullptr)
+			return;
 
-		if (analysis == nullptr || analysis->isWaitingForModule())
-			return true;
+		bool wantsEngine = analysis->isEmpty() || analysis->isSaveImg() || analysis->isEditImg() || analysis->isRewriteImgs() || analysis->isInited();
 
-		bool canUseFirstEngine	= analysis->isEmpty()	|| analysis->isSaveImg() || analysis->isEditImg() || analysis->isRewriteImgs();
-		bool needsToRun			= canUseFirstEngine		|| analysis->isInited();
+		// If no engine can load the module the analysis would wait for it forever, so it gets the error of loading it instead.
+		if (wantsEngine && analysis->dynamicModule() != nullptr && (analysis->dynamicModule()->error() || !moduleLoadableSomewhere(analysis->dynamicModule()->name())))
+		{
+			std::string moduleName = analysis->dynamicModule()->name();
 
-		if(needsToRun)
-			for (size_t i = canUseFirstEngine ? 0 : initedAnalysesStartIndex; i<_engines.size(); i++)
-				if (_engines[i]->isIdle())
-				{
-					_engines[i]->runAnalysisOnProcess(analysis);
-					break;
-				}
+			analysis->setFatalError(_moduleLoadErrors.count(moduleName) > 0 ? _moduleLoadErrors[moduleName] : "Module " + moduleName + " could not be loaded.");
+			return;
+		}
 
-		return true;
+		if (analysis->isWaitingForModule())
+			return;
+
+		if(wantsEngine)
+		{
+			waiting.push_back(analysis);
+			_performance->analysisWaiting(analysis->id());
+		}
 	});
 
+	std::stable_sort(waiting.begin(), waiting.end(), [&](Analysis * l, Analysis * r) { return _analyses->runPriority(l) < _analyses->runPriority(r); });
+
+	bool preemptedOne = false;
+
+	for(Analysis * analysis : waiting)
+	{
+		bool		canUseFirstEngine	= analysis->isEmpty()	|| analysis->isSaveImg() || analysis->isEditImg() || analysis->isRewriteImgs();
+		size_t		firstEngine			= canUseFirstEngine ? 0 : initedAnalysesStartIndex;
+		std::string	moduleName			= analysis->dynamicModule() == nullptr ? "" : analysis->dynamicModule()->name();
+
+		// Prefer an idle engine that already has the module of this analysis loaded, otherwise load it into one.
+		EngineRepresentation	* idleWithModule	= nullptr,
+								* idleWithout		= nullptr;
+
+		for (size_t i = firstEngine; i<_engines.size() && idleWithModule == nullptr; i++)
+			if (_engines[i]->isIdle())
+			{
+				if(moduleName == "" || _engines[i]->moduleLoaded(moduleName))						idleWithModule	= _engines[i];
+				else if(idleWithout == nullptr && !_engines[i]->moduleFailed(moduleName))			idleWithout		= _engines[i];
+			}
+
+		if(idleWithModule != nullptr)
+		{
+			idleWithModule->runAnalysisOnProcess(analysis);
+			continue;
+		}
+
+		if(idleWithout != nullptr)
+		{
+			if(!moduleBeingLoaded(moduleName)) //One engine loading it at a time is enough, the analysis will just wait for it
+				idleWithout->runModuleRequestOnProcess(_dynamicModules->getJsonForLoadingOnEngine(moduleName));
+			continue;
+		}
+
+		// No engine free for this one, if it is urgent we might make room by preempting a long running background analysis (only one per pass though).
+		if(!preemptedOne && _analyses->runPriority(analysis) != Analyses::Background)
+		{
+			EngineRepresentation * preemptThis = preemptableEngine(firstEngine, moduleName);
+
+			if(preemptThis != nullptr)
+			{
+				preemptThis->preemptAnalysisInProgress();
+				preemptThis->runAnalysisOnProcess(analysis);
+				preemptedOne = true;
+				continue;
+			}
+		}
+
+		if(!idleEngineAvailable() && (preemptedOne || _analyses->runPriority(analysis) == Analyses::Background))
+			return;
+	}
+}
+
+EngineRepresentation * EngineSync::preemptableEngine(size_t firstEngine, const std::string & moduleName)
+{
+	EngineRepresentation	*	longestRunning	= nullptr;
+	const qint64				preemptAfterMs	= Settings::value(Settings::ANALYSIS_PREEMPT_AFTER_MS).toLongLong();
+
+	for (size_t i = firstEngine; i<_engines.size(); i++)
+	{
+		Analysis * inProgress = _engines[i]->analysisInProgress();
+
+		if(inProgress == nullptr || _analyses->runPriority(inProgress) != Analyses::Background)
+			continue;
+
+		// The preempting analysis is sent straight away, so there is no time to load its module first.
+		if(moduleName != "" && !_engines[i]->moduleLoaded(moduleName))
+			continue;
 
+		// Image requests are short and the user is waiting for them, so only real runs are fair game.
+		if(inProgress->status() != Analysis::Running && inProgress->status() != Analysis::Initing)
+			continue;
+
+		if(_engines[i]->msAnalysisInProgress() < preemptAfterMs)
+			continue;
+
+		if(longestRunning == nullptr || _engines[i]->msAnalysisInProgress() > longestRunning->msAnalysisInProgress())
+			longestRunning = _engines[i];
+	}
+
+	return longestRunning;
 }
 
-QProcess * EngineSync::startSlaveProcess(int no)
+QProcess * EngineSync::startSlaveProcess(int no, bool asZygote)
 {
 	QDir programDir			= QFileInfo( QCoreApplication::applicationFilePath() ).absoluteDir();
 	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
@@ -292,6 +475,9 @@ QProcess * EngineSync::startSlaveProcess(int no)
 	QStringList args;
 	args << QString::number(no) << QString::number(ProcessInfo::currentPID()) << QString::fromStdString(Log::logFileNameBase) << QString::fromStdString(Log::whereStr());
 
+	if(asZygote)
+		args << "zygote";
+
 	env.insert("TMPDIR", tq(TempFiles::createTmpFolder()));
 
 #ifdef _WIN32
@@ -388,9 +574,12 @@ QProcess * EngineSync::startSlaveProcess(int no)
 	});
 #endif
 
-	connect(slave, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),	this,	&EngineSync::subprocessFinished);
-	connect(slave, &QProcess::started,												this,	&EngineSync::subProcessStarted);
-	connect(slave, &QProcess::errorOccurred,										this,	&EngineSync::subProcessError);
+	if(!asZygote) //ZygoteRepresentation handles these itself, without it everything still works, so it is not fatal.
+	{
+		connect(slave, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),	this,	&EngineSync::subprocessFinished);
+		connect(slave, &QProcess::started,												this,	&EngineSync::subProcessStarted);
+		connect(slave, &QProcess::errorOccurred,										this,	&EngineSync::subProcessError);
+	}
 
 	slave->start(engineExe, args);
 
@@ -402,9 +591,107 @@ void EngineSync::deleteOrphanedTempFiles()
 	TempFiles::deleteOrphans();
 }
 
-void EngineSync::heartbeatTempFiles()
+void EngineSync::heartbeat()
 {
 	TempFiles::heartbeat();
+	logMemoryUsage();
+}
+
+void EngineSync::preloadPackagesInZygote()
+{
+	//The packages installed modules need are shared as well, the modules themselves are not as they can be reinstalled or unloaded while the zygote stays up.
+	Json::Value packages = Json::arrayValue,
+				libPaths = Json::arrayValue;
+
+	for(const std::string & moduleName : _dynamicModules->moduleNames())
+	{
+		Modules::DynamicModule * dynMod = _dynamicModules->dynamicModule(moduleName);
+
+		if(dynMod == nullptr || !dynMod->installed())
+			continue;
+
+		libPaths.append(dynMod->moduleRLibrary().toStdString());
+
+		for(const Json::Value & pkgV : dynMod->requiredPackages())
+			packages.append(pkgV.isString() ? pkgV.asString() : pkgV.get("package", "").asString());
+	}
+
+	_zygote->preloadPackages(packages, libPaths);
+}
+
+Json::Value EngineSync::memoryUsage() const
+{
+	auto memoryJson = [](long pid)
+	{
+		processMemory	memory;
+		Json::Value		json = Json::objectValue;
+
+		if(pid <= 0 || !ProcessInfo::memoryUsage(pid, memory))
+			return json;
+
+		json["pid"]		= int(pid);
+		json["rss"]		= Json::UInt(memory.rss);
+		json["pss"]		= Json::UInt(memory.pss);
+		json["shared"]	= Json::UInt(memory.sharedMemory);
+		json["private"]	= Json::UInt(memory.privateMemory);
+
+		return json;
+	};
+
+	Json::Value usage	= Json::objectValue;
+	usage["engines"]	= Json::arrayValue;
+
+	for(EngineRepresentation * engine : _engines)
+	{
+		Json::Value engineMemory	= memoryJson(engine->jaspEnginePID());
+		engineMemory["channel"]		= int(engine->channelNumber());
+
+		usage["engines"].append(engineMemory);
+	}
+
+	if(_zygote != nullptr)
+		usage["zygote"] = memoryJson(_zygote->pid());
+
+	return usage;
+}
+
+void EngineSync::logMemoryUsage()
+{
+	Json::Value		usage		= memoryUsage();
+	Json::UInt		totalRss	= 0,
+					totalPss	= 0;
+	std::set<long>	pids;
+
+	for(const Json::Value & engine : usage["engines"])
+		if(engine.isMember("rss"))
+		{
+			totalRss += engine["rss"].asUInt();
+			totalPss += engine["pss"].asUInt();
+			pids.insert(engine["pid"].asInt());
+		}
+
+	//Only when engines came or went or together grew or shrank by more than a tenth since last time, otherwise the log fills up with the same numbers every heartbeat
+	Json::UInt difference = totalRss > _memoryLoggedRss ? totalRss - _memoryLoggedRss : _memoryLoggedRss - totalRss;
+
+	if(pids == _memoryLoggedPids && difference <= _memoryLoggedRss / 10)
+		return;
+
+	_memoryLoggedPids	= pids;
+	_memoryLoggedRss	= totalRss;
+
+	for(const Json::Value & engine : usage["engines"])
+	{
+		if(!engine.isMember("rss"))
+			continue;
+
+		Log::log() << "jaspEngine " << engine["channel"].asInt() << " (PID " << engine["pid"].asInt() << ") uses " << engine["rss"].asUInt() / 1024 << "MB rss of which " << engine["shared"].asUInt() / 1024 << "MB shared and " << engine["private"].asUInt() / 1024 << "MB private" << std::endl;
+	}
+
+	if(usage.isMember("zygote") && usage["zygote"].isMember("rss"))
+		Log::log() << "jaspEngine zygote uses " << usage["zygote"]["rss"].asUInt() / 1024 << "MB rss" << std::endl;
+
+	if(totalRss > 0)
+		Log::log() << "All jaspEngines together use " << totalRss / 1024 << "MB rss and " << totalPss / 1024 << "MB pss (what they would cost without counting the shared pages twice)" << std::endl;
 }
 
 void EngineSync::subProcessStarted()
@@ -546,80 +833,45 @@ void EngineSync::moduleLoadingFailedHandler(const QString & moduleName, const QS
 {
 	Log::log() << "Received EngineSync::moduleLoadingFailedHandler(" << moduleName.toStdString() << ", " << errorMessage.toStdString() << ", " << channelID << ")" << std::endl;
 
-	if(_requestWideCastModuleName != moduleName.toStdString())
-		throw std::runtime_error("Unexpected module received in EngineSync::moduleLoadingFailed, expected: " + _requestWideCastModuleName + ", but got: " + moduleName.toStdString());
-
-	_requestWideCastModuleResults[channelID] = errorMessage.size() == 0 ? "error" : errorMessage.toStdString();
-
-	checkModuleWideCastDone();
-}
+	//If the first try fails the module itself is broken, otherwise it only is when no engine that could run its analyses manages to load it.
+	bool firstLoad = _modulesFirstLoading.erase(moduleName.toStdString()) > 0;
 
-void EngineSync::moduleLoadingSucceededHandler(const QString & moduleName, int channelID)
-{
-	Log::log() << "Received EngineSync::moduleLoadingSucceededHandler(" << moduleName.toStdString() << ", " << channelID << ")" << std::endl;
+	if(!firstLoad && moduleLoadableSomewhere(moduleName.toStdString()))
+	{
+		Log::log() << "Module " << moduleName.toStdString() << " failed to load in engine " << channelID << " only, another engine will try it when an analysis needs it." << std::endl;
+		return;
+	}
 
-	if(_requestWideCastModuleName != moduleName.toStdString())
-		throw std::runtime_error("Unexpected module received in EngineSync::moduleLoadingSucceeded, expected: " + _requestWideCastModuleName + ", but got: " + moduleName.toStdString());
+	QString error = "engine " + QString::number(channelID) + " reported error: " + (errorMessage.size() == 0 ? QString("error") : errorMessage);
 
-	_requestWideCastModuleResults[channelID] = "succes";
+	_moduleLoadErrors[moduleName.toStdString()] = "Loading the packages of Module " + moduleName.toStdString() + " failed with the following errormessage:\n" + error.toStdString();
 
-	checkModuleWideCastDone();
+	emit moduleLoadingFailed(moduleName, error);
 }
 
-void EngineSync::moduleUnloadingFinishedHandler(const QString & moduleName, int channelID)
+bool EngineSync::moduleLoadableSomewhere(const std::string & moduleName)
 {
-	Log::log() << "Received EngineSync::moduleUnloadingFinishedHandler(" << moduleName.toStdString() << ", " << channelID << ")" << std::endl;
-
-	if(_requestWideCastModuleName != moduleName.toStdString())
-		throw std::runtime_error("Unexpected module received in EngineSync::moduleUnloadingFinishedHandler, expected: " + _requestWideCastModuleName + ", but got: " + moduleName.toStdString());
-
-	_requestWideCastModuleResults[channelID] = "I am an inconsequential message";
-
-	checkModuleWideCastDone();
+	for (size_t i = initedAnalysesStartIndex; i<_engines.size(); i++)
+		if(!_engines[i]->moduleFailed(moduleName))
+			return true;
+	return false;
 }
 
-
-void EngineSync::checkModuleWideCastDone()
+void EngineSync::moduleLoadingSucceededHandler(const QString & moduleName, int channelID)
 {
-	if(!_requestWideCastModuleJson.isNull() && _requestWideCastModuleResults.size() == _engines.size())
-	{
-		if(moduleStatusFromString(_requestWideCastModuleJson["moduleRequest"].asString()) == moduleStatus::loadingNeeded)
-		{
-			std::string compoundedError = "";
-			int failed = 0;
-
-			for(auto * engine : _engines)
-			{
-				auto res = _requestWideCastModuleResults[engine->channelNumber()];
-				if(res != "succes")
-				{
-					failed ++;
-					compoundedError += std::string(compoundedError != "" ? "\n" : "") + "engine " + std::to_string(engine->channelNumber()) + " reported error: " + res;
-				}
-			}
-
+	Log::log() << "Received EngineSync::moduleLoadingSucceededHandler(" << moduleName.toStdString() << ", " << channelID << ")" << std::endl;
 
-			if(failed == 0)	emit moduleLoadingSucceeded(QString::fromStdString(_requestWideCastModuleName));
-			else			emit moduleLoadingFailed(QString::fromStdString(_requestWideCastModuleName), QString::fromStdString(compoundedError));
-		}
+	_moduleLoadErrors.erase(moduleName.toStdString());
 
-		resetModuleWideCastVars();
-	}
+	if(_modulesFirstLoading.erase(moduleName.toStdString()) > 0)
+		emit moduleLoadingSucceeded(moduleName);
+	else if(_dynamicModules->dynamicModule(moduleName.toStdString()) != nullptr && !_dynamicModules->dynamicModule(moduleName.toStdString())->loaded())
+		_dynamicModules->dynamicModule(moduleName.toStdString())->setLoaded(true); //After a restart nothing is loaded until an analysis needs it, but a reinstall must know it is in R again. Only the first engine to load it changes that.
 }
 
-void EngineSync::resetModuleWideCastVars()
-{
-	_requestWideCastModuleName			= "";
-	_requestWideCastModuleJson			= Json::nullValue;
-	_requestWideCastModuleResults.clear();
-}
-
-void EngineSync::setModuleWideCastVars(Json::Value newVars)
+void EngineSync::moduleUnloadingFinishedHandler(const QString & moduleName, int channelID)
 {
-	resetModuleWideCastVars();
-
-	_requestWideCastModuleName			= newVars["moduleName"].asString();
-	_requestWideCastModuleJson			= newVars;
+	Log::log() << "Received EngineSync::moduleUnloadingFinishedHandler(" << moduleName.toStdString() << ", " << channelID << ")" << std::endl;
 }
 
 void EngineSync::refreshAllPlots(int)
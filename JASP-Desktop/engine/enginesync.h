@@ -28,6 +28,8 @@
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 
 #include "enginerepresentation.h"
+#include "zygoterepresentation.h"
+#include "engineperformance.h"
 
 /* EngineSync is responsible for launching the background
  * processes, scheduling analyses, and for sending and
@@ -47,6 +49,12 @@ public:
 	bool engineStarted()			{ return _engineStarted; }
 	bool allEnginesInitializing();
 
+	///Rss, pss, shared and private memory in kB per jaspEngine and of the zygote, to see how much the engines actually share and how many of them fit.
+	Json::Value	memoryUsage() const;
+	void		logMemoryUsage();
+
+	EnginePerformance * performance() const { return _performance; }
+
 public slots:
 	void sendFilter(	const QString & generatedFilter,	const QString & filter,			int requestID);
 	void sendRCode(		const QString & rCode,				int requestId);
@@ -82,22 +90,22 @@ signals:
 
 private:
 	bool		idleEngineAvailable();
+	EngineRepresentation*	preemptableEngine(size_t firstEngine, const std::string & moduleName);
+	bool		moduleBeingLoaded(const std::string & moduleName);
+	bool		moduleLoadableSomewhere(const std::string & moduleName);
 	bool		allEnginesStopped();
 	bool		allEnginesPaused();
 	bool		allEnginesResumed();
-	QProcess*	startSlaveProcess(int no);
+	QProcess*	startSlaveProcess(int no, bool asZygote = false);
 	void		processScriptQueue();
 	void		processLogCfgRequests();
 	void		processDynamicModules();
-	void		checkModuleWideCastDone();
-	void		resetModuleWideCastVars();
-	void		setModuleWideCastVars(Json::Value newVars);
-	bool		amICastingAModuleRequestWide()	{ return !_requestWideCastModuleJson.isNull(); }
+	void		preloadPackagesInZygote();
 
 private slots:
 	void ProcessAnalysisRequests();
 	void deleteOrphanedTempFiles();
-	void heartbeatTempFiles();
+	void heartbeat();
 
 	void process();
 
@@ -111,6 +119,9 @@ private slots:
 
 	void restartEngines();
 
+	void engineForkedByZygote(size_t slaveNo, long pid);
+	void zygoteForkFailed(size_t slaveNo);
+
 	void logCfgReplyReceived(size_t channelNr);
 
 private:
@@ -122,14 +133,18 @@ private:
 	std::queue<RScriptStore*>			_waitingScripts;
 	std::vector<EngineRepresentation*>	_engines;
 	RFilterStore						*_waitingFilter = nullptr;
+	ZygoteRepresentation				*_zygote		= nullptr;
+	EnginePerformance					*_performance	= nullptr;
 
 	std::string _memoryName,
 				_engineInfo;
 
-	std::string					_requestWideCastModuleName		= "";
-	Json::Value					_requestWideCastModuleJson		= Json::nullValue;
-	std::map<int, std::string>	_requestWideCastModuleResults;
+	std::set<std::string>		_modulesFirstLoading			= {}; ///< Modules loaded in a single engine to see whether they work, other engines load them when an analysis needs it.
+	std::map<std::string, std::string>	_moduleLoadErrors		= {}; ///< Why a module could not be loaded, shown in the analyses that then cannot run.
 	std::set<size_t>			_logCfgRequested				= {};
+	std::set<long>				_memoryLoggedPids				= {};
+	unsigned					_memoryLoggedRss				= 0;	///< Total rss in kB of the jaspEngines when logMemoryUsage last wrote it down
+
 };
 
 #endif // ENGINESYNC_H
@@ -0,0 +1,175 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#include "zygoterepresentation.h"
+#include "log.h"
+#include "fastjson.h"
+#include <stdexcept>
+
+ZygoteRepresentation::ZygoteRepresentation(IPCChannel * channel, QProcess * zygoteProcess, QObject * parent)
+	: QObject(parent), _channel(channel), _zygoteProcess(zygoteProcess)
+{
+	_zygoteProcess->setParent(this);
+
+	connect(_zygoteProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),	this,	&ZygoteRepresentation::zygoteProcessFinished);
+	connect(_zygoteProcess, &QProcess::errorOccurred,										this,	&ZygoteRepresentation::zygoteProcessError);
+}
+
+ZygoteRepresentation::~ZygoteRepresentation()
+{
+	if(_zygoteProcess != nullptr)
+	{
+		_zygoteProcess->terminate();
+		_zygoteProcess->kill();
+	}
+
+	delete _channel;
+	_channel = nullptr;
+}
+
+void ZygoteRepresentation::requestEngine(size_t slaveNo)
+{
+	if(!running())
+	{
+		emit forkFailed(slaveNo);
+		return;
+	}
+
+	_requests.push(slaveNo);
+	sendNextRequest();
+}
+
+void ZygoteRepresentation::preloadPackages(const Json::Value & packages, const Json::Value & libPaths)
+{
+	if(!running())
+		return;
+
+	_preloadRequest					= Json::objectValue;
+	_preloadRequest["typeRequest"]	= zygoteRequestToString(zygoteRequest::preloadPackages);
+	_preloadRequest["packages"]		= packages;
+	_preloadRequest["libPaths"]		= libPaths;
+
+	sendNextRequest();
+}
+
+void ZygoteRepresentation::sendNextRequest()
+{
+	if(_waitingForReply)
+		return;
+
+	if(!_preloadRequest.isNull())
+	{
+		_waitingForReply = true;
+		_channel->send(fastJson::write(_preloadRequest));
+		_preloadRequest = Json::nullValue;
+
+		return;
+	}
+
+	if(_requests.size() == 0)
+		return;
+
+	Json::Value json		= Json::objectValue;
+	json["typeRequest"]		= zygoteRequestToString(zygoteRequest::forkEngine);
+	json["slaveNo"]			= int(_requests.front());
+
+	_waitingForReply		= true;
+
+	_channel->send(fastJson::write(json));
+}
+
+void ZygoteRepresentation::process()
+{
+	std::string data;
+
+	if (!_waitingForReply || !_channel->receive(data))
+		return;
+
+	Json::Value json;
+
+	if(!fastJson::parse(data, json))
+		throw std::runtime_error("Malformed reply from jaspEngine zygote!");
+
+	if(json.get("typeRequest", "").asString() == zygoteRequestToString(zygoteRequest::preloadPackages))
+	{
+		Log::log() << "jaspEngine zygote preloaded: " << json.get("loaded", "").asString() << std::endl;
+
+		_waitingForReply = false;
+		sendNextRequest();
+
+		return;
+	}
+
+	size_t	slaveNo = size_t(json.get("slaveNo", -1).asInt());
+	long	pid		= json.get("pid", -1).asInt();
+
+	_waitingForReply = false;
+
+	if(_requests.size() > 0 && _requests.front() == slaveNo)
+		_requests.pop();
+
+	if(pid > 0)	emit engineForked(slaveNo, pid);
+	else		emit forkFailed(slaveNo);
+
+	sendNextRequest();
+}
+
+void ZygoteRepresentation::stopZygote()
+{
+	if(!running())
+		return;
+
+	Json::Value json		= Json::objectValue;
+	json["typeRequest"]		= zygoteRequestToString(zygoteRequest::stopRequested);
+
+	Log::log() << "informing zygote that it ought to stop" << std::endl;
+
+	_channel->send(fastJson::write(json));
+}
+
+void ZygoteRepresentation::failAllRequests()
+{
+	_waitingForReply = false;
+
+	while(_requests.size() > 0)
+	{
+		size_t slaveNo = _requests.front();
+		_requests.pop();
+
+		emit forkFailed(slaveNo);
+	}
+}
+
+void ZygoteRepresentation::zygoteProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+	Log::log() << "jaspEngine zygote finished with exitCode " << exitCode << (exitStatus == QProcess::CrashExit ? " after a crash" : "") << std::endl;
+
+	_zygoteProcess = nullptr;
+	failAllRequests();
+}
+
+void ZygoteRepresentation::zygoteProcessError(QProcess::ProcessError error)
+{
+	Log::log() << "jaspEngine zygote error: " << error << std::endl;
+
+	if(error == QProcess::FailedToStart)
+	{
+		_zygoteProcess = nullptr;
+		failAllRequests();
+	}
+}
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ZYGOTEREPRESENTATION_H
+#define ZYGOTEREPRESENTATION_H
+
+#include <QObject>
+#include <QProcess>
+#include <queue>
+
+#include "ipcchannel.h"
+#include "jsonredirect.h"
+#include "enginedefinitions.h"
+
+/* ZygoteRepresentation is the desktop side of the jaspEngine zygote (Linux only).
+ * The zygote has R and the JASP packages loaded and fork()s an Engine for a slot whenever requestEngine is called.
+ * Only one request can be underway at a time, the rest waits in _requests. A preloadPackages request always goes first, so the engines forked after it share those packages.
+ * If the zygote is not (or no longer) available every request is answered with forkFailed, so EngineSync can fall back to a normal jaspEngine process.
+ */
+class ZygoteRepresentation : public QObject
+{
+	Q_OBJECT
+
+public:
+	ZygoteRepresentation(IPCChannel * channel, QProcess * zygoteProcess, QObject * parent = nullptr);
+	~ZygoteRepresentation();
+
+	void requestEngine(size_t slaveNo);
+	void preloadPackages(const Json::Value & packages, const Json::Value & libPaths);
+	void stopZygote();
+	void process();
+
+	bool running()	const { return _zygoteProcess != nullptr; }
+	long pid()		const { return running() ? long(_zygoteProcess->processId()) : 0; }
+
+signals:
+	void engineForked(size_t slaveNo, long pid);
+	void forkFailed(size_t slaveNo);
+
+private slots:
+	void zygoteProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+	void zygoteProcessError(QProcess::ProcessError error);
+
+private:
+	void sendNextRequest();
+	void failAllRequests();
+
+private:
+	IPCChannel			*	_channel			= nullptr;
+	QProcess			*	_zygoteProcess		= nullptr;
+	std::queue<size_t>		_requests;
+	Json::Value				_preloadRequest		= Json::nullValue;
+	bool					_waitingForReply	= false;
+};
+
+#endif // ZYGOTEREPRESENTATION_H
@@ -2,6 +2,8 @@
 #include "mainwindow.h"
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QApplication>
+#include <iostream>
 
 MessageForwarder::MessageForwarder(MainWindow *main) : QObject(main), _main(main)
 {
@@ -15,19 +17,48 @@ MessageForwarder::MessageForwarder(MainWindow *main) : QObject(main), _main(main
 
 MessageForwarder * MessageForwarder::singleton = nullptr;
 
+///Without a QApplication, as in --batch, there are no widgets to show, so the questions get their safe answer and the warnings go to stderr.
+bool MessageForwarder::headless()
+{
+	return qobject_cast<QApplication*>(QCoreApplication::instance()) == nullptr;
+}
+
+void MessageForwarder::logHeadless(QString title, QString message)
+{
+	std::cerr << (title == "" ? "" : title.toStdString() + ": ") << message.toStdString() << std::endl;
+}
+
 void MessageForwarder::showWarning(QString title, QString message)
 {
+	if(headless())
+	{
+		logHeadless(title, message);
+		return;
+	}
+
 	//emit singleton->showWarningSignal(title, message);
 	QMessageBox::warning(nullptr, title, message);
 }
 
 bool MessageForwarder::showYesNo(QString title, QString message)
 {
+	if(headless())
+	{
+		logHeadless(title, message + " (answered no)");
+		return false;
+	}
+
 	return QMessageBox::question(nullptr, title, message, QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes;
 }
 
 MessageForwarder::DialogResponse MessageForwarder::showYesNoCancel(QString title, QString message, QString YesButtonText, QString NoButtonText, QString CancelButtonText)
 {
+	if(headless())
+	{
+		logHeadless(title, message + " (cancelled)");
+		return DialogResponse::Cancel;
+	}
+
 	QMessageBox box(QMessageBox::Question, title, message,  QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
 
 	box.setButtonText(QMessageBox::Yes,		YesButtonText);
@@ -44,6 +75,12 @@ MessageForwarder::DialogResponse MessageForwarder::showYesNoCancel(QString title
 
 MessageForwarder::DialogResponse MessageForwarder::showSaveDiscardCancel(QString title, QString message)
 {
+	if(headless())
+	{
+		logHeadless(title, message + " (cancelled)");
+		return DialogResponse::Cancel;
+	}
+
 	switch(QMessageBox::question(nullptr, title, message, QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel))
 	{
 	case QMessageBox::Save:			return DialogResponse::Save;
@@ -54,15 +91,24 @@ MessageForwarder::DialogResponse MessageForwarder::showSaveDiscardCancel(QString
 
 QString MessageForwarder::browseOpenFile(QString caption, QString browsePath, QString filter)
 {
+	if(headless())
+		return "";
+
 	return 	QFileDialog::getOpenFileName(nullptr, caption, browsePath, filter);
 }
 
 QString MessageForwarder::browseSaveFile(QString caption, QString browsePath, QString filter, QString * selectedFilter)
 {
+	if(headless())
+		return "";
+
 	return 	QFileDialog::getSaveFileName(nullptr, caption, browsePath, filter, selectedFilter);
 }
 
 QString MessageForwarder::browseOpenFolder(QString caption, QString browsePath)
 {
+	if(headless())
+		return "";
+
 	return QFileDialog::getExistingDirectory(nullptr, caption, browsePath, QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
 }
@@ -38,6 +38,9 @@ signals:
 public slots:
 
 private:
+	static bool headless();
+	static void logHeadless(QString title, QString message);
+
 	static		MessageForwarder	*singleton;
 				MainWindow			*_main;
 };
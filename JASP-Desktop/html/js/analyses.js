@@ -108,6 +108,24 @@ JASPWidgets.Analyses = JASPWidgets.View.extend({
 		return _.find(this.analyses, function (cv) { return cv.model.get("id") === id; });
 	},
 
+	visibleAnalysisIds: function () {
+		// Analyses within half a window of the viewport count as visible so their plots are ready before they are scrolled to
+		var margin = window.innerHeight / 2;
+		var windowTop = $(window).scrollTop() - margin;
+		var windowBottom = windowTop + window.innerHeight + 2 * margin;
+		var ids = [];
+
+		for (var i = 0; i < this.analyses.length; i++) {
+			var $el = this.analyses[i].$el;
+			var top = $el.offset().top;
+
+			if (top < windowBottom && top + $el.outerHeight() > windowTop)
+				ids.push(this.analyses[i].model.get("id"));
+		}
+
+		return ids;
+	},
+
 	reRender: function() {
 		this.analyses.forEach(function(analysis) {analysis.render();});
 	},
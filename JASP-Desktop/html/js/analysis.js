@@ -142,6 +142,15 @@ JASPWidgets.AnalysisView = JASPWidgets.View.extend({
 		'mouseleave': '_hoveringEnd',
 	},
 
+	setProgress: function (progress) {
+		// Only the progressbar moved, so the results are left alone
+		this.model.set({ progress: progress }, { silent: true });
+
+		var $progressbar = this.progressbar.init(progress, this.model.get("id"), this.model.get("status"));
+		this.$el.find(".jasp-progressbar-container").replaceWith($progressbar);
+		this.handleVisibilityProgressbar(this.progressbar.status());
+	},
+
 	handleVisibilityProgressbar: function(statusProgress) {
 		if (statusProgress == "progress-complete") {
 			var id = this.model.get("id");
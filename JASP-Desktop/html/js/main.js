@@ -13,6 +13,22 @@ $(document).ready(function () {
         var ch = new QWebChannel(qt.webChannelTransport, function (channel) {
                 // now you retrieve your object
                 jasp = channel.objects.jasp;
+
+                // Everything about the analyses arrives through "results", in the order it was sent. Changed analyses arrive as objects, at most once per frame each.
+                var results = channel.objects.results;
+
+                results.analysisChanged.connect(function (analysis) { window.analysisChanged(analysis); });
+                results.analysisImageEdited.connect(function (id, image) { window.modifySelectedImage(id, image); });
+                results.analysisProgress.connect(function (id, progress) { window.analysisProgress(id, progress); });
+                results.select.connect(function (id) { window.select(id); });
+                results.unselect.connect(function () { window.unselect(); });
+                results.changeTitle.connect(function (id, title) { window.changeTitle(id, title); });
+                results.remove.connect(function (id) { window.remove(id); });
+                results.removeAllAnalyses.connect(function () { window.removeAllAnalyses(); });
+                results.exportHTML.connect(function (filename) { window.exportHTML(filename); });
+                results.setResultsMeta.connect(function (resultsMeta) { window.setResultsMeta(resultsMeta); });
+                results.getResultsMeta.connect(function () { window.getResultsMeta(); });
+                results.getAllUserData.connect(function () { window.getAllUserData(); });
             });
     var ua = navigator.userAgent.toLowerCase();
 
@@ -84,6 +100,12 @@ $(document).ready(function () {
 		}
 	}
 
+	window.analysisProgress = function (id, progress) {
+		var jaspWidget = analyses.getAnalysis(id);
+		if (jaspWidget !== undefined)
+			jaspWidget.setProgress(progress);
+	}
+
 	window.setAppVersion = function (version) {
 		$(".app-version").text("Version " + version);
 	}
@@ -220,6 +242,15 @@ $(document).ready(function () {
 		jasp.setResultsMetaFromJavascript(JSON.stringify(meta))
 	}
 
+	// Lets the desktop schedule analyses that are on screen before those that are scrolled out of view
+	var reportVisibleAnalyses = _.throttle(function () {
+		if (jasp !== null)
+			jasp.analysesVisibleInResults(JSON.stringify(analyses.visibleAnalysisIds()));
+	}, 250);
+
+	$(window).scroll(reportVisibleAnalyses);
+	$(window).resize(reportVisibleAnalyses);
+
 	window.setResultsMeta = function (resultsMeta) {
 
 		analyses.setResultsMeta(resultsMeta);
@@ -533,6 +564,7 @@ $(document).ready(function () {
 			jaspWidget.model.set(analysis);
 
 		jaspWidget.render();
+		reportVisibleAnalyses();
 	}
 
 	$("#results").on("click", ".stack-trace-selector", function() {
@@ -20,14 +20,28 @@
 #include <QDir>
 
 #include "utilities/application.h"
+#include "resultstesting/testrunner.h"
+#include "utilities/headlessbatch.h"
 #include <QQuickWindow>
-
-const std::string	jaspExtension	= ".jasp",
-					unitTestArg		= "--unitTest",
-					saveArg			= "--save",
-					timeOutArg		= "--timeOut=";
-
-void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitTest, bool & dirTest, int & timeOut, bool & save, bool & logToFile)
+#include <QGuiApplication>
+#include <QTimer>
+
+const std::string	jaspExtension		= ".jasp",
+					unitTestArg			= "--unitTest",
+					saveArg				= "--save",
+					timeOutArg			= "--timeOut=",
+					jobsArg				= "--jobs=",
+					memoryPerJobArg		= "--memoryPerJob=",
+					reportArg			= "--report=",
+					baselineArg			= "--baseline=",
+					perfToleranceArg	= "--perfTolerance=",
+					batchArg			= "--batch",
+					analysesArg			= "--analyses=",
+					resultsJsonArg		= "--resultsJson=",
+					resultsHtmlArg		= "--resultsHtml=",
+					saveAsArg			= "--saveAs=";
+
+void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitTest, bool & dirTest, int & timeOut, bool & save, bool & logToFile, resultXmlCompare::testRunnerSettings & runnerSettings, headlessBatchSettings & batchSettings)
 {
 	filePath	= "";
 	unitTest	= false,
@@ -40,6 +54,23 @@ void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitT
 
 	std::vector<std::string> args(argv + 1, argv + argc); // make the arguments a little less annoying to work with
 
+	auto startsWith = [&](const std::string & arg, const std::string checkThis)
+	{
+		return arg.size() > checkThis.size() && arg.substr(0, checkThis.size()) == checkThis;
+	};
+
+	auto convertNumber = [&](const std::string & number, double & convertInto)
+	{
+		size_t	convertedChars	= 0;
+		double	converted		= 0;
+		try								{ converted = std::stod(number, &convertedChars); }
+		catch(std::invalid_argument &)	{}
+		catch(std::out_of_range &)		{}
+
+		if(convertedChars > 0)	convertInto = converted;
+		else					letsExplainSomeThings = true;
+	};
+
 	for(int arg = 0; arg < args.size(); arg++)
 	{
 		if(args[arg] == saveArg)
@@ -103,18 +134,63 @@ void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitT
 			if(convertedChars > 0)
 				timeOut = convertedTime;
 		}
+		else if(args[arg] == batchArg)
+		{
+			if(arg >= args.size() - 1)
+				letsExplainSomeThings = true;
+			else
+			{
+				batchSettings.inputPath = QString::fromStdString(args[++arg]);
+
+				if(!QFileInfo(batchSettings.inputPath).exists())
+				{
+					std::cerr << "File for batch " << args[arg] << " does not exist!" << std::endl;
+					letsExplainSomeThings = true;
+				}
+			}
+		}
+		else if(startsWith(args[arg], analysesArg))
+			batchSettings.analysesPath	= QString::fromStdString(args[arg].substr(analysesArg.size()));
+		else if(startsWith(args[arg], resultsJsonArg))
+			batchSettings.resultsJson	= QString::fromStdString(args[arg].substr(resultsJsonArg.size()));
+		else if(startsWith(args[arg], resultsHtmlArg))
+			batchSettings.resultsHtml	= QString::fromStdString(args[arg].substr(resultsHtmlArg.size()));
+		else if(startsWith(args[arg], saveAsArg))
+			batchSettings.saveAs		= QString::fromStdString(args[arg].substr(saveAsArg.size()));
+		else if(startsWith(args[arg], jobsArg))
+		{
+			double jobs = 0;
+			convertNumber(args[arg].substr(jobsArg.size()), jobs);
+			runnerSettings.jobs = int(jobs);
+		}
+		else if(startsWith(args[arg], memoryPerJobArg))
+		{
+			double memoryPerJob = 0;
+			convertNumber(args[arg].substr(memoryPerJobArg.size()), memoryPerJob);
+			runnerSettings.memoryPerJobMB = int(memoryPerJob);
+		}
+		else if(startsWith(args[arg], perfToleranceArg))
+			convertNumber(args[arg].substr(perfToleranceArg.size()), runnerSettings.perfTolerance);
+		else if(startsWith(args[arg], reportArg))
+			runnerSettings.reportPath	= QString::fromStdString(args[arg].substr(reportArg.size()));
+		else if(startsWith(args[arg], baselineArg))
+		{
+			runnerSettings.baselinePath	= QString::fromStdString(args[arg].substr(baselineArg.size()));
+
+			if(!QFileInfo(runnerSettings.baselinePath).exists())
+			{
+				std::cerr << "Baseline " << args[arg].substr(baselineArg.size()) << " does not exist!" << std::endl;
+				letsExplainSomeThings = true;
+			}
+		}
 		else
 		{
 			const std::string remoteDebuggingPort = "--remote-debugging-port=",
 								qmlJsDebug = "-qmljsdebugger";
-			auto startsWith = [&](const std::string checkThis)
-			{
-				return args[arg].size() > checkThis.size() && args[arg].substr(0, checkThis.size()) == checkThis;
-			};
 
 			if(args[arg] == "-platform")
 				arg++; // because it is always followed by the actual platform one wants to use (minimal for example)
-			else if(!(startsWith(remoteDebuggingPort) || startsWith(qmlJsDebug))) //Just making sure it isnt something else that should be allowed.
+			else if(!(startsWith(args[arg], remoteDebuggingPort) || startsWith(args[arg], qmlJsDebug))) //Just making sure it isnt something else that should be allowed.
 			{
 				//if it isn't anything else it must be a file to open right?
 
@@ -133,11 +209,15 @@ void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitT
 
 	if(letsExplainSomeThings)
 	{
-		std::cout	<< "JASP can be started without arguments, or the following: { filename | --unitTest filename | --unitTestRecursive folder | --save | --timeOut=10 | --logToFile } \n"
+		std::cout	<< "JASP can be started without arguments, or the following: { filename | --unitTest filename | --unitTestRecursive folder | --save | --timeOut=10 | --jobs=4 | --memoryPerJob=2048 | --report=report.json | --baseline=old.json | --perfTolerance=25 | --batch file | --analyses=analyses.json | --resultsJson=results.json | --resultsHtml=results.html | --saveAs=out.jasp | --logToFile } \n"
 					<< "If a filename is supplied JASP will try to load it. \nIf --unitTest is specified JASP will refresh all analyses in \"filename\" (which must be a JASP file) and see if the output remains the same and will then exit with an errorcode indicating succes or failure.\n"
 					<< "If --unitTestRecursive is specified JASP will go through specified \"folder\" and perform a --unitTest on each JASP file. After it has done this it will exit with an errorcode indication succes or failure.\n"
+					<< "For --unitTestRecursive the optional --jobs argument sets how many files are tested at the same time, by default as many as the cores and memory allow, where the optional --memoryPerJob argument sets how many MB of memory each of them is expected to need (default 2048).\n"
+					<< "For --unitTestRecursive the optional --report argument specifies a json file to write the results and timings (data loading and per analysis) to, a JUnit xml report is written next to it.\n"
+					<< "For --unitTestRecursive the optional --baseline argument specifies an earlier json report, files or analyses that got more than --perfTolerance percent (default 25) slower are reported and JASP exits with errorcode 3 if nothing else failed. Timings are only compared when the baseline was made with the same number of --jobs.\n"
 					<< "For both testing arguments there is the optional --save argument, which specifies that JASP should save the file after refreshing it.\n"
 					<< "For both testing arguments there is the optional --timeout argument, which specifies how many minutes JASP will wait for the analyses-refresh to take. Default is 10 minutes.\n"
+					<< "If --batch is specified JASP runs the analyses in \"file\" (a data file or JASP file) plus those in the --analyses json without any user interface, writes the results to --resultsJson, --resultsHtml and/or --saveAs and exits. The --timeOut argument applies here as well.\n"
 					<< "If --logToFile is specified then JASP will try it's utmost to write logging to a file, this might come in handy if you want to figure out why JASP does not start in case of a bug.\n"
 					<< std::flush;
 
@@ -145,78 +225,6 @@ void parseArguments(int argc, char *argv[], std::string & filePath, bool & unitT
 	}
 }
 
-#define SEPARATE_PROCESS
-
-void recursiveFileOpener(QFileInfo file, int & failures, int & total, int & timeOut, int argc, char *argv[], bool save)
-{
-	const QString jaspExtension(".jasp");
-
-	//std::cout << "recursiveFileOpener in " << file.absoluteFilePath().toStdString() << std::endl;
-
-	if(file.isDir())
-	{
-		//std::cout << "it is a directory and " << (file.exists() ? "exists" : "does not exist") << std::endl;
-
-		QDir dir(file.absoluteFilePath());
-
-		//std::cout << "QDir dir: " << dir.path().toStdString() << " has " << files.size() << " subfiles!" << std::endl;
-
-		for(QFileInfo subFile : dir.entryInfoList(QDir::Filter::NoDotAndDotDot | QDir::Files | QDir::Dirs))
-			recursiveFileOpener(subFile, failures, total, timeOut, argc, argv, save);
-
-	}
-	else if(file.isFile())
-	{
-		//std::cout << "it is a file" << std::endl;
-
-		if(file.absoluteFilePath().indexOf(jaspExtension) == file.absoluteFilePath().size() - jaspExtension.size())
-		{
-			//std::cout << "it has the .jasp extension so we will start JASP" << std::endl;
-#ifndef SEPARATE_PROCESS
-			std::cout << "Found a JASP file (" << file.absoluteFilePath().toStdString() << ") going to start JASP" << std::endl;
-#endif
-
-			int result = 1;
-
-			try{
-#ifdef SEPARATE_PROCESS
-				QProcess subJasp;
-				subJasp.setProgram(argv[0]);
-				QStringList arguments({"--unitTest", file.absoluteFilePath()});
-
-				if(save)
-					arguments << "--save";
-
-				arguments << QString::fromStdString("--timeOut="+std::to_string(timeOut));
-				arguments << "-platform" << "minimal";
-
-				std::cout << "Starting subJASP with args: " << arguments.join(' ').toStdString() << std::endl;
-				subJasp.setArguments(arguments);
-				subJasp.start();
-
-				subJasp.waitForFinished((timeOut * 60000) + 10000);
-
-				std::cerr << subJasp.readAllStandardError().toStdString() << std::endl;
-
-				result = subJasp.exitCode();
-#else
-				//This seems to crash for some reason
-				result = Application(argc, argv, file.absoluteFilePath(), true, timeOut).exec();
-#endif
-			}
-			catch(...) { result = -1; }
-
-
-			std::cout << "JASP file " << file.absoluteFilePath().toStdString() << (result == 0 ? " succeeded!" : " failed!") << std::endl;
-
-			if(result != 0)
-				failures++;
-
-			total++;
-		}
-	}
-}
-
 int main(int argc, char *argv[])
 {
 #ifdef _WIN32
@@ -235,10 +243,34 @@ int main(int argc, char *argv[])
 				logToFile;
 	int			timeOut;
 
-	parseArguments(argc, argv, filePath, unitTest, dirTest, timeOut, save, logToFile);
+	resultXmlCompare::testRunnerSettings	runnerSettings;
+	headlessBatchSettings					batchSettings;
+
+	parseArguments(argc, argv, filePath, unitTest, dirTest, timeOut, save, logToFile, runnerSettings, batchSettings);
 
 	QString filePathQ(QString::fromStdString(filePath));
 
+	if(batchSettings.inputPath != "")
+	{
+		// No QApplication, so no widgets or dialogs can get started by accident, but a QGuiApplication because the forms of the analyses are QtQuick items.
+		// Those are never shown so the minimal platform is enough and no display is needed.
+		if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+			qputenv("QT_QPA_PLATFORM", "minimal");
+
+		QGuiApplication application(argc, argv);
+		QCoreApplication::setOrganizationName("JASP");
+		QCoreApplication::setOrganizationDomain("jasp-stats.org");
+		QCoreApplication::setApplicationName("JASP");
+		QLocale::setDefault(QLocale(QLocale::English));
+
+		batchSettings.timeOut = timeOut;
+
+		HeadlessBatch batch(batchSettings);
+		QTimer::singleShot(0, &batch, &HeadlessBatch::start);
+
+		return application.exec();
+	}
+
 	if(!dirTest)
 		//try
 		{
@@ -265,25 +297,10 @@ int main(int argc, char *argv[])
 	//	catch(...) { return -1; }
 	else
 	{
-		int		failures	= 0,
-				total		= 0;
-
-		recursiveFileOpener(QFileInfo(filePathQ), failures, total, timeOut, argc, argv, save);
-
-		if(total == 0)
-		{
-			std::cerr << "Couldn't find any jasp-files in specified directory " << filePath << ", it will be treated as a failure to notify you of this!" << std::endl;
-			exit(2);
-		}
-
-		if(failures > 0)
-		{
-			std::cerr << "Finished running test, " << failures << " out of " << total << " jasp files FAILED!" << std::endl;
-			exit(1);
-		}
+		runnerSettings.timeOut	= timeOut;
+		runnerSettings.save		= save;
 
-		std::cout << "All " << total << " jasp files succeeded in refreshing and displaying the same data afterwards!" << std::endl;
-		exit(0);
+		exit(resultXmlCompare::testRunner(argv[0], runnerSettings).run(filePathQ));
 	}
 
 }
@@ -119,9 +119,7 @@ MainWindow::MainWindow(QApplication * application) : QObject(application), _appl
 	_columnsModel			= new ColumnsModel(this);
 	_computedColumnsModel	= new ComputedColumnsModel(_analyses, this);
 	_filterModel			= new FilterModel(_package, this);
-	_ribbonModel			= new RibbonModel(_dynamicModules,
-									{ "Descriptives", "T-Tests", "ANOVA", "Regression", "Frequencies", "Factor" },
-									{ "Network", "Meta Analysis", "SEM", "Summary Statistics" });
+	_ribbonModel			= new RibbonModel(_dynamicModules, RibbonModel::defaultCommonModules, RibbonModel::defaultExtraModules);
 	_ribbonModelFiltered	= new RibbonModelFiltered(this, _ribbonModel);
 	_fileMenu				= new FileMenu(this);
 	_helpModel				= new HelpModel(this);
@@ -135,10 +133,7 @@ MainWindow::MainWindow(QApplication * application) : QObject(application), _appl
 
 	makeConnections();
 
-	qmlRegisterType<DataSetView>			("JASP", 1, 0, "DataSetView");
-	qmlRegisterType<AnalysisForm>			("JASP", 1, 0, "AnalysisForm");
-	qmlRegisterType<JASPDoubleValidator>	("JASP", 1, 0, "JASPDoubleValidator");
-	qmlRegisterType<ResultsJsInterface>		("JASP", 1, 0, "ResultsJsInterface");
+	registerQmlTypes();
 
 	loadQML();
 
@@ -235,6 +230,7 @@ void MainWindow::makeConnections()
 	connect(_resultsJsInterface,	&ResultsJsInterface::analysisSelected,				_analyses,				&Analyses::analysisIdSelectedInResults						);
 	connect(_resultsJsInterface,	&ResultsJsInterface::analysisUnselected,			_analyses,				&Analyses::analysesUnselectedInResults						);
 	connect(_resultsJsInterface,	&ResultsJsInterface::analysisTitleChangedFromResults,_analyses,				&Analyses::analysisTitleChangedFromResults					);
+	connect(_resultsJsInterface,	&ResultsJsInterface::analysesVisibleInResults,		_analyses,				&Analyses::analysesVisibleInResults							);
 	connect(_resultsJsInterface,	&ResultsJsInterface::openFileTab,					_fileMenu,				&FileMenu::showFileOpenMenu									);
 	connect(_resultsJsInterface,	&ResultsJsInterface::refreshAllAnalyses,			this,					&MainWindow::refreshKeyPressed								);
 	connect(_resultsJsInterface,	&ResultsJsInterface::removeAllAnalyses,				this,					&MainWindow::removeAllAnalyses								);
@@ -250,6 +246,7 @@ void MainWindow::makeConnections()
 	connect(_analyses,				&Analyses::showAnalysisInResults,					_resultsJsInterface,	&ResultsJsInterface::showAnalysis							);
 	connect(_analyses,				&Analyses::unselectAnalysisInResults,				_resultsJsInterface,	&ResultsJsInterface::unselect								);
 	connect(_analyses,				&Analyses::analysisImageEdited,						_resultsJsInterface,	&ResultsJsInterface::analysisImageEditedHandler				);
+	connect(_analyses,				&Analyses::analysisProgressChanged,					_resultsJsInterface,	&ResultsJsInterface::analysisProgressChanged				);
 	connect(_analyses,				&Analyses::analysisRemoved,							_resultsJsInterface,	&ResultsJsInterface::removeAnalysis							);
 	//connect(_analyses,			&Analyses::analysisNameSelected,					_helpModel,				&HelpModel::setAnalysispagePath								); //The user can click the info-button if they want to see some documentation
     connect(_analyses,				&Analyses::analysesExportResults,					_fileMenu,				&FileMenu::analysesExportResults							);
@@ -300,6 +297,7 @@ void MainWindow::loadQML()
 	_qml->rootContext()->setContextProperty("columnsModel",				_columnsModel);
 	_qml->rootContext()->setContextProperty("computedColumnsInterface",	_computedColumnsModel);
 	_qml->rootContext()->setContextProperty("engineSync",				_engineSync);
+	_qml->rootContext()->setContextProperty("enginePerformance",		_engineSync->performance());
 	_qml->rootContext()->setContextProperty("filterModel",				_filterModel);
 	_qml->rootContext()->setContextProperty("ribbonModel",				_ribbonModel);
 	_qml->rootContext()->setContextProperty("ribbonModelFiltered",		_ribbonModelFiltered);
@@ -316,29 +314,43 @@ void MainWindow::loadQML()
 	_qml->rootContext()->setContextProperty("baseBlockDim",				20); //should be taken from Theme
 	_qml->rootContext()->setContextProperty("baseFontSize",				16);
 
-	_qml->rootContext()->setContextProperty("columnTypeScale",			int(Column::ColumnType::ColumnTypeScale));
-	_qml->rootContext()->setContextProperty("columnTypeOrdinal",		int(Column::ColumnType::ColumnTypeOrdinal));
-	_qml->rootContext()->setContextProperty("columnTypeNominal",		int(Column::ColumnType::ColumnTypeNominal));
-	_qml->rootContext()->setContextProperty("columnTypeNominalText",	int(Column::ColumnType::ColumnTypeNominalText));
-
-	bool debug = false;
-#ifdef JASP_DEBUG
-	debug = true;
-#endif
-
-	_qml->rootContext()->setContextProperty("DEBUG_MODE",			debug);
-	_qml->rootContext()->setContextProperty("iconPath",				_iconPath);
-	_qml->rootContext()->setContextProperty("iconFiles",			_iconFiles);
-	_qml->rootContext()->setContextProperty("iconInactiveFiles",	_iconInactiveFiles);
-	_qml->rootContext()->setContextProperty("iconDisabledFiles",	_iconDisabledFiles);
+	setFormContextProperties(_qml->rootContext());
 
 	_qml->addImportPath("qrc:///components");
 
 	_qml->load(QUrl("qrc:///components/JASP/Widgets/HelpWindow.qml"));
 	_qml->load(QUrl("qrc:///components/JASP/Widgets/AboutWindow.qml"));
+	_qml->load(QUrl("qrc:///components/JASP/Widgets/EnginePerformanceWindow.qml"));
 	_qml->load(QUrl("qrc:///components/JASP/Widgets/MainWindow.qml"));
 }
 
+void MainWindow::registerQmlTypes()
+{
+	qmlRegisterType<DataSetView>			("JASP", 1, 0, "DataSetView");
+	qmlRegisterType<AnalysisForm>			("JASP", 1, 0, "AnalysisForm");
+	qmlRegisterType<JASPDoubleValidator>	("JASP", 1, 0, "JASPDoubleValidator");
+	qmlRegisterType<ResultsJsInterface>		("JASP", 1, 0, "ResultsJsInterface");
+}
+
+void MainWindow::setFormContextProperties(QQmlContext * context)
+{
+	context->setContextProperty("columnTypeScale",			int(Column::ColumnType::ColumnTypeScale));
+	context->setContextProperty("columnTypeOrdinal",		int(Column::ColumnType::ColumnTypeOrdinal));
+	context->setContextProperty("columnTypeNominal",		int(Column::ColumnType::ColumnTypeNominal));
+	context->setContextProperty("columnTypeNominalText",	int(Column::ColumnType::ColumnTypeNominalText));
+
+	bool debug = false;
+#ifdef JASP_DEBUG
+	debug = true;
+#endif
+
+	context->setContextProperty("DEBUG_MODE",			debug);
+	context->setContextProperty("iconPath",				_iconPath);
+	context->setContextProperty("iconFiles",			_iconFiles);
+	context->setContextProperty("iconInactiveFiles",	_iconInactiveFiles);
+	context->setContextProperty("iconDisabledFiles",	_iconDisabledFiles);
+}
+
 void MainWindow::initLog()
 {
 	assert(_engineSync != nullptr && _preferences != nullptr);
@@ -347,6 +359,8 @@ void MainWindow::initLog()
 	Log::initRedirects();
 	Log::setLogFileName(Log::logFileNameBase + " Desktop.log");
 	Log::setLoggingToFile(_preferences->logToFile());
+	JaspTimer::setTraceFileName(Log::logFileNameBase + " Desktop.trace.json");
+	JaspTimer::setProcessName("JASP Desktop");
 	logRemoveSuperfluousFiles(_preferences->logFilesMax());
 
 	connect(_preferences, &PreferencesModel::logToFileChanged,		this,			&MainWindow::logToFileChanged									); //Not connecting preferences directly to Log to keep it Qt-free (for Engine/R-Interface)
@@ -363,7 +377,7 @@ void MainWindow::logRemoveSuperfluousFiles(int maxFilesToKeep)
 {
 	QDir logFileDir(AppDirs::logDir());
 
-	QFileInfoList logs = logFileDir.entryInfoList({"*.log"}, QDir::Filter::Files, QDir::SortFlag::Name | QDir::SortFlag::Reversed);
+	QFileInfoList logs = logFileDir.entryInfoList({"*.log", "*.trace.json"}, QDir::Filter::Files, QDir::SortFlag::Name | QDir::SortFlag::Reversed);
 
 	if(logs.size() < maxFilesToKeep)
 		return;
@@ -386,7 +400,10 @@ void MainWindow::showLogFolder()
 void MainWindow::open(QString filepath)
 {
 	if(resultXmlCompare::compareResults::theOne()->testMode())
+	{
 		resultXmlCompare::compareResults::theOne()->setFilePath(filepath);
+		resultXmlCompare::compareResults::theOne()->startTiming();
+	}
 
 	_openedUsingArgs = true;
 	if (_resultsViewLoaded)	_fileMenu->open(filepath);
@@ -579,8 +596,15 @@ void MainWindow::analysisResultsChangedHandler(Analysis *analysis)
 
 	setPackageModified();
 
+	checkStalePlotsRewritten();
+
 	if(resultXmlCompare::compareResults::theOne()->testMode())
+	{
+		if(resultXmlCompare::compareResults::theOne()->refreshed() && analysis->isFinished())
+			resultXmlCompare::compareResults::theOne()->analysisFinished(int(analysis->id()), analysis->nameQ(), analysis->titleQ(), analysis->msInEngine());
+
 		analysesForComparingDoneAlready();
+	}
 }
 
 void MainWindow::analysisSaveImageHandler(int id, QString options)
@@ -695,6 +719,9 @@ void MainWindow::dataSetIORequestHandler(FileEvent *event)
 	}
 	else if (event->operation() == FileEvent::FileSave)
 	{
+		if (waitForStalePlots(event))
+			return;
+
 		if (_analyses->count() > 0)
 		{
 			_package->setWaitingForReady();
@@ -717,6 +744,9 @@ void MainWindow::dataSetIORequestHandler(FileEvent *event)
 	}
 	else if (event->operation() == FileEvent::FileExportResults)
 	{
+		if (waitForStalePlots(event))
+			return;
+
 		connect(event, &FileEvent::completed, this, &MainWindow::dataSetIOCompleted);
 
 		_resultsJsInterface->exportHTML();
@@ -779,6 +809,46 @@ void MainWindow::dataSetIORequestHandler(FileEvent *event)
 }
 
 
+///Saving or exporting the results has to wait until the plots that were rendered with old settings are rewritten, otherwise those old plots end up in the file.
+///A save or export that comes in while another one is still waiting goes after it, and whatever went stale in the meantime is waited for as well.
+bool MainWindow::waitForStalePlots(FileEvent *event)
+{
+	std::set<size_t> stale = _analyses->refreshStalePlots();
+	_plotsBeingRewritten.insert(stale.begin(), stale.end());
+
+	if (_plotsBeingRewritten.size() == 0 && _eventsWaitingForPlots.size() == 0)
+		return false;
+
+	Log::log() << "Waiting for the plots of " << _plotsBeingRewritten.size() << " analyses to be rewritten before " << (event->operation() == FileEvent::FileSave ? "saving" : "exporting") << std::endl;
+
+	_eventsWaitingForPlots.push_back(event);
+	return true;
+}
+
+void MainWindow::checkStalePlotsRewritten()
+{
+	if (_eventsWaitingForPlots.size() == 0)
+		return;
+
+	for (auto it = _plotsBeingRewritten.begin(); it != _plotsBeingRewritten.end();)
+	{
+		Analysis * analysis = _analyses->get(*it);
+
+		if (analysis == nullptr || (!analysis->isRewriteImgs() && analysis->status() != Analysis::Running))	it = _plotsBeingRewritten.erase(it);
+		else																								it++;
+	}
+
+	if (_plotsBeingRewritten.size() > 0)
+		return;
+
+	//Emptied first, so that they go ahead unless their own plots went stale again, in which case they queue up again in the same order
+	std::deque<FileEvent*> events;
+	events.swap(_eventsWaitingForPlots);
+
+	for (FileEvent * event : events)
+		dataSetIORequestHandler(event);
+}
+
 ///Returns true if the caller can go ahead and close up shop.
 bool MainWindow::checkPackageModifiedBeforeClosing()
 {
@@ -844,7 +914,10 @@ void MainWindow::dataSetIOCompleted(FileEvent *event)
 			}
 
 			if (resultXmlCompare::compareResults::theOne()->testMode())
+			{
+				resultXmlCompare::compareResults::theOne()->setDataLoaded();
 				QTimer::singleShot(1000, this, &MainWindow::startComparingResults);
+			}
 
 		}
 		else
@@ -1121,6 +1194,7 @@ void MainWindow::saveTextToFileHandler(const QString &filename, const QString &d
 void MainWindow::analysesCountChangedHandler()
 {
 	setAnalysesAvailable(_analyses->count() > 0);
+	checkStalePlotsRewritten(); //A removed analysis won't rewrite its plots anymore
 }
 
 void MainWindow::setPackageModified()
@@ -1309,6 +1383,7 @@ void MainWindow::testLoadedJaspFile(int timeOut, bool save)
 void MainWindow::unitTestTimeOut()
 {
 	std::cerr << "Time out for unit test!" << std::endl;
+	resultXmlCompare::compareResults::theOne()->printTimings();
 	_application->exit(2);
 }
 
@@ -1355,6 +1430,7 @@ void MainWindow::finishComparingResults()
 		resultXmlCompare::compareResults::theOne()->setRefreshResult(QString::fromStdString(resultHtml));
 
 		resultXmlCompare::compareResults::theOne()->compare();
+		resultXmlCompare::compareResults::theOne()->printTimings();
 
 		if(resultXmlCompare::compareResults::theOne()->shouldSave())
 			emit saveJaspFile();
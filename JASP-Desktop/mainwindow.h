@@ -24,6 +24,7 @@
 #include <QSettings>
 #include <QApplication>
 #include <QQmlApplicationEngine>
+#include <deque>
 
 #include "analysis/analyses.h"
 #include "analysis/analysisform.h"
@@ -84,6 +85,10 @@ public:
 
 	static QString columnTypeToString(int columnType) { return _columnTypeMap[columnType]; }
 
+	///The types and the context properties the forms of the analyses need, HeadlessBatch uses these to create the forms without a MainWindow.
+	static void registerQmlTypes();
+	static void setFormContextProperties(QQmlContext * context);
+
 public slots:
 	void setImageBackgroundHandler(QString value);
 	void setProgressBarVisible(bool progressBarVisible);
@@ -129,6 +134,9 @@ private:
 	void delayedLoadHandler();
 	void checkUsedModules();
 
+	bool waitForStalePlots(FileEvent *event);
+	void checkStalePlotsRewritten();
+
 	void packageChanged(DataSetPackage *package);
 	void packageDataChanged(DataSetPackage *package, std::vector<std::string> &changedColumns, std::vector<std::string> &missingColumns, std::map<std::string, std::string> &changeNameColumns,	bool rowCountChanged);
 	void setDataSetAndPackageInModels(DataSetPackage *package);
@@ -236,6 +244,8 @@ private:
 	PreferencesModel			*	_preferences			= nullptr;
 	ResultMenuModel				*	_resultMenuModel		= nullptr;
 	FileEvent					*	_openEvent				= nullptr;
+	std::deque<FileEvent*>			_eventsWaitingForPlots;	///< Saves and exports that go ahead, in order, once _plotsBeingRewritten are done
+	std::set<size_t>				_plotsBeingRewritten;
 
 	QSettings						_settings;
 
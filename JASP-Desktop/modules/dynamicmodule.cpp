@@ -247,6 +247,17 @@ Json::Value	DynamicModule::requestJsonForPackageInstallationRequest()
 }
 
 Json::Value	DynamicModule::requestJsonForPackageLoadingRequest()
+{
+	setLoadLog("Module " + _name + " is being loaded from " + _moduleFolder.absolutePath().toStdString() + "\n");
+
+	Json::Value requestJson = requestJsonForEngineLoadingRequest();
+
+	setLoading(true);
+
+	return requestJson;
+}
+
+Json::Value	DynamicModule::requestJsonForEngineLoadingRequest()
 {
 	Json::Value requestJson(Json::objectValue);
 
@@ -254,8 +265,6 @@ Json::Value	DynamicModule::requestJsonForPackageLoadingRequest()
 	requestJson["moduleName"]		= _name;
 	requestJson["moduleCode"]		= generateModuleLoadingR();
 
-	setLoading(true);
-
 	return requestJson;
 }
 
@@ -330,8 +339,6 @@ std::string DynamicModule::generateModuleLoadingR(bool shouldReturnSucces)
 {
 	std::stringstream R;
 
-	setLoadLog("Module " + _name + " is being loaded from " + _moduleFolder.absolutePath().toStdString() + "\n");
-
 	R << _name << " <- module({\n" << standardRIndent << ".libPaths('" << moduleRLibrary().toStdString() << "');\n";
 	R << standardRIndent << "import('" << _name << "');\n\n";
 
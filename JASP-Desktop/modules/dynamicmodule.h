@@ -104,6 +104,7 @@ public:
 	std::string			generateModuleUninstallingR();
 
 	Json::Value			requestJsonForPackageLoadingRequest();
+	Json::Value			requestJsonForEngineLoadingRequest(); //For loading a module that is ready for use into another engine, leaves status and log alone
 	Json::Value			requestJsonForPackageUnloadingRequest();
 	Json::Value			requestJsonForPackageInstallationRequest();
 	Json::Value			requestJsonForPackageUninstallingRequest();
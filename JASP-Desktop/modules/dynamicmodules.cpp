@@ -575,29 +575,6 @@ void DynamicModules::regenerateDeveloperModuleRPackage()
 	devMod->setStatus(moduleStatus::installNeeded);
 }
 
-Json::Value	DynamicModules::getJsonForReloadingActiveModules()
-{
-	Json::Value requestJson(Json::objectValue);
-
-	std::stringstream loadingCode;
-	for(int i=0; i<_moduleNames.size(); i++)
-	{
-		const std::string & modName = _moduleNames[i];
-
-		if(_modules[modName]->readyForUse()) //should be loaded again
-			loadingCode << _modules[modName]->generateModuleLoadingR(i == _moduleNames.size() - 1) << "\n";
-	}
-
-	if(loadingCode.str() == "")
-		loadingCode << "return('" << Modules::DynamicModule::succesResultString() << "')"; //We could also avoid calling getJsonForReloadingActiveModules altogether but whatever
-
-	requestJson["moduleCode"]		= loadingCode.str();
-	requestJson["moduleRequest"]	= moduleStatusToString(moduleStatus::loadingNeeded);
-	requestJson["moduleName"]		= "*";
-
-	return requestJson;
-}
-
 void DynamicModules::enginesStopped()
 {
 	for(auto & nameMod : _modules)
@@ -58,7 +58,7 @@ public:
 	Json::Value	getJsonForPackageLoadingRequest()		{ return requestModuleForSomethingAndRemoveIt(_modulesToBeLoaded)->requestJsonForPackageLoadingRequest();					}
 	Json::Value getJsonForPackageUnloadingRequest();
 	Json::Value	getJsonForPackageInstallationRequest()	{ return requestModuleForSomethingAndRemoveIt(_modulesInstallPackagesNeeded)->requestJsonForPackageInstallationRequest();	}
-	Json::Value	getJsonForReloadingActiveModules();
+	Json::Value	getJsonForLoadingOnEngine(const std::string & moduleName)	{ return _modules.at(moduleName)->requestJsonForEngineLoadingRequest(); }
 
 	Modules::DynamicModule*	dynamicModule(	const std::string & moduleName)	const { return _modules.count(moduleName) == 0 ? nullptr : _modules.at(moduleName); }
 	Modules::DynamicModule*	operator[](		const std::string & moduleName)		const { return dynamicModule(moduleName); }
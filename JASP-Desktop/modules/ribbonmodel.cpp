@@ -21,6 +21,9 @@
 #include "dirs.h"
 #include "log.h"
 
+const std::vector<std::string> RibbonModel::defaultCommonModules	= { "Descriptives", "T-Tests", "ANOVA", "Regression", "Frequencies", "Factor" };
+const std::vector<std::string> RibbonModel::defaultExtraModules		= { "Network", "Meta Analysis", "SEM", "Summary Statistics" };
+
 RibbonModel::RibbonModel(DynamicModules * dynamicModules, std::vector<std::string> commonModulesToLoad, std::vector<std::string> extraModulesToLoad)
 	: QAbstractListModel(dynamicModules), _dynamicModules(dynamicModules)
 {
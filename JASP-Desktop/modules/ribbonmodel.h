@@ -47,6 +47,9 @@ public:
 
 	RibbonModel(DynamicModules * dynamicModules, std::vector<std::string> commonModulesToLoad = {}, std::vector<std::string> extraModulesToLoad = {});
 
+	static const std::vector<std::string>	defaultCommonModules,	///< Modules that are always shown in the ribbon
+											defaultExtraModules;	///< Modules that come with JASP but can be switched on and off
+
 	int								rowCount(const QModelIndex & = QModelIndex())				const override	{	return int(_moduleNames.size());	}
 	QVariant						data(const QModelIndex &index, int role = Qt::DisplayRole)	const override;
 	virtual QHash<int, QByteArray>	roleNames()													const override;
@@ -47,6 +47,9 @@ void DataSetView::setModel(QAbstractTableModel * model)
 		connect(_model, &QAbstractTableModel::modelAboutToBeReset,	this, &DataSetView::modelAboutToBeReset);
 		connect(_model, &QAbstractTableModel::modelReset,			this, &DataSetView::modelWasReset);
 
+		if(_model->metaObject()->indexOfSignal("columnWidthsChanged(int,int)") != -1) //DataSetTableModel estimates widths from a sample first and widens them later
+			connect(_model, SIGNAL(columnWidthsChanged(int,int)), this, SLOT(modelColumnWidthsChanged(int,int)));
+
 		setRolenames();
 
 		QSizeF calcedSizeRowNumber = _metricsFont.size(Qt::TextSingleLine, QString::fromStdString(std::to_string(_model->rowCount()) + "XXX"));
@@ -73,11 +76,20 @@ void DataSetView::setRolenames()
 
 }
 
-void DataSetView::calculateCellSizes()
+//Only the columns from firstColumn up to and including lastColumn are measured again, unless lastColumn is -1 or the number of columns changed.
+void DataSetView::calculateCellSizesForColumns(int firstColumn, int lastColumn)
 {
 	JASPTIMER_RESUME(calculateCellSizes);
 
-	_cellSizes.clear();
+	bool allColumns = lastColumn == -1 || _model == nullptr || _cellSizes.size() != size_t(_model->columnCount());
+
+	if(allColumns)
+	{
+		_cellSizes.clear();
+		firstColumn = 0;
+		lastColumn	= _model == nullptr ? -1 : _model->columnCount() - 1;
+	}
+
 	_dataColsMaxWidth.clear();
 
 	for(auto col : _cellTextItems)
@@ -109,12 +121,20 @@ void DataSetView::calculateCellSizes()
 
 	_metricsFont = QFontMetricsF(_font);
 
-	for(int col=0; col<_model->columnCount(); col++)
+	if(_measuredWithFont != _font)
+	{
+		_measuredMaxColStrings.clear();
+		_measuredWithFont = _font;
+	}
+
+	for(int col=std::max(0, firstColumn); col<=lastColumn && col<_model->columnCount(); col++)
 	{
 		QString text = _model->headerData(col, Qt::Orientation::Horizontal, _roleNameToRole["maxColString"]).toString();
-		QSizeF calcedSize = _metricsFont.size(Qt::TextSingleLine, text);
 
-		_cellSizes[col] = calcedSize;
+		if(!_measuredMaxColStrings.contains(text))
+			_measuredMaxColStrings[text] = _metricsFont.size(Qt::TextSingleLine, text);
+
+		_cellSizes[col] = _measuredMaxColStrings[text];
 	}
 
 	_dataColsMaxWidth.resize(_model->columnCount());
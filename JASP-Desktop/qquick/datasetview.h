@@ -126,10 +126,12 @@ public slots:
 	void reloadRowNumbers();
 	void reloadColumnHeaders();
 
-	void calculateCellSizes();
+	void calculateCellSizes()																{ calculateCellSizesForColumns(0, -1); }
+	void calculateCellSizesForColumns(int firstColumn, int lastColumn);
 
 	void modelDataChanged(const QModelIndex &, const QModelIndex &, const QVector<int> &)	{ calculateCellSizes(); }
 	void modelHeaderDataChanged(Qt::Orientation, int, int)									{ calculateCellSizes(); }
+	void modelColumnWidthsChanged(int firstColumn, int lastColumn)							{ calculateCellSizesForColumns(firstColumn, lastColumn); }
 	void modelAboutToBeReset()																{ _storedLineFlags.clear(); _storedDisplayText.clear(); }
 	void modelWasReset()																	{ setRolenames(); calculateCellSizes(); }
 
@@ -209,6 +211,9 @@ protected:
 
 	QFontMetricsF _metricsFont;
 
+	QFont					_measuredWithFont;
+	QHash<QString, QSizeF>	_measuredMaxColStrings; //maxColString only changes when the column does, so no need to measure it again every time anything changes
+
 	std::map<std::string, int> _roleNameToRole;
 
 	float	_rowNumberMaxWidth	= 0;
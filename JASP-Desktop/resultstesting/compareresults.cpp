@@ -1,5 +1,7 @@
 #include "compareresults.h"
 #include <QXmlStreamReader>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <stack>
 #include <iostream>
 #include "log.h"
@@ -7,7 +9,8 @@
 namespace resultXmlCompare
 {
 
-compareResults * compareResults::singleton = nullptr;
+compareResults * compareResults::singleton		= nullptr;
+const char		* compareResults::timingsPrefix	= "JASP test timings: ";
 
 compareResults * compareResults::theOne()
 {
@@ -286,5 +289,36 @@ bool compareResults::compare(const QString & resultOld, const QString & resultNe
 	return succes;
 }
 
+void compareResults::analysisFinished(int id, QString name, QString title, qint64 engineMs)
+{
+	//An analysis can finish more than once, for instance when it is inited before it runs, the last time counts.
+	analysisTimings[id] = { name, title, refreshStartedMs < 0 ? -1 : timer.elapsed() - refreshStartedMs, engineMs };
+}
+
+void compareResults::printTimings() const
+{
+	QJsonArray analyses;
+
+	for(const auto & idTiming : analysisTimings)
+	{
+		QJsonObject analysis;
+
+		analysis["id"]			= idTiming.first;
+		analysis["name"]		= idTiming.second.name;
+		analysis["title"]		= idTiming.second.title;
+		analysis["wallMs"]		= double(idTiming.second.wallMs);
+		analysis["engineMs"]	= double(idTiming.second.engineMs);
+
+		analyses.append(analysis);
+	}
+
+	QJsonObject timings;
+
+	timings["dataLoadMs"]	= double(dataLoadMs);
+	timings["totalMs"]		= double(timer.isValid() ? timer.elapsed() : -1);
+	timings["analyses"]		= analyses;
+
+	std::cout << timingsPrefix << QJsonDocument(timings).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+}
 
 }
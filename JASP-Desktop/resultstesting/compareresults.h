@@ -2,6 +2,9 @@
 #define COMPARERESULTS_H
 
 #include <QString>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <map>
 #include "resultscomparetable.h"
 
 namespace resultXmlCompare
@@ -26,7 +29,7 @@ public:
 	void	enableSaving()				{ saveAfterRefresh = true; }
 	bool	shouldSave()		const	{ return saveAfterRefresh; }
 
-	void	setRefreshCalled()			{ atLeastOneRefreshHappened = true; }
+	void	setRefreshCalled()			{ atLeastOneRefreshHappened = true; refreshStartedMs = timer.elapsed(); }
 	bool	refreshed()			const	{ return atLeastOneRefreshHappened; }
 
 	void	setExportCalled()			{ resultsExportCalled = true; }
@@ -38,11 +41,27 @@ public:
 	QString	filePath()			const	{ return _filePath;	}
 	void	setFilePath(QString p)		{ _filePath = p;	}
 
+	void	startTiming()				{ timer.start(); }
+	void	setDataLoaded()				{ dataLoadMs = timer.elapsed(); }
+	void	analysisFinished(int id, QString name, QString title, qint64 engineMs);
+
+	///Timings of this test run as a single line on stdout, so that a --unitTestRecursive run can collect them from its sub-JASPs
+	void	printTimings() const;
+
+	static	const char		*timingsPrefix;
 	static	compareResults	*theOne();
 
 private:
 	explicit		compareResults() {}
 
+	struct analysisTiming
+	{
+		QString	name,
+				title;
+		qint64	wallMs,
+				engineMs;
+	};
+
 	bool			runningTestMode				= false,
 					atLeastOneRefreshHappened	= false,
 					resultsExportCalled			= false,
@@ -54,6 +73,11 @@ private:
 					refreshedResultExport		= "",
 					_filePath					= "";
 
+	QElapsedTimer					timer;
+	qint64							dataLoadMs			= -1,
+									refreshStartedMs	= -1;
+	std::map<int, analysisTiming>	analysisTimings;
+
 	static compareResults*	singleton;
 };
 
@@ -0,0 +1,391 @@
+#include "testrunner.h"
+#include "compareresults.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QXmlStreamWriter>
+#include <QDateTime>
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace resultXmlCompare
+{
+
+const qint64	minimumFileSlowerMs		= 1000,	///< Below these differences we consider it noise, no matter the percentage
+				minimumAnalysisSlowerMs	= 250;
+
+static qint64 physicalMemoryMB()
+{
+#ifdef _WIN32
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+
+	if(GlobalMemoryStatusEx(&status))
+		return qint64(status.ullTotalPhys / (1024 * 1024));
+#else
+	long	pages		= sysconf(_SC_PHYS_PAGES),
+			pageSize	= sysconf(_SC_PAGESIZE);
+
+	if(pages > 0 && pageSize > 0)
+		return qint64(pages) * pageSize / (1024 * 1024);
+#endif
+	return -1;
+}
+
+testRunner::testRunner(const QString & jaspExecutable, const testRunnerSettings & settings)
+	: _jaspExecutable(jaspExecutable), _settings(settings)
+{}
+
+int testRunner::defaultJobs(int memoryPerJobMB)
+{
+	int		jobs		= std::max(1, QThread::idealThreadCount());
+	qint64	memoryMB	= physicalMemoryMB();
+
+	if(memoryMB > 0 && memoryPerJobMB > 0)
+		jobs = std::min(jobs, int(std::max(qint64(1), memoryMB / memoryPerJobMB)));
+
+	return jobs;
+}
+
+void testRunner::collectFiles(const QString & path)
+{
+	const QString	jaspExtension(".jasp");
+	QFileInfo		file(path);
+
+	if(file.isDir())
+	{
+		for(QFileInfo subFile : QDir(file.absoluteFilePath()).entryInfoList(QDir::Filter::NoDotAndDotDot | QDir::Files | QDir::Dirs))
+			collectFiles(subFile.absoluteFilePath());
+	}
+	else if(file.isFile() && file.absoluteFilePath().endsWith(jaspExtension))
+	{
+		fileRun run;
+		run.file = file.absoluteFilePath();
+		_runs.push_back(run);
+	}
+}
+
+QString testRunner::relativePath(const QString & file) const
+{
+	return QFileInfo(_folder).isDir() ? QDir(_folder).relativeFilePath(file) : QFileInfo(file).fileName();
+}
+
+int testRunner::run(const QString & folder)
+{
+	_folder = QFileInfo(folder).absoluteFilePath();
+	_runs.clear();
+
+	collectFiles(_folder);
+
+	if(_runs.size() == 0)
+	{
+		std::cerr << "Couldn't find any jasp-files in specified directory " << folder.toStdString() << ", it will be treated as a failure to notify you of this!" << std::endl;
+		return 2;
+	}
+
+	size_t	jobs = size_t(_settings.jobs > 0 ? _settings.jobs : defaultJobs(_settings.memoryPerJobMB));
+			jobs = std::min(jobs, _runs.size());
+	_jobs	= jobs;
+
+	std::cout << "Testing " << _runs.size() << " jasp files with " << jobs << " sub-JASPs at the same time." << std::endl;
+
+	_timer.start();
+
+	// There is no eventloop here, so we poll the sub-JASPs in turn, waitForFinished also keeps their output flowing into the buffers.
+	std::vector<size_t>	running;
+	size_t				next		= 0;
+	const qint64		timeOutMs	= (_settings.timeOut * 60000) + 10000;
+
+	while(next < _runs.size() || running.size() > 0)
+	{
+		while(running.size() < jobs && next < _runs.size())
+		{
+			start(_runs[next]);
+			running.push_back(next++);
+		}
+
+		int pollMs = std::max(10, 100 / int(running.size()));
+
+		for(auto it = running.begin(); it != running.end();)
+		{
+			fileRun	&	run		= _runs[*it];
+			bool		done	= run.process->state() == QProcess::NotRunning || run.process->waitForFinished(pollMs);
+
+			if(!done && run.timer.elapsed() > timeOutMs)
+			{
+				run.timedOut = true;
+				run.process->kill();
+				run.process->waitForFinished();
+				done = true;
+			}
+
+			if(done)
+			{
+				finish(run);
+				it = running.erase(it);
+			}
+			else
+				it++;
+		}
+	}
+
+	if(_settings.baselinePath != "")
+		compareToBaseline();
+
+	if(_settings.reportPath != "")
+	{
+		writeJsonReport();
+		writeJUnitReport();
+	}
+
+	int failures = 0, slower = 0;
+	for(const fileRun & run : _runs)
+	{
+		if(run.exitCode != 0)					failures++;
+		if(run.slowerThanBaseline.size() > 0)	slower++;
+	}
+
+	if(failures > 0)
+	{
+		std::cerr << "Finished running test, " << failures << " out of " << _runs.size() << " jasp files FAILED!" << std::endl;
+		return 1;
+	}
+
+	if(slower > 0)
+	{
+		std::cerr << "All " << _runs.size() << " jasp files succeeded, but " << slower << " of them got slower than the baseline!" << std::endl;
+		return 3;
+	}
+
+	std::cout << "All " << _runs.size() << " jasp files succeeded in refreshing and displaying the same data afterwards!" << std::endl;
+	return 0;
+}
+
+void testRunner::start(fileRun & run)
+{
+	QStringList arguments({"--unitTest", run.file});
+
+	if(_settings.save)
+		arguments << "--save";
+
+	arguments << QString::fromStdString("--timeOut="+std::to_string(_settings.timeOut));
+	arguments << "-platform" << "minimal";
+
+	std::cout << "Starting subJASP with args: " << arguments.join(' ').toStdString() << std::endl;
+
+	run.process = new QProcess();
+	run.process->setProgram(_jaspExecutable);
+	run.process->setArguments(arguments);
+	run.process->start();
+	run.timer.start();
+}
+
+void testRunner::finish(fileRun & run)
+{
+	run.wallMs		= run.timer.elapsed();
+	run.exitCode	= run.timedOut ? 2 : run.process->exitStatus() == QProcess::NormalExit && run.process->error() != QProcess::FailedToStart ? run.process->exitCode() : -1;
+
+	const QString prefix(compareResults::timingsPrefix);
+
+	for(const QString & line : QString::fromUtf8(run.process->readAllStandardOutput()).split('\n'))
+		if(line.startsWith(prefix))
+			run.timings = QJsonDocument::fromJson(line.mid(prefix.size()).trimmed().toUtf8()).object();
+
+	std::cerr << run.process->readAllStandardError().toStdString() << std::endl;
+	std::cout << "JASP file " << run.file.toStdString() << (run.exitCode == 0 ? " succeeded!" : run.timedOut ? " timed out!" : " failed!") << " (" << run.wallMs << "ms)" << std::endl;
+
+	delete run.process;
+	run.process = nullptr;
+}
+
+void testRunner::compareToBaseline()
+{
+	QFile baselineFile(_settings.baselinePath);
+
+	if(!baselineFile.open(QIODevice::ReadOnly))
+	{
+		std::cerr << "Could not read baseline " << _settings.baselinePath.toStdString() << ", so timings are not compared." << std::endl;
+		return;
+	}
+
+	QJsonObject baselineReport = QJsonDocument::fromJson(baselineFile.readAll()).object();
+
+	// The wall times depend heavily on how many sub-JASPs were competing for the cores, so they are only comparable with the same number of them.
+	int baselineJobs = baselineReport["jobs"].toInt(0);
+
+	if(baselineJobs != int(_jobs))
+	{
+		std::cerr << "Baseline " << _settings.baselinePath.toStdString() << " was made with " << (baselineJobs > 0 ? std::to_string(baselineJobs) : "an unknown number of") << " sub-JASPs at the same time instead of " << _jobs << ", so timings are not compared. Pass the same --jobs to compare them." << std::endl;
+		return;
+	}
+
+	std::map<QString, QJsonObject> baseline;
+
+	for(const QJsonValue & file : baselineReport["files"].toArray())
+		baseline[file.toObject()["file"].toString()] = file.toObject();
+
+	const double factor = 1.0 + (_settings.perfTolerance / 100.0);
+
+	auto slower = [&](double now, double before, qint64 minimumMs)
+	{
+		return before >= 0 && now >= 0 && now > before * factor && now - before > minimumMs;
+	};
+
+	auto describe = [](const QString & what, double now, double before)
+	{
+		return what + " took " + QString::number(qint64(now)) + "ms instead of " + QString::number(qint64(before)) + "ms";
+	};
+
+	for(fileRun & run : _runs)
+	{
+		auto found = baseline.find(relativePath(run.file));
+
+		if(run.exitCode != 0 || found == baseline.end() || !found->second["passed"].toBool())
+			continue;
+
+		const QJsonObject & before = found->second;
+
+		if(slower(run.wallMs, before["wallMs"].toDouble(-1), minimumFileSlowerMs))
+			run.slowerThanBaseline << describe("Testing the file", run.wallMs, before["wallMs"].toDouble());
+
+		if(slower(run.timings["dataLoadMs"].toDouble(-1), before["dataLoadMs"].toDouble(-1), minimumFileSlowerMs))
+			run.slowerThanBaseline << describe("Loading the data", run.timings["dataLoadMs"].toDouble(), before["dataLoadMs"].toDouble());
+
+		std::map<QString, QJsonObject> analysesBefore;
+		for(const QJsonValue & analysis : before["analyses"].toArray())
+			analysesBefore[QString::number(analysis.toObject()["id"].toInt()) + analysis.toObject()["name"].toString()] = analysis.toObject();
+
+		for(const QJsonValue & analysisValue : run.timings["analyses"].toArray())
+		{
+			QJsonObject	analysis	= analysisValue.toObject();
+			auto		analysisWas	= analysesBefore.find(QString::number(analysis["id"].toInt()) + analysis["name"].toString());
+
+			if(analysisWas != analysesBefore.end() && slower(analysis["wallMs"].toDouble(-1), analysisWas->second["wallMs"].toDouble(-1), minimumAnalysisSlowerMs))
+				run.slowerThanBaseline << describe("Analysis #" + QString::number(analysis["id"].toInt()) + " " + analysis["name"].toString(), analysis["wallMs"].toDouble(), analysisWas->second["wallMs"].toDouble());
+		}
+
+		for(const QString & slowerThing : run.slowerThanBaseline)
+			std::cerr << "JASP file " << run.file.toStdString() << ": " << slowerThing.toStdString() << std::endl;
+	}
+}
+
+void testRunner::writeJsonReport() const
+{
+	QJsonArray files;
+
+	for(const fileRun & run : _runs)
+	{
+		QJsonObject file;
+
+		file["file"]				= relativePath(run.file);
+		file["passed"]				= run.exitCode == 0;
+		file["exitCode"]			= run.exitCode;
+		file["timedOut"]			= run.timedOut;
+		file["wallMs"]				= double(run.wallMs);
+		file["dataLoadMs"]			= run.timings["dataLoadMs"].toDouble(-1);
+		file["analyses"]			= run.timings["analyses"].toArray();
+		file["slowerThanBaseline"]	= QJsonArray::fromStringList(run.slowerThanBaseline);
+
+		files.append(file);
+	}
+
+	QJsonObject report;
+
+	report["folder"]	= _folder;
+	report["timestamp"]	= QDateTime::currentDateTime().toString(Qt::ISODate);
+	report["totalMs"]	= double(_timer.elapsed());
+	report["jobs"]		= int(_jobs);
+	report["files"]		= files;
+
+	QFile reportFile(_settings.reportPath);
+
+	if(!reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		std::cerr << "Could not write report to " << _settings.reportPath.toStdString() << std::endl;
+		return;
+	}
+
+	reportFile.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+}
+
+void testRunner::writeJUnitReport() const
+{
+	QFileInfo	reportInfo(_settings.reportPath);
+	QString		junitPath = reportInfo.dir().filePath(reportInfo.completeBaseName() + ".xml");
+	QFile		junitFile(junitPath);
+
+	if(!junitFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		std::cerr << "Could not write JUnit report to " << junitPath.toStdString() << std::endl;
+		return;
+	}
+
+	int failures = 0;
+	for(const fileRun & run : _runs)
+		if(run.exitCode != 0 || run.slowerThanBaseline.size() > 0)
+			failures++;
+
+	auto seconds = [](double ms) { return QString::number(ms / 1000.0, 'f', 3); };
+
+	QXmlStreamWriter xml(&junitFile);
+	xml.setAutoFormatting(true);
+	xml.writeStartDocument();
+
+	xml.writeStartElement("testsuite");
+	xml.writeAttribute("name",		"unitTestRecursive");
+	xml.writeAttribute("tests",		QString::number(_runs.size()));
+	xml.writeAttribute("failures",	QString::number(failures));
+	xml.writeAttribute("time",		seconds(_timer.elapsed()));
+
+	for(const fileRun & run : _runs)
+	{
+		QString		relative	= relativePath(run.file),
+					folder		= QFileInfo(relative).path();
+
+		xml.writeStartElement("testcase");
+		xml.writeAttribute("classname",	folder == "." ? "jasp" : folder.replace('/', '.'));
+		xml.writeAttribute("name",		QFileInfo(relative).fileName());
+		xml.writeAttribute("time",		seconds(run.wallMs));
+
+		if(run.exitCode != 0)
+		{
+			xml.writeStartElement("failure");
+			xml.writeAttribute("message", run.timedOut ? "Timed out" : "Exited with code " + QString::number(run.exitCode));
+			xml.writeEndElement();
+		}
+		else if(run.slowerThanBaseline.size() > 0)
+		{
+			xml.writeStartElement("failure");
+			xml.writeAttribute("type",		"performance");
+			xml.writeAttribute("message",	"Slower than the baseline");
+			xml.writeCharacters(run.slowerThanBaseline.join('\n'));
+			xml.writeEndElement();
+		}
+
+		QStringList timings({ "Loading the data took " + QString::number(run.timings["dataLoadMs"].toDouble(-1)) + "ms" });
+		for(const QJsonValue & analysisValue : run.timings["analyses"].toArray())
+		{
+			QJsonObject analysis = analysisValue.toObject();
+			timings << "Analysis #" + QString::number(analysis["id"].toInt()) + " " + analysis["name"].toString() + ": " + QString::number(analysis["wallMs"].toDouble()) + "ms, of which " + QString::number(analysis["engineMs"].toDouble()) + "ms in jaspEngine";
+		}
+
+		xml.writeTextElement("system-out", timings.join('\n'));
+
+		xml.writeEndElement(); // testcase
+	}
+
+	xml.writeEndElement(); // testsuite
+	xml.writeEndDocument();
+}
+
+}
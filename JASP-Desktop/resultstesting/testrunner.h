@@ -0,0 +1,68 @@
+#ifndef TESTRUNNER_H
+#define TESTRUNNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QProcess>
+#include <QElapsedTimer>
+#include <vector>
+
+namespace resultXmlCompare
+{
+
+///What --unitTestRecursive was asked to do besides testing the files
+struct testRunnerSettings
+{
+	int		jobs			= 0,	///< Number of sub-JASPs at the same time, 0 means as many as the cores and memory allow
+			memoryPerJobMB	= 2048,	///< How much memory a sub-JASP with its jaspEngines is expected to need, when jobs is 0
+			timeOut			= 10;	///< In minutes, per file
+	bool	save			= false;
+	double	perfTolerance	= 25;	///< How many percent slower than the baseline a file or analysis may get before it is flagged
+	QString	reportPath,				///< Where to write the json report, a JUnit xml report is written next to it
+			baselinePath;			///< Earlier json report to compare the timings to
+};
+
+///Runs a --unitTest sub-JASP for every .jasp file under a folder, a number of them at the same time, and collects their results and timings in a report.
+class testRunner
+{
+public:
+	testRunner(const QString & jaspExecutable, const testRunnerSettings & settings);
+
+	///Returns the exitcode for --unitTestRecursive: 0 when all succeeded, 1 on failures, 2 when there were no files and 3 when the only problem is that things got slower.
+	int		run(const QString & folder);
+
+	static int	defaultJobs(int memoryPerJobMB);
+
+private:
+	struct fileRun
+	{
+		QString			file;
+		QProcess	*	process		= nullptr;
+		QElapsedTimer	timer;
+		int				exitCode	= -1;
+		bool			timedOut	= false;
+		qint64			wallMs		= 0;
+		QJsonObject		timings;
+		QStringList		slowerThanBaseline;
+	};
+
+	void		collectFiles(const QString & path);
+	void		start(fileRun & run);
+	void		finish(fileRun & run);
+	void		compareToBaseline();
+	void		writeJsonReport()	const;
+	void		writeJUnitReport()	const;
+	QString		relativePath(const QString & file) const;
+
+	QString					_jaspExecutable,
+							_folder;
+	testRunnerSettings		_settings;
+	std::vector<fileRun>	_runs;
+	QElapsedTimer			_timer;
+	size_t					_jobs		= 1;
+};
+
+}
+
+#endif // TESTRUNNER_H
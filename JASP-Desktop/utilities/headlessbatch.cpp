@@ -0,0 +1,506 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#include "headlessbatch.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QQmlEngine>
+#include <QQmlContext>
+#include <QQmlComponent>
+#include <iostream>
+
+#include "analysis/analyses.h"
+#include "data/datasetloader.h"
+#include "data/datasetpackage.h"
+#include "data/exporters/jaspexporter.h"
+#include "engine/enginesync.h"
+#include "gui/preferencesmodel.h"
+#include "mainwindow.h"
+#include "modules/dynamicmodules.h"
+#include "modules/ribbonmodel.h"
+#include "utilities/qutils.h"
+#include "utilities/settings.h"
+#include "processinfo.h"
+#include "tempfiles.h"
+#include "fastjson.h"
+#include "appinfo.h"
+#include "utils.h"
+#include "log.h"
+
+HeadlessBatch::HeadlessBatch(const headlessBatchSettings & settings, QObject * parent)
+	: QObject(parent), _settings(settings)
+{
+	TempFiles::init(ProcessInfo::currentPID());
+
+	_package		= new DataSetPackage();
+	_dynamicModules	= new DynamicModules(this);
+	_analyses		= new Analyses(this, _dynamicModules);
+	_ribbonModel	= new RibbonModel(_dynamicModules, RibbonModel::defaultCommonModules, RibbonModel::defaultExtraModules);
+	_engineSync		= new EngineSync(_analyses, _package, _dynamicModules, this);
+	_preferences	= new PreferencesModel(this);
+	_qml			= new QQmlEngine(this);
+
+	MainWindow::registerQmlTypes();
+	MainWindow::setFormContextProperties(_qml->rootContext());
+	_qml->rootContext()->setContextProperty("preferencesModel", _preferences);
+	_qml->addImportPath("qrc:///components");
+
+	connect(_analyses,		&Analyses::analysisResultsChanged,	this,	&HeadlessBatch::analysisResultsChanged	);
+	connect(_engineSync,	&EngineSync::engineTerminated,		this,	&HeadlessBatch::engineTerminated		);
+}
+
+HeadlessBatch::~HeadlessBatch()
+{
+	delete _engineSync;
+
+	if (_package->dataSet() != nullptr)
+		DataSetLoader::freeDataSet(_package->dataSet());
+
+	_package->reset();
+	delete _package;
+}
+
+void HeadlessBatch::start()
+{
+	_timer.start();
+
+	QString missingValues = Settings::value(Settings::MISSING_VALUES_LIST).toString();
+	if (missingValues != "")
+		Utils::setEmptyValues(fromQstringToStdVector(missingValues, "|"));
+
+	// The jaspEngines start up while the data is being read.
+	_engineSync->start(Settings::value(Settings::PPI_USE_DEFAULT).toBool() ? 96 : Settings::value(Settings::PPI_CUSTOM_VALUE).toInt());
+
+	if (!loadData() || !addAnalysesFromPackage() || !addAnalysesFromSpec())
+	{
+		finish(3);
+		return;
+	}
+
+	if (_analyses->count() == 0)
+	{
+		std::cerr << "There are no analyses to run in " << _settings.inputPath.toStdString() << ", add some with --analyses=" << std::endl;
+		finish(3);
+		return;
+	}
+
+	Log::log() << "Loaded " << _settings.inputPath.toStdString() << " in " << _timer.elapsed() << "ms, running " << _analyses->count() << " analyses." << std::endl;
+
+	QTimer::singleShot(60000 * _settings.timeOut, this, &HeadlessBatch::timeOut);
+
+	// The forms bind to their analyses in a singleShot once they are completed, so run the analyses after that.
+	QTimer::singleShot(0, this, &HeadlessBatch::runAnalyses);
+}
+
+void HeadlessBatch::runAnalyses()
+{
+	bool allBound = true;
+
+	_analyses->applyToAll([&](Analysis * analysis)
+	{
+		if (analysis->form() == nullptr)
+		{
+			std::cerr << "The form of analysis " << analysis->name() << " did not bind to it!" << std::endl;
+			allBound = false;
+		}
+	});
+
+	if (!allBound)
+	{
+		finish(3);
+		return;
+	}
+
+	// New analyses are already Empty and get picked up by EngineSync, the others only have their options until now.
+	_analyses->applyToAll([&](Analysis * analysis)
+	{
+		if (analysis->isFinished())
+			analysis->refresh();
+	});
+}
+
+bool HeadlessBatch::loadData()
+{
+	try
+	{
+		std::string path = fq(_settings.inputPath);
+
+		DataSetLoader::loadPackage(_package, path, "");
+
+		_package->setId(path);
+
+		if (!_settings.inputPath.endsWith(".jasp"))
+		{
+			_package->setDataFilePath(path);
+			_package->setDataFileTimestamp(QFileInfo(_settings.inputPath).lastModified().toTime_t());
+		}
+	}
+	catch (std::exception & e)
+	{
+		std::cerr << "Could not load " << _settings.inputPath.toStdString() << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	_analyses->setDataSet(_package->dataSet());
+
+	return true;
+}
+
+bool HeadlessBatch::addAnalysesFromPackage()
+{
+	if (!_package->hasAnalyses())
+		return true;
+
+	Json::Value analysesData		= _package->analysesData(),
+				analysesDataList	= analysesData.isArray() ? analysesData : analysesData.get("analyses", Json::arrayValue);
+
+	for (Json::Value & analysisData : analysesDataList)
+	{
+		Analysis * analysis = nullptr;
+
+		try
+		{
+			analysis = _analyses->createFromJaspFileEntry(analysisData, _ribbonModel);
+		}
+		catch (std::exception & e)
+		{
+			std::cerr << "Could not load analysis from " << _settings.inputPath.toStdString() << ": " << e.what() << std::endl;
+			return false;
+		}
+
+		if (!createForm(analysis))
+			return false;
+	}
+
+	return true;
+}
+
+bool HeadlessBatch::addAnalysesFromSpec()
+{
+	if (_settings.analysesPath == "")
+		return true;
+
+	QFile specFile(_settings.analysesPath);
+	Json::Value spec;
+
+	if (!specFile.open(QIODevice::ReadOnly) || !fastJson::parse(specFile.readAll().toStdString(), spec))
+	{
+		std::cerr << "Could not read analyses from " << _settings.analysesPath.toStdString() << std::endl;
+		return false;
+	}
+
+	if (spec.isObject())
+		spec = spec.get("analyses", Json::arrayValue);
+
+	for (Json::Value & analysisSpec : spec)
+	{
+		QString	name	= tq(analysisSpec.get("name", "").asString()),
+				module	= tq(analysisSpec.get("module", "").asString()),
+				title	= tq(analysisSpec.get("title", "").asString());
+
+		if (name == "")
+		{
+			std::cerr << "An analysis in " << _settings.analysesPath.toStdString() << " has no name!" << std::endl;
+			return false;
+		}
+
+		if (module == "")
+			module = _ribbonModel->getModuleNameFromAnalysisName(name);
+
+		if (title == "")
+		{
+			auto * analysisEntry = _ribbonModel->getAnalysis(module.toStdString(), name.toStdString());
+			title = analysisEntry ? tq(analysisEntry->title()) : name;
+		}
+
+		Json::Value options = analysisSpec.get("options", Json::objectValue);
+
+		if (!createForm(_analyses->create(module, name, title, &options)))
+			return false;
+	}
+
+	return true;
+}
+
+///The form is what fills in the defaults of the options that were not given and whether the analysis uses jaspResults, it does so in the same way as in the GUI because it is the same QML.
+bool HeadlessBatch::createForm(Analysis * analysis)
+{
+	QQmlContext * context = new QQmlContext(_qml->rootContext(), _qml);
+	context->setContextProperty("myAnalysis", analysis);
+
+	QQmlComponent	component(_qml, QUrl(tq(analysis->qmlFormPath())));
+	QObject		*	form = component.create(context);
+
+	if (form == nullptr)
+	{
+		std::cerr << "Could not create the form of analysis " << analysis->name() << ":\n" << component.errorString().toStdString() << std::endl;
+		return false;
+	}
+
+	form->setParent(analysis);
+
+	return true;
+}
+
+void HeadlessBatch::analysisResultsChanged(Analysis *)
+{
+	if (_finished)
+		return;
+
+	bool allFinished	= true,
+		 anyFailed		= false;
+
+	_analyses->applyToAll([&](Analysis * analysis)
+	{
+		if (!analysis->isFinished())						allFinished = false;
+		else if (analysis->status() != Analysis::Complete)	anyFailed	= true;
+	});
+
+	if (allFinished)
+		finish(anyFailed ? 1 : 0);
+}
+
+void HeadlessBatch::engineTerminated()
+{
+	std::cerr << "A jaspEngine terminated unexpectedly!" << std::endl;
+	finish(3);
+}
+
+void HeadlessBatch::timeOut()
+{
+	std::cerr << "Time out for running the analyses!" << std::endl;
+	finish(2);
+}
+
+void HeadlessBatch::finish(int exitCode)
+{
+	if (_finished)
+		return;
+
+	_finished = true;
+
+	_analyses->applyToAll([&](Analysis * analysis)
+	{
+		std::string status;
+
+		switch (analysis->status())
+		{
+		case Analysis::Complete:		status = "complete";			break;
+		case Analysis::ValidationError:	status = "validation error";	break;
+		case Analysis::FatalError:		status = "fatal error";			break;
+		default:						status = "not finished";		break;
+		}
+
+		std::cout << "Analysis #" << analysis->id() << " " << analysis->name() << ": " << status << " (" << analysis->msInEngine() << "ms in jaspEngine)" << std::endl;
+	});
+
+	if ((_settings.resultsJson != "" && !writeResultsJson()) ||
+		(_settings.resultsHtml != "" && !writeResultsHtml()) ||
+		(_settings.saveAs      != "" && !saveJasp()))
+		exitCode = exitCode == 0 ? 1 : exitCode;
+
+	std::cout << "Batch of " << _settings.inputPath.toStdString() << " finished in " << _timer.elapsed() << "ms." << std::endl;
+
+	QCoreApplication::exit(exitCode);
+}
+
+Json::Value HeadlessBatch::analysesData() const
+{
+	Json::Value analysesData(Json::objectValue);
+
+	analysesData["analyses"] = _analyses->asJson();
+
+	if (_package->analysesData().isObject() && _package->analysesData().isMember("meta"))
+		analysesData["meta"] = _package->analysesData()["meta"];
+
+	return analysesData;
+}
+
+bool HeadlessBatch::writeResultsJson() const
+{
+	QFile file(_settings.resultsJson);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		std::cerr << "Could not write results to " << _settings.resultsJson.toStdString() << std::endl;
+		return false;
+	}
+
+	std::string json = fastJson::write(analysesData());
+	return file.write(json.data(), qint64(json.size())) == qint64(json.size());
+}
+
+bool HeadlessBatch::writeResultsHtml() const
+{
+	QFile file(_settings.resultsHtml);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		std::cerr << "Could not write results to " << _settings.resultsHtml.toStdString() << std::endl;
+		return false;
+	}
+
+	std::string html = resultsAsHtml();
+	return file.write(html.data(), qint64(html.size())) == qint64(html.size());
+}
+
+bool HeadlessBatch::saveJasp() const
+{
+	std::string path		= fq(_settings.saveAs),
+				tempPath	= path + ".tmp";
+
+	_package->setAnalysesData(analysesData());
+	_package->setAnalysesHTML(resultsAsHtml());
+	_package->setAnalysesHTMLReady();
+
+	try
+	{
+		JASPExporter().saveDataSet(tempPath, _package, [](const std::string &, int) {});
+
+		if (!Utils::renameOverwrite(tempPath, path))
+			throw std::runtime_error("File '" + path + "' is being used by another application.");
+	}
+	catch (std::exception & e)
+	{
+		Utils::removeFile(tempPath);
+		std::cerr << "Could not save " << path << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+static std::string escapeHtml(const std::string & text)
+{
+	return fq(tq(text).toHtmlEscaped());
+}
+
+///The results page renders through javascript, this is a plain version of it with the tables and the plots embedded, good enough to read the output of a batch.
+std::string HeadlessBatch::resultsAsHtml() const
+{
+	std::string html = "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>" + escapeHtml(fq(QFileInfo(_settings.inputPath).fileName())) + "</title></head><body>\n";
+
+	_analyses->applyToAll([&](Analysis * analysis)
+	{
+		html += "<div class=\"jasp-analysis\" id=\"id-" + std::to_string(analysis->id()) + "\">\n<h1>" + escapeHtml(analysis->title()) + "</h1>\n";
+		renderResults(analysis->results(), html, 0);
+		html += "</div>\n";
+	});
+
+	html += "</body></html>\n";
+
+	return html;
+}
+
+void HeadlessBatch::renderResults(const Json::Value & results, std::string & html, int depth)
+{
+	if (results.isArray())
+	{
+		for (const Json::Value & element : results)
+			renderResults(element, html, depth);
+		return;
+	}
+
+	if (!results.isObject())
+		return;
+
+	if (results.isMember("schema") && results.isMember("data"))
+	{
+		renderTable(results, html);
+		return;
+	}
+
+	if (results.get("data", Json::nullValue).isString() && results.isMember("width"))
+	{
+		renderImage(results, html);
+		return;
+	}
+
+	std::string heading = "h" + std::to_string(std::min(depth + 2, 6));
+
+	if (depth > 0 && results.get("title", "").asString() != "")
+		html += "<" + heading + ">" + escapeHtml(results["title"].asString()) + "</" + heading + ">\n";
+
+	if (results.get("error", Json::nullValue).isObject())
+		html += "<p class=\"error\">" + escapeHtml(results["error"].get("errorMessage", "").asString()) + "</p>\n";
+
+	const Json::Value & children = results.get("collection", Json::nullValue).isObject() ? results["collection"] : results;
+
+	for (Json::Value::const_iterator child = children.begin(); child != children.end(); ++child)
+		if (child.memberName()[0] != '.' && (child->isObject() || child->isArray()))
+			renderResults(*child, html, depth + 1);
+}
+
+void HeadlessBatch::renderTable(const Json::Value & table, std::string & html)
+{
+	auto cellText = [](const Json::Value & cell) -> std::string
+	{
+		switch (cell.type())
+		{
+		case Json::nullValue:		return "";
+		case Json::stringValue:		return cell.asString();
+		case Json::realValue:		return fq(QString::number(cell.asDouble(), 'g', 5));
+		case Json::intValue:
+		case Json::uintValue:
+		case Json::booleanValue:	return fastJson::write(cell);
+		default:					return fastJson::write(cell.get("value", cell));
+		}
+	};
+
+	const Json::Value & fields = table["schema"].get("fields", Json::arrayValue);
+
+	html += "<table>\n<caption>" + escapeHtml(table.get("title", "").asString()) + "</caption>\n<tr>";
+
+	for (const Json::Value & field : fields)
+		html += "<th>" + escapeHtml(field.get("title", field.get("name", "")).asString()) + "</th>";
+
+	html += "</tr>\n";
+
+	for (const Json::Value & row : table["data"])
+	{
+		html += "<tr>";
+
+		for (const Json::Value & field : fields)
+			html += "<td>" + escapeHtml(cellText(row.get(field.get("name", "").asString(), Json::nullValue))) + "</td>";
+
+		html += "</tr>\n";
+	}
+
+	html += "</table>\n";
+}
+
+void HeadlessBatch::renderImage(const Json::Value & image, std::string & html)
+{
+	QString	relativePath	= tq(image["data"].asString());
+	QFile	file(tq(TempFiles::sessionDirName()) + "/" + relativePath);
+
+	html += "<h3>" + escapeHtml(image.get("title", "").asString()) + "</h3>\n";
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		html += "<p>Plot " + escapeHtml(fq(relativePath)) + " is missing.</p>\n";
+		return;
+	}
+
+	std::string mime = relativePath.endsWith(".svg") ? "image/svg+xml" : "image/png";
+
+	html += "<img width=\"" + std::to_string(image["width"].asInt()) + "\" height=\"" + std::to_string(image.get("height", 0).asInt()) + "\" src=\"data:" + mime + ";base64," + file.readAll().toBase64().toStdString() + "\">\n";
+}
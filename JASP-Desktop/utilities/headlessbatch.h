@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#ifndef HEADLESSBATCH_H
+#define HEADLESSBATCH_H
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include "jsonredirect.h"
+
+class Analysis;
+class Analyses;
+class DataSetPackage;
+class DynamicModules;
+class EngineSync;
+class PreferencesModel;
+class QQmlEngine;
+class RibbonModel;
+
+struct headlessBatchSettings
+{
+	QString	inputPath,		///< A data file or a .jasp file
+			analysesPath,	///< Json with analyses to add: [{ "name": "Descriptives", "module": "Descriptives", "title": "", "options": {...} }]
+			resultsJson,
+			resultsHtml,
+			saveAs;			///< Where to save the updated .jasp
+	int		timeOut	= 10;	///< In minutes
+};
+
+///Loads a data file or .jasp and runs its analyses on the jaspEngines without a MainWindow, so without windows, ResultsJsInterface or WebEngine.
+///The forms of the analyses are created as in the GUI, just never shown, so the options get the same defaults.
+///The results are written as json, as a plain html rendering of the tables and plots and/or as a new .jasp, after which the application exits.
+class HeadlessBatch : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit HeadlessBatch(const headlessBatchSettings & settings, QObject * parent = nullptr);
+	~HeadlessBatch() override;
+
+public slots:
+	void start();
+
+private slots:
+	void runAnalyses();
+	void analysisResultsChanged(Analysis * analysis);
+	void engineTerminated();
+	void timeOut();
+
+private:
+	bool		loadData();
+	bool		addAnalysesFromPackage();
+	bool		addAnalysesFromSpec();
+	bool		createForm(Analysis * analysis);
+	void		finish(int exitCode);
+
+	bool		writeResultsJson()	const;
+	bool		writeResultsHtml()	const;
+	bool		saveJasp()			const;
+	Json::Value	analysesData()		const;
+	std::string	resultsAsHtml()		const;
+
+	static void	renderResults(const Json::Value & results, std::string & html, int depth);
+	static void	renderTable(const Json::Value & table, std::string & html);
+	static void	renderImage(const Json::Value & image, std::string & html);
+
+	headlessBatchSettings	_settings;
+	DataSetPackage		*	_package		= nullptr;
+	DynamicModules		*	_dynamicModules	= nullptr;
+	Analyses			*	_analyses		= nullptr;
+	RibbonModel			*	_ribbonModel	= nullptr;
+	EngineSync			*	_engineSync		= nullptr;
+	PreferencesModel	*	_preferences	= nullptr;
+	QQmlEngine			*	_qml			= nullptr;
+	bool					_finished		= false;
+	QElapsedTimer			_timer;
+};
+
+#endif // HEADLESSBATCH_H
@@ -0,0 +1,60 @@
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <list>
+#include <unordered_map>
+
+/* A fixed size cache that forgets the least recently used entry when it gets full.
+ * Both find and insert are constant time, find also marks the entry as recently used.
+ */
+template<typename Key, typename Value>
+class LRUCache
+{
+	typedef std::pair<Key, Value>						Entry;
+	typedef typename std::list<Entry>::iterator			EntryIt;
+
+public:
+	explicit LRUCache(size_t capacity) : _capacity(capacity) {}
+
+	Value * find(const Key & key)
+	{
+		auto found = _lookup.find(key);
+
+		if(found == _lookup.end())
+			return nullptr;
+
+		_entries.splice(_entries.begin(), _entries, found->second); //move to front, iterators stay valid
+		return &found->second->second;
+	}
+
+	void insert(const Key & key, const Value & value)
+	{
+		auto found = _lookup.find(key);
+
+		if(found != _lookup.end())
+		{
+			found->second->second = value;
+			_entries.splice(_entries.begin(), _entries, found->second);
+			return;
+		}
+
+		if(_entries.size() >= _capacity)
+		{
+			_lookup.erase(_entries.back().first);
+			_entries.pop_back();
+		}
+
+		_entries.emplace_front(key, value);
+		_lookup[key] = _entries.begin();
+	}
+
+	void	clear()			{ _entries.clear(); _lookup.clear(); }
+	size_t	size() const	{ return _entries.size(); }
+
+private:
+	size_t								_capacity;
+	std::list<Entry>					_entries;	//most recently used first
+	std::unordered_map<Key, EntryIt>	_lookup;
+};
+
+#endif // LRUCACHE_H
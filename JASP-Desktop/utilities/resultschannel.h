@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as
+// published by the Free Software Foundation, either version 3 of the
+// License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public
+// License along with this program.  If not, see
+// <http://www.gnu.org/licenses/>.
+//
+
+#ifndef RESULTSCHANNEL_H
+#define RESULTSCHANNEL_H
+
+#include <QObject>
+#include <QString>
+#include <QJsonObject>
+
+/// The only object ResultsJsInterface puts on the webchannel of the results page, so the page can listen to these signals and call nothing else through it.
+/// Everything that concerns the analyses in the results is sent through here, that way it arrives in the order it was sent, which runJavaScript does not promise relative to the webchannel.
+class ResultsChannel : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit ResultsChannel(QObject *parent = nullptr) : QObject(parent) {}
+
+signals:
+	void analysisChanged(		QJsonObject analysis);
+	void analysisImageEdited(	int id, QJsonObject image);
+	void analysisProgress(		int id, int progress);
+	void select(				int id);
+	void unselect();
+	void changeTitle(			int id, QString title);
+	void remove(				int id);
+	void removeAllAnalyses();
+	void exportHTML(			QString filename);
+	void setResultsMeta(		QJsonObject resultsMeta);
+	void getResultsMeta();
+	void getAllUserData();
+};
+
+#endif // RESULTSCHANNEL_H
@@ -30,18 +30,25 @@
 #include "appinfo.h"
 #include "tempfiles.h"
 #include <functional>
+#include <algorithm>
 #include "timers.h"
 #include "utilities/settings.h"
 #include <QMimeData>
 #include <QAction>
 #include "gui/messageforwarder.h"
 #include <QApplication>
+#include <QJsonDocument>
+#include "fastjson.h"
 
 ResultsJsInterface::ResultsJsInterface(QObject *parent) : QObject(parent)
 {
 	connect(this, &ResultsJsInterface::welcomeScreenIsCleared,	this, &ResultsJsInterface::welcomeScreenIsClearedHandler);
 	connect(this, &ResultsJsInterface::zoomChanged,				this, &ResultsJsInterface::setZoomInWebEngine);
 
+	_changedAnalysesTimer.setSingleShot(true);
+	_changedAnalysesTimer.setInterval(16);
+	connect(&_changedAnalysesTimer, &QTimer::timeout,			this, &ResultsJsInterface::flushChangedAnalyses);
+
 	setZoom(Settings::value(Settings::UI_SCALE).toDouble());
 }
 
@@ -82,6 +89,11 @@ void ResultsJsInterface::purgeClipboard()
 	TempFiles::purgeClipboard();
 }
 
+void ResultsJsInterface::registerOnWebChannel(QQmlWebChannel * channel)
+{
+	channel->registerObject("results", &_resultsChannel);
+}
+
 void ResultsJsInterface::setExactPValuesHandler(bool exact)
 {
 	emit runJavaScript("window.globSet.pExact = " + QString(exact ? "true" : "false") + "; window.reRenderAnalyses();");
@@ -125,13 +137,9 @@ void ResultsJsInterface::saveTempImage(int id, QString path, QByteArray data)
 
 void ResultsJsInterface::analysisImageEditedHandler(Analysis *analysis)
 {
-	Json::Value imgJson = analysis->getImgResults();
-	QString	results = tq(imgJson.toStyledString());
-	results = escapeJavascriptString(results);
-	results = "window.modifySelectedImage(" + QString::number(analysis->id()) + ", JSON.parse('" + results + "'));";
-	emit runJavaScript(results);
+	flushChangedAnalyses();
 
-    return;
+	emit _resultsChannel.analysisImageEdited(analysis->id(), toQJsonObject(analysis->getImgResults()));
 }
 
 void ResultsJsInterface::menuHidding()
@@ -207,37 +215,74 @@ void ResultsJsInterface::displayMessageFromResults(QString msg)
 
 void ResultsJsInterface::changeTitle(Analysis *analysis)
 {
-    int id = analysis->id();
-    QString title = analysis->titleQ();
-
-    emit runJavaScript("window.changeTitle(" + QString::number(id) + ", '" + escapeJavascriptString(title) + "')");
+	flushChangedAnalyses();
+	emit _resultsChannel.changeTitle(analysis->id(), analysis->titleQ());
 }
 
 void ResultsJsInterface::showAnalysis(int id)
 {
-	emit runJavaScript("window.select(" % QString::number(id) % ")");
+	flushChangedAnalyses();
+	emit _resultsChannel.select(id);
 }
 
 void ResultsJsInterface::exportSelected(const QString &filename)
 {
-	emit runJavaScript("window.exportHTML('" + filename + "');");
+	flushChangedAnalyses();
+	emit _resultsChannel.exportHTML(filename);
 }
 
 void ResultsJsInterface::analysisChanged(Analysis *analysis)
 {
-	Json::Value analysisJson	= analysis->asJSON();
-	analysisJson["userdata"]	= analysis->userData();
-	QString results				= tq(analysisJson.toStyledString());
-	results						= "window.analysisChanged(JSON.parse('" + escapeJavascriptString(results) + "'));";
+	if (_changedAnalyses.count(analysis->id()) == 0)
+		_changedAnalysesOrder.push_back(analysis->id());
+
+	_changedAnalyses[analysis->id()] = analysis;
+
+	if (!_changedAnalysesTimer.isActive())
+		_changedAnalysesTimer.start();
+}
+
+void ResultsJsInterface::analysisProgressChanged(Analysis *analysis)
+{
+	if (_changedAnalyses.count(analysis->id()) > 0) //It is about to be sent in full and that includes the progress
+		return;
+
+	emit _resultsChannel.analysisProgress(analysis->id(), analysis->progress());
+}
+
+void ResultsJsInterface::flushChangedAnalyses()
+{
+	_changedAnalysesTimer.stop();
+
+	std::vector<int>					order;
+	std::map<int, QPointer<Analysis>>	changed;
+
+	order.swap(_changedAnalysesOrder);
+	changed.swap(_changedAnalyses);
+
+	for (int id : order)
+	{
+		Analysis * analysis = changed[id];
+
+		if (analysis == nullptr)
+			continue;
+
+		Json::Value analysisJson	= analysis->asJSON();
+		analysisJson["userdata"]	= analysis->userData();
 
-	emit runJavaScript(results);
+		emit _resultsChannel.analysisChanged(toQJsonObject(analysisJson));
+	}
+}
+
+QJsonObject ResultsJsInterface::toQJsonObject(const Json::Value &json)
+{
+	return QJsonDocument::fromJson(QByteArray::fromStdString(fastJson::write(json))).object();
 }
 
 void ResultsJsInterface::setResultsMeta(QString str)
 {
-	QString results = escapeJavascriptString(str);
-	results = "window.setResultsMeta(JSON.parse('" + results + "'));";
-	emit runJavaScript(results);
+	flushChangedAnalyses();
+	emit _resultsChannel.setResultsMeta(QJsonDocument::fromJson(str.toUtf8()).object());
 }
 
 void ResultsJsInterface::clearWelcomeScreen(bool callDelayedLoad)
@@ -247,6 +292,10 @@ void ResultsJsInterface::clearWelcomeScreen(bool callDelayedLoad)
 
 void ResultsJsInterface::resetResults()
 {
+	_changedAnalysesTimer.stop();
+	_changedAnalyses.clear();
+	_changedAnalysesOrder.clear();
+
 	emit resultsPageUrlChanged(_resultsPageUrl);
 	setWelcomeShown(true);
 }
@@ -263,24 +312,33 @@ void ResultsJsInterface::setWelcomeShown(bool welcomeShown)
 
 void ResultsJsInterface::unselect()
 {
-	emit runJavaScript("window.unselect()");
+	flushChangedAnalyses();
+	emit _resultsChannel.unselect();
 }
 
 void ResultsJsInterface::removeAnalysis(Analysis *analysis)
 {
-	emit runJavaScript("window.remove(" % QString::number(analysis->id()) % ")");
+	_changedAnalyses.erase(analysis->id());
+	_changedAnalysesOrder.erase(std::remove(_changedAnalysesOrder.begin(), _changedAnalysesOrder.end(), analysis->id()), _changedAnalysesOrder.end());
+
+	emit _resultsChannel.remove(analysis->id());
 }
 
 void ResultsJsInterface::removeAnalyses()
 {
-	emit runJavaScript("window.removeAllAnalyses()");
+	_changedAnalysesTimer.stop();
+	_changedAnalyses.clear();
+	_changedAnalysesOrder.clear();
+
+	emit _resultsChannel.removeAllAnalyses();
 }
 
 Json::Value &ResultsJsInterface::getResultsMeta()
 {
 	QEventLoop loop;
 
-	runJavaScript("window.getResultsMeta()");
+	flushChangedAnalyses();
+	emit _resultsChannel.getResultsMeta();
 	connect(this, &ResultsJsInterface::getResultsMetaCompleted, &loop, &QEventLoop::quit);
 	loop.exec();
 
@@ -291,7 +349,8 @@ QVariant &ResultsJsInterface::getAllUserData()
 {
 	QEventLoop loop;
 
-	runJavaScript("window.getAllUserData()");
+	flushChangedAnalyses();
+	emit _resultsChannel.getAllUserData();
 	connect(this, &ResultsJsInterface::getAllUserDataCompleted, &loop, &QEventLoop::quit);
 	loop.exec();
 
@@ -305,12 +364,14 @@ void ResultsJsInterface::showInstruction()
 
 void ResultsJsInterface::exportPreviewHTML()
 {
-	emit runJavaScript("window.exportHTML('%PREVIEW%');");
+	flushChangedAnalyses();
+	emit _resultsChannel.exportHTML("%PREVIEW%");
 }
 
 void ResultsJsInterface::exportHTML()
 {
-	emit runJavaScript("window.exportHTML('%EXPORT%');");
+	flushChangedAnalyses();
+	emit _resultsChannel.exportHTML("%EXPORT%");
 }
 
 QString ResultsJsInterface::escapeJavascriptString(const QString &str)
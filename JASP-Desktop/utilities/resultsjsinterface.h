@@ -24,8 +24,12 @@
 #include <QQmlWebChannel>
 #include <QAuthenticator>
 #include <QNetworkReply>
+#include <QTimer>
+#include <QPointer>
+#include <QJsonObject>
 
 #include "utilities/jsonutilities.h"
+#include "utilities/resultschannel.h"
 #include "analysis/analysis.h"
 
 
@@ -42,6 +46,7 @@ public:
 	void changeTitle(Analysis *analyses);
 	void showAnalysis(int id);
 	void analysisChanged(Analysis *analysis);
+	void analysisProgressChanged(Analysis *analysis);
 	void setResultsMeta(QString str);
 	void unselect();
 	void showInstruction();
@@ -58,6 +63,7 @@ public:
 	bool			welcomeShown()		const { return _welcomeShown;	}
 
 	Q_INVOKABLE void purgeClipboard();
+	Q_INVOKABLE void registerOnWebChannel(QQmlWebChannel * channel);
 
 	//Callable from javascript through resultsJsInterfaceInterface...
 
@@ -75,6 +81,7 @@ signals:
 	Q_INVOKABLE void refreshAllAnalyses();
 	Q_INVOKABLE void removeAllAnalyses();
 	Q_INVOKABLE void welcomeScreenIsCleared(bool callDelayedLoad);
+	Q_INVOKABLE void analysesVisibleInResults(QString visibleIds);
 
 public slots:
 	void setZoom(double zoom);
@@ -115,9 +122,11 @@ public slots:
 private:
 	void setGlobalJsValues();
 	QString escapeJavascriptString(const QString &str);
+	static QJsonObject toQJsonObject(const Json::Value &json);
 
 private slots:
 	void menuHidding();
+	void flushChangedAnalyses();
 	void welcomeScreenIsClearedHandler(bool) { setWelcomeShown(false); }
 
 private:
@@ -126,6 +135,11 @@ private:
 	QVariant		_allUserData;
 	QString			_resultsPageUrl = "qrc:///core/index.html";
 	bool			_welcomeShown = true;
+	ResultsChannel	_resultsChannel;	///< Carries everything about the analyses to the results page, in order and without escaping the Json into script source
+
+	QTimer								_changedAnalysesTimer;	///< Delivers the changed analyses at most once per frame, only the latest version of each
+	std::vector<int>					_changedAnalysesOrder;
+	std::map<int, QPointer<Analysis>>	_changedAnalyses;
 };
 
 
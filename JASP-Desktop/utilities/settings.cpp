@@ -30,7 +30,12 @@ const Settings::Setting Settings::Values[] = {
 	{"devModeRegenDescEtc",			true},
 	{"logToFile",					false}, //By default do not log to file and when running debug-mode log to stdout and in release to nowhere.
 	{"logFilesMax",					50},
-	{"maxFlickVelocity",			800}
+	{"maxFlickVelocity",			800},
+	{"analysisSoftMemoryMB",		0}, //The resource limits for a single analysis in a jaspEngine, 0 means no limit. Going over a soft limit is only logged, going over a hard one aborts the analysis.
+	{"analysisHardMemoryMB",		0},
+	{"analysisSoftSeconds",			0},
+	{"analysisHardSeconds",			0},
+	{"analysisPreemptAfterMs",		2000} //Background analyses running shorter than this are left alone when a more urgent one needs an engine, to avoid thrashing.
 };
 
 QVariant Settings::value(Settings::Type key)
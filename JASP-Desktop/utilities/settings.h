@@ -33,7 +33,12 @@ public:
 		DEVELOPER_MODE_REGENERATE_DESCRIPTION_ETC,
 		LOG_TO_FILE,
 		LOG_FILES_MAX,
-		QML_MAX_FLICK_VELOCITY
+		QML_MAX_FLICK_VELOCITY,
+		ANALYSIS_SOFT_MEMORY_MB,
+		ANALYSIS_HARD_MEMORY_MB,
+		ANALYSIS_SOFT_SECONDS,
+		ANALYSIS_HARD_SECONDS,
+		ANALYSIS_PREEMPT_AFTER_MS
 	};
 
 	static QVariant value(Settings::Type key);
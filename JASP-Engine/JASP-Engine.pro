@@ -42,12 +42,6 @@ linux {
     LIBS += -lboost_filesystem -lboost_system
 }
 
-$$JASPTIMER_USED {
-    windows:CONFIG(ReleaseBuild)    LIBS += -llibboost_timer-vc141-mt-1_64 -llibboost_chrono-vc141-mt-1_64
-    windows:CONFIG(DebugBuild)      LIBS += -llibboost_timer-vc141-mt-gd-1_64 -llibboost_chrono-vc141-mt-gd-1_64
-    linux:                          LIBS += -lboost_timer -lboost_chrono
-    macx:                           LIBS += -lboost_timer-clang-mt-1_64 -lboost_chrono-clang-mt-1_64
-}
 
 linux: LIBS += -L$$_R_HOME/lib -lR -lrt # because linux JASP-R-Interface is staticlib
 macx:  LIBS += -L$$_R_HOME/lib -lR
@@ -73,7 +67,7 @@ macx:QMAKE_CXXFLAGS += -stdlib=libc++
 
 win32:QMAKE_CXXFLAGS += -DBOOST_USE_WINDOWS_H -DNOMINMAX -DBOOST_INTERPROCESS_BOOTSTAMP_IS_SESSION_MANAGER_BASED
 
-win32:LIBS += -lole32 -loleaut32
+win32:LIBS += -lole32 -loleaut32 -lpsapi
 macx:LIBS += -L$$_R_HOME/lib -lR
 
 mkpath($$OUT_PWD/../R/library)
@@ -99,12 +93,16 @@ POST_TARGETDEPS     += InstallJASPRPackage
 QMAKE_CLEAN += $$OUT_PWD/../R/library/*
 
 SOURCES += main.cpp \
+    analysisresources.cpp \
 	engine.cpp \
+    enginezygote.cpp \
     rbridge.cpp \
     r_functionwhitelist.cpp
 
 HEADERS += \
+    analysisresources.h \
 	engine.h \
+    enginezygote.h \
     rbridge.h \
     r_functionwhitelist.h
 
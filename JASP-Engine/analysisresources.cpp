@@ -0,0 +1,210 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "analysisresources.h"
+
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#include "processinfo.h"
+#include "rbridge.h"
+#include "log.h"
+
+void AnalysisResources::setLimits(const Json::Value & limits)
+{
+	_softMemoryMB	= limits.get("softMemoryMB",	0).asDouble();
+	_hardMemoryMB	= limits.get("hardMemoryMB",	0).asDouble();
+	_softSeconds	= limits.get("softSeconds",		0).asDouble();
+	_hardSeconds	= limits.get("hardSeconds",		0).asDouble();
+}
+
+void AnalysisResources::start()
+{
+	_running			= true;
+	_started			= clock::now();
+	_lastCheck			= _started;
+	_cpuMsAtStart		= ProcessInfo::cpuTimeMs();
+	_peakWasReset		= ProcessInfo::resetPeakRSS();
+	_rssAtStart			= ProcessInfo::currentRSS();
+	_maxRSS				= _rssAtStart;
+	_softLimitsExceeded	= Json::arrayValue;
+
+	setMemoryLimit();
+
+	//Some extra time on top of the hard limit, so that check() gets the chance to stop the analysis with a proper message first
+	if(_hardSeconds > 0)
+		jaspRCPP_evalRCode(("setTimeLimit(elapsed=" + std::to_string(_hardSeconds * 1.1 + 5) + ", transient=FALSE); 'ok'").c_str());
+}
+
+void AnalysisResources::stop()
+{
+	if(!_running)
+		return;
+
+	_running		= false;
+	_stopped		= clock::now();
+	_cpuMsAtStop	= ProcessInfo::cpuTimeMs();
+
+	resetMemoryLimit();
+
+	if(_hardSeconds > 0)
+		jaspRCPP_evalRCode("setTimeLimit(); 'ok'");
+}
+
+AnalysisResourcesRun::~AnalysisResourcesRun()
+{
+	try
+	{
+		_resources.stop();
+	}
+	catch(std::exception & e)
+	{
+		Log::log() << "AnalysisResources::stop() failed: " << e.what() << std::endl;
+	}
+}
+
+unsigned long AnalysisResources::rssAddedKB(unsigned long rss) const
+{
+	return rss > _rssAtStart ? rss - _rssAtStart : 0;
+}
+
+long long AnalysisResources::wallMs() const
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>((_running ? clock::now() : _stopped) - _started).count();
+}
+
+std::string AnalysisResources::check()
+{
+	if(!_running)
+		return "";
+
+	//Checks come in with every update of the results or tick of a progressbar, reading the memory that often is a waste
+	clock::time_point now = clock::now();
+	if(now - _lastCheck < std::chrono::milliseconds(50))
+		return "";
+	_lastCheck = now;
+
+	unsigned long	rss		= ProcessInfo::currentRSS();
+	double			seconds	= wallMs() / 1000.0,
+					addedMB	= rssAddedKB(rss) / 1024.0;
+
+	_maxRSS = std::max(_maxRSS, rss);
+
+	std::stringstream reason;
+
+	if(_hardMemoryMB > 0 && addedMB > _hardMemoryMB)
+		reason << "This analysis was stopped because it needed more than " << _hardMemoryMB << " MB of memory, which is the most an analysis is allowed to use.";
+	else if(_hardSeconds > 0 && seconds > _hardSeconds)
+		reason << "This analysis was stopped because it was still running after " << _hardSeconds << " seconds, which is the longest an analysis is allowed to run.";
+
+	if(reason.str() != "")
+	{
+		Log::log() << "AnalysisResources::check() aborts the analysis: " << reason.str() << std::endl;
+		return reason.str();
+	}
+
+	if(_softMemoryMB > 0 && addedMB > _softMemoryMB)		softLimitExceeded("memory");
+	if(_softSeconds > 0 && seconds > _softSeconds)			softLimitExceeded("time");
+
+	return "";
+}
+
+void AnalysisResources::softLimitExceeded(const std::string & limit)
+{
+	for(const Json::Value & exceeded : _softLimitsExceeded)
+		if(exceeded.asString() == limit)
+			return;
+
+	Log::log() << "Analysis went over its soft " << limit << " limit." << std::endl;
+
+	_softLimitsExceeded.append(limit);
+}
+
+Json::Value AnalysisResources::usage(bool includeRHeap)
+{
+	Json::Value		usage	= Json::objectValue;
+	unsigned long	rss		= ProcessInfo::currentRSS();
+
+	_maxRSS = std::max(_maxRSS, rss);
+
+	usage["cpuMs"]				= Json::UInt((_running ? ProcessInfo::cpuTimeMs() : _cpuMsAtStop) - _cpuMsAtStart);
+	usage["wallMs"]				= Json::Int(wallMs());
+	usage["rssMB"]				= rssAddedKB(rss) / 1024.0;
+	usage["peakRssMB"]			= rssAddedKB(_peakWasReset ? std::max(ProcessInfo::peakRSS(), _maxRSS) : _maxRSS) / 1024.0;
+	usage["engineRssMB"]		= rss / 1024.0;
+	usage["softLimitsExceeded"]	= _softLimitsExceeded;
+
+	if(includeRHeap)
+	{
+		//The "max used (Mb)" column of gc() is the peak since the previous gc(reset=TRUE), so since the previous analysis finished.
+		std::string rHeap = jaspRCPP_evalRCode("local({ g <- gc(reset=TRUE); as.character(sum(g[, ncol(g)])) })");
+
+		const char	*	begin	= rHeap.c_str();
+		char		*	end		= nullptr;
+		double			heapMB	= std::strtod(begin, &end);
+
+		if(end != begin && *end == '\0')
+			usage["rHeapMB"] = heapMB;
+	}
+
+	return usage;
+}
+
+void AnalysisResources::setMemoryLimit()
+{
+#ifdef __linux__
+	if(_hardMemoryMB <= 0)
+		return;
+
+	rlimit limit;
+	if(getrlimit(RLIMIT_DATA, &limit) != 0)
+		return;
+
+	//The limit is for the whole process, so whatever R, the modules and the data already take comes on top of what the analysis may use
+	rlim_t analysisLimit = rlim_t(ProcessInfo::currentDataSize()) * 1024 + rlim_t(_hardMemoryMB * 1024 * 1024);
+
+	_oldDataLimit	= limit.rlim_cur;
+	limit.rlim_cur	= limit.rlim_max == RLIM_INFINITY ? analysisLimit : std::min(analysisLimit, limit.rlim_max);
+
+	if(limit.rlim_cur >= _oldDataLimit) //Never loosen a limit the engine already had
+		return;
+
+	_memoryLimitSet	= setrlimit(RLIMIT_DATA, &limit) == 0;
+#endif
+}
+
+void AnalysisResources::resetMemoryLimit()
+{
+#ifdef __linux__
+	if(!_memoryLimitSet)
+		return;
+
+	rlimit limit;
+	if(getrlimit(RLIMIT_DATA, &limit) == 0)
+	{
+		limit.rlim_cur = rlim_t(_oldDataLimit);
+		setrlimit(RLIMIT_DATA, &limit);
+	}
+
+	_memoryLimitSet = false;
+#endif
+}
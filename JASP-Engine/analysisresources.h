@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ANALYSISRESOURCES_H
+#define ANALYSISRESOURCES_H
+
+#include <string>
+#include <chrono>
+#include "jsonredirect.h"
+
+/* AnalysisResources keeps track of the CPU time, memory and R heap a single run of an analysis uses in this Engine.
+ * The desktop sends soft and hard limits along with the analysis (0 means no limit), the memory limits are about what the run adds to the memory the engine already used.
+ * Going over a soft limit is only reported while going over a hard one means check() returns a reason to abort the analysis with.
+ * Because check() only runs when the analysis polls for messages the hard memory limit is also set as RLIMIT_DATA (Linux), on top of what the engine already had, and the hard time limit
+ * through R's setTimeLimit, so a single huge allocation or a loop that never polls still ends in an R error instead of a crashed or stuck engine.
+ * Use AnalysisResourcesRun to start and stop it, so these limits are lifted even when the run throws.
+ */
+class AnalysisResources
+{
+public:
+	void			setLimits(const Json::Value & limits);
+	void			start();
+	void			stop(); ///< Lifts the limits again, usage() keeps reporting on the run that stopped
+
+	///Returns an explanation for the user when the analysis went over a hard limit and should be aborted, "" otherwise.
+	std::string		check();
+
+	///The peak R heap needs a gc(), so the Engine only asks for it when a run (not an init) finished.
+	Json::Value		usage(bool includeRHeap);
+
+	bool			running()	const { return _running; }
+
+private:
+	long long		wallMs()	const;
+	unsigned long	rssAddedKB(unsigned long rss) const; ///< What the run added to the resident memory of the engine
+	void			setMemoryLimit();
+	void			resetMemoryLimit();
+	void			softLimitExceeded(const std::string & limit);
+
+	typedef std::chrono::steady_clock clock;
+
+	double					_softMemoryMB	= 0,
+							_hardMemoryMB	= 0,
+							_softSeconds	= 0,
+							_hardSeconds	= 0;
+
+	bool					_running		= false,
+							_peakWasReset	= false,
+							_memoryLimitSet	= false;
+	clock::time_point		_started,
+							_stopped,
+							_lastCheck;
+	unsigned long long		_cpuMsAtStart	= 0,
+							_cpuMsAtStop	= 0,
+							_oldDataLimit	= 0;
+	unsigned long			_maxRSS			= 0,		///< In kB, sampled by check() for when the peak cannot be reset
+							_rssAtStart		= 0;		///< In kB, what R, the packages and the data already took before the run, the limits are about what comes on top of that
+	Json::Value				_softLimitsExceeded;
+};
+
+///Starts a run of AnalysisResources and stops it again when it goes out of scope, so the limits never stay on for whatever the Engine does next.
+class AnalysisResourcesRun
+{
+public:
+	AnalysisResourcesRun(AnalysisResources & resources) : _resources(resources)	{ _resources.start(); }
+	~AnalysisResourcesRun();
+
+private:
+	AnalysisResources & _resources;
+};
+
+#endif // ANALYSISRESOURCES_H
@@ -30,20 +30,44 @@
 #include "rbridge.h"
 #include "timers.h"
 #include "log.h"
+#include "fastjson.h"
 
 void SendFunctionForJaspresults(const char * msg) { Engine::theEngine()->sendString(msg); }
+void ProgressFunctionForJaspResults(int progress)	{ Engine::theEngine()->reportProgress(progress); }
 bool PollMessagesFunctionForJaspResults()
 {
+	Engine::theEngine()->updateCounters();
+
+	std::string abortReason = Engine::theEngine()->checkAnalysisResources();
+	if(abortReason != "")
+		jaspRCPP_abortAnalysis(abortReason.c_str());
+
 	if(Engine::theEngine()->receiveMessages())
 	{
 		if(Engine::theEngine()->paused())
 			return true;
-		else
-			return Engine::theEngine()->getStatus() == engineAnalysisStatus::changed;
+
+		//Aborted, or another analysis is waiting (after a preemption), either way this one should stop as soon as possible and its results won't be sent
+		switch(Engine::theEngine()->getStatus())
+		{
+		case engineAnalysisStatus::changed:
+		case engineAnalysisStatus::aborted:
+		case engineAnalysisStatus::toInit:
+		case engineAnalysisStatus::toRun:	return true;
+		default:							return false;
+		}
 	}
 	return false;
 }
 
+const char * ResourceUsageFunctionForJaspResults(bool analysisFinished)
+{
+	static std::string usage;
+	usage = fastJson::write(Engine::theEngine()->analysisResourceUsage(analysisFinished));
+
+	return usage.c_str();
+}
+
 #ifdef _WIN32
 
 #undef Realloc
@@ -79,12 +103,17 @@ Engine::Engine(int slaveNo, unsigned long parentPID)
 	JASPTIMER_STOP(Engine Constructor);
 
 	JASPTIMER_START(rbridge_init);
-	rbridge_init(SendFunctionForJaspresults, PollMessagesFunctionForJaspResults);
+	rbridge_init(SendFunctionForJaspresults, PollMessagesFunctionForJaspResults, ResourceUsageFunctionForJaspResults, ProgressFunctionForJaspResults);
 	JASPTIMER_STOP(rbridge_init);
 
 
 }
 
+void Engine::setSlaveNo(int no)
+{
+	_slaveNo = no;
+}
+
 Engine::~Engine()
 {
 	TempFiles::deleteAll();
@@ -110,12 +139,14 @@ void Engine::run()
 
 	std::string memoryName = "JASP-IPC-" + std::to_string(_parentPID);
 	_channel = new IPCChannel(memoryName, _slaveNo, true);
+	rbridge_setCounters(counters());
 
 	sendEngineResumed(); //Then the desktop knows we've finished init.
 
 	while(_engineState != engineState::stopped && ProcessInfo::isParentRunning())
 	{
 		receiveMessages(100);
+		updateCounters();
 
 		switch(_engineState)
 		{
@@ -144,8 +175,11 @@ bool Engine::receiveMessages(int timeout)
 	if (_channel->receive(data, timeout))
 	{
 		Json::Value jsonRequest;
-		Json::Reader().parse(data, jsonRequest, false);
-
+		{
+			engineCounterTimer parseTimer(counters(), &engineCounters::serializationUs);
+			fastJson::parse(data, jsonRequest);
+		}
+		counters()->requests.fetch_add(1, std::memory_order_relaxed);
 
 		engineState typeRequest = engineStateFromString(jsonRequest.get("typeRequest", Json::nullValue).asString());
 
@@ -188,7 +222,11 @@ void Engine::runFilter(const std::string & filter, const std::string & generated
 	try
 	{
         std::string strippedFilter		= stringUtils::stripRComments(filter);
-		std::vector<bool> filterResult	= rbridge_applyFilter(strippedFilter, generatedFilter);
+		std::vector<bool> filterResult;
+		{
+			engineCounterTimer rTimer(counters(), &engineCounters::rEvalUs);
+			filterResult				= rbridge_applyFilter(strippedFilter, generatedFilter);
+		}
 		std::string RPossibleWarning	= jaspRCPP_getLastErrorMsg();
 
 		sendFilterResult(filterRequestId, filterResult, RPossibleWarning);
@@ -213,7 +251,7 @@ void Engine::sendFilterResult(int filterRequestId, const std::vector<bool> & fil
 	for(bool f : filterResult)	filterResponse["filterResult"].append(f);
 	if(warning != "")			filterResponse["filterError"] = warning;
 
-	sendString(filterResponse.toStyledString());
+	sendString(fastJson::write(filterResponse));
 }
 
 void Engine::sendFilterError(int filterRequestId, const std::string & errorMessage)
@@ -224,7 +262,7 @@ void Engine::sendFilterError(int filterRequestId, const std::string & errorMessa
 	filterResponse["filterError"]	= errorMessage;
 	filterResponse["requestId"]		= filterRequestId;
 
-	sendString(filterResponse.toStyledString());
+	sendString(fastJson::write(filterResponse));
 }
 
 void Engine::receiveRCodeMessage(const Json::Value & jsonRequest)
@@ -242,7 +280,11 @@ void Engine::receiveRCodeMessage(const Json::Value & jsonRequest)
 // Evaluating arbitrary R code (as string) which returns a string
 void Engine::runRCode(const std::string & rCode, int rCodeRequestId)
 {
-	std::string rCodeResult = jaspRCPP_evalRCode(rCode.c_str());
+	std::string rCodeResult;
+	{
+		engineCounterTimer rTimer(counters(), &engineCounters::rEvalUs);
+		rCodeResult = jaspRCPP_evalRCode(rCode.c_str());
+	}
 
 	if (rCodeResult == "null")	sendRCodeError(rCodeRequestId);
 	else						sendRCodeResult(rCodeResult, rCodeRequestId);
@@ -264,7 +306,7 @@ void Engine::sendRCodeResult(const std::string & rCodeResult, int rCodeRequestId
 	rCodeResponse["requestId"]		= rCodeRequestId;
 
 
-	sendString(rCodeResponse.toStyledString());
+	sendString(fastJson::write(rCodeResponse));
 }
 
 void Engine::sendRCodeError(int rCodeRequestId)
@@ -277,7 +319,7 @@ void Engine::sendRCodeError(int rCodeRequestId)
 	rCodeResponse["rCodeError"]		= RError.size() == 0 ? "R Code failed for unknown reason. Check that R function returns a string." : RError;
 	rCodeResponse["requestId"]		= rCodeRequestId;
 
-	sendString(rCodeResponse.toStyledString());
+	sendString(fastJson::write(rCodeResponse));
 }
 
 void Engine::receiveComputeColumnMessage(const Json::Value & jsonRequest)
@@ -305,7 +347,11 @@ void Engine::runComputeColumn(const std::string & computeColumnName, const std::
 		{Column::ColumnTypeNominalText,	".setColumnDataAsNominalText"}};
 
 	std::string computeColumnCodeComplete	= "local({;calcedVals <- {"+computeColumnCode +"};\n"  "return(toString(" + setColumnFunction.at(computeColumnType) + "('" + computeColumnName +"', calcedVals)));})";
-	std::string computeColumnResultStr		= rbridge_evalRCodeWhiteListed(computeColumnCodeComplete);
+	std::string computeColumnResultStr;
+	{
+		engineCounterTimer rTimer(counters(), &engineCounters::rEvalUs);
+		computeColumnResultStr				= rbridge_evalRCodeWhiteListed(computeColumnCodeComplete);
+	}
 
 	Json::Value computeColumnResponse		= Json::objectValue;
 	computeColumnResponse["typeRequest"]	= engineStateToString(engineState::computeColumn);
@@ -313,7 +359,7 @@ void Engine::runComputeColumn(const std::string & computeColumnName, const std::
 	computeColumnResponse["error"]			= jaspRCPP_getLastErrorMsg();
 	computeColumnResponse["columnName"]		= computeColumnName;
 
-	sendString(computeColumnResponse.toStyledString());
+	sendString(fastJson::write(computeColumnResponse));
 
 	_engineState = engineState::idle;
 }
@@ -326,7 +372,11 @@ void Engine::receiveModuleRequestMessage(const Json::Value & jsonRequest)
 	std::string		moduleCode		= jsonRequest["moduleCode"].asString();
 	std::string		moduleName		= jsonRequest["moduleName"].asString();
 
-	std::string		result			= jaspRCPP_evalRCode(moduleCode.c_str());
+	std::string		result;
+	{
+		engineCounterTimer rTimer(counters(), &engineCounters::rEvalUs);
+		result						= jaspRCPP_evalRCode(moduleCode.c_str());
+	}
 	bool			succes			= result == "succes!"; //Defined in DynamicModule::succesResultString()
 
 	Json::Value		jsonAnswer		= Json::objectValue;
@@ -337,7 +387,7 @@ void Engine::receiveModuleRequestMessage(const Json::Value & jsonRequest)
 	jsonAnswer["error"]				= jaspRCPP_getLastErrorMsg();
 	jsonAnswer["typeRequest"]		= engineStateToString(engineState::moduleRequest);
 
-	sendString(jsonAnswer.toStyledString());
+	sendString(fastJson::write(jsonAnswer));
 
 	_engineState = engineState::idle;
 }
@@ -386,10 +436,10 @@ void Engine::receiveAnalysisMessage(const Json::Value & jsonRequest)
 	{
 		_analysisName			= jsonRequest.get("name",				Json::nullValue).asString();
 		_analysisTitle			= jsonRequest.get("title",				Json::nullValue).asString();
-		_analysisDataKey		= jsonRequest.get("dataKey",			Json::nullValue).toStyledString();
-		_analysisOptions		= jsonRequest.get("options",			Json::nullValue).toStyledString();
-		_analysisResultsMeta	= jsonRequest.get("resultsMeta",		Json::nullValue).toStyledString();
-		_analysisStateKey		= jsonRequest.get("stateKey",			Json::nullValue).toStyledString();
+		_analysisDataKey		= fastJson::write(jsonRequest.get("dataKey",			Json::nullValue));
+		_analysisOptions		= fastJson::write(jsonRequest.get("options",			Json::nullValue));
+		_analysisResultsMeta	= fastJson::write(jsonRequest.get("resultsMeta",		Json::nullValue));
+		_analysisStateKey		= fastJson::write(jsonRequest.get("stateKey",			Json::nullValue));
 		_analysisRevision		= jsonRequest.get("revision",			-1).asInt();
 		_imageOptions			= jsonRequest.get("image",				Json::nullValue);
 		_analysisRFile			= jsonRequest.get("rfile",				"").asString();
@@ -399,6 +449,7 @@ void Engine::receiveAnalysisMessage(const Json::Value & jsonRequest)
 		_imageBackground		= jsonRequest.get("imageBackground",	"white").asString();
 
 		_analysisJaspResults	= _dynamicModuleCall != "" || jsonRequest.get("jaspResults",	false).asBool();
+		_resources.setLimits(jsonRequest.get("resourceLimits", Json::objectValue));
 		_engineState		= engineState::analysis;
 	}
 }
@@ -426,17 +477,37 @@ void Engine::runAnalysis()
 	RCallback callback					= boost::bind(&Engine::callback, this, _1, _2);
 
 	_currentAnalysisKnowsAboutChange	= false;
+	_resourcesAbortReason				= "";
+
+	jaspRCPP_abortAnalysis("");
+
+	{
+		AnalysisResourcesRun	resourcesRun(_resources);
+		engineCounterTimer		rTimer(counters(), &engineCounters::rEvalUs);
 
-	_analysisResultsString = _dynamicModuleCall != "" ?
-			rbridge_runModuleCall(_analysisName, _analysisTitle, _dynamicModuleCall, _analysisDataKey, _analysisOptions, _analysisStateKey, perform, _ppi, _analysisId, _analysisRevision, _imageBackground)
-		:	rbridge_run(_analysisName, _analysisTitle, _analysisRFile, _analysisRequiresInit, _analysisDataKey, _analysisOptions, _analysisResultsMeta, _analysisStateKey, _analysisId, _analysisRevision, perform, _ppi, _imageBackground, callback, _analysisJaspResults);
+		_analysisResultsString = _dynamicModuleCall != "" ?
+				rbridge_runModuleCall(_analysisName, _analysisTitle, _dynamicModuleCall, _analysisDataKey, _analysisOptions, _analysisStateKey, perform, _ppi, _analysisId, _analysisRevision, _imageBackground)
+			:	rbridge_run(_analysisName, _analysisTitle, _analysisRFile, _analysisRequiresInit, _analysisDataKey, _analysisOptions, _analysisResultsMeta, _analysisStateKey, _analysisId, _analysisRevision, perform, _ppi, _imageBackground, callback, _analysisJaspResults);
+	}
+
+	if(_resourcesAbortReason != "" && !_analysisJaspResults)
+	{
+		//The old style analyses just stop when the callback says "aborted", so we make up the errormessage for them.
+		Json::Value error					= Json::objectValue;
+		error["status"]						= analysisResultStatusToString(analysisResultStatus::validationError);
+		error["results"]["title"]			= _analysisTitle;
+		error["results"]["error"]			= 1;
+		error["results"]["errorMessage"]	= _resourcesAbortReason;
+
+		_analysisResultsString				= fastJson::write(error);
+	}
 
 	if (_analysisStatus == Status::initing || _analysisStatus == Status::running)  // if status hasn't changed
 		receiveMessages();
 
-	if (_analysisStatus == Status::toInit || _analysisStatus == Status::aborted || _analysisStatus == Status::error || _analysisStatus == Status::exception)
+	if (_analysisStatus == Status::toInit || _analysisStatus == Status::toRun || _analysisStatus == Status::aborted || _analysisStatus == Status::error || _analysisStatus == Status::exception)
 	{
-		// analysis was aborted, and we shouldn't send the results
+		// analysis was aborted or replaced by another one (a preemption for instance), and we shouldn't send the results
 		return;
 	}
 	else if (_analysisStatus == Status::changed && (_currentAnalysisKnowsAboutChange == false || _analysisResultsString == "null"))
@@ -452,13 +523,16 @@ void Engine::runAnalysis()
 	}
 	else
 	{
-		Json::Reader().parse(_analysisResultsString, _analysisResults, false);
+		{
+			engineCounterTimer parseTimer(counters(), &engineCounters::serializationUs);
+			fastJson::parse(_analysisResultsString, _analysisResults);
+		}
 
 		if(!_analysisJaspResults)
 		{
 			_analysisStatus		= _analysisStatus == Status::initing ? Status::inited : Status::complete;
 			_progress	= -1;
-			sendAnalysisResults();
+			sendAnalysisResults(true);
 		}
 
 		_engineState	= engineState::idle;
@@ -478,7 +552,7 @@ void Engine::saveImage()
 
 	std::string result = jaspRCPP_saveImage(name.c_str(), type.c_str(), height, width, _ppi, _imageBackground.c_str());
 
-	Json::Reader().parse(result, _analysisResults, false);
+	fastJson::parse(result, _analysisResults);
 
 	_analysisStatus								= Status::complete;
 	_analysisResults["results"]["inputOptions"]	= _imageOptions;
@@ -497,7 +571,7 @@ void Engine::editImage()
 	int width			= _imageOptions.get("width", Json::nullValue).asInt();
 	std::string result	= jaspRCPP_editImage(name.c_str(), type.c_str(), height, width, _ppi, _imageBackground.c_str());
 
-	Json::Reader().parse(result, _analysisResults, false);
+	fastJson::parse(result, _analysisResults);
 
 	_analysisStatus			= Status::complete;
 	_progress				= -1;
@@ -534,7 +608,7 @@ analysisResultStatus Engine::getStatusToAnalysisStatus()
 	}
 }
 
-void Engine::sendAnalysisResults()
+void Engine::sendAnalysisResults(bool withResourceUsage)
 {
 	Json::Value response = Json::Value(Json::objectValue);
 
@@ -544,13 +618,48 @@ void Engine::sendAnalysisResults()
 	response["revision"]	= _analysisRevision;
 	response["progress"]	= _progress;
 
+	if(_channel)
+		_channel->progress()->set(_analysisId, _analysisRevision, _progress); //Otherwise a tick from before these results could still be read as the latest
+
 	bool					sensibleResultsStatus	= _analysisResults.isObject() && _analysisResults.get("status", Json::nullValue) != Json::nullValue;
 	analysisResultStatus	resultStatus			= !sensibleResultsStatus ? getStatusToAnalysisStatus() : analysisResultStatusFromString(_analysisResults["status"].asString());
 
 	response["results"] = _analysisResults.get("results", _analysisResults);
 	response["status"]  = analysisResultStatusToString(resultStatus);
 
-	sendString(response.toStyledString());
+	if(_resources.running() || withResourceUsage)
+		response["resources"] = analysisResourceUsage(withResourceUsage);
+
+	std::string responseString;
+	{
+		engineCounterTimer writeTimer(counters(), &engineCounters::serializationUs);
+		responseString = fastJson::write(response);
+	}
+
+	sendString(responseString);
+}
+
+void Engine::reportProgress(int progress)
+{
+	_progress = progress;
+
+	if(_channel)
+		_channel->progress()->set(_analysisId, _analysisRevision, _progress);
+}
+
+void Engine::updateCounters()
+{
+	if(!counters())
+		return;
+
+	uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	//The runloop and the polling of jaspResults come by here very often and the desktop only samples once a second or so anyway
+	if(now - counters()->lastUpdateMs.load(std::memory_order_relaxed) < 250)
+		return;
+
+	counters()->rssKB			.store(ProcessInfo::currentRSS(),	std::memory_order_relaxed);
+	counters()->lastUpdateMs	.store(now,							std::memory_order_relaxed);
 }
 
 void Engine::removeNonKeepFiles(const Json::Value & filesToKeepValue)
@@ -592,7 +701,7 @@ void Engine::provideStateFileName(std::string &root, std::string &relativePath)
 
 void Engine::provideJaspResultsFileName(std::string &root, std::string &relativePath)
 {
-	return TempFiles::createSpecific("jaspResults.json", _analysisId, root, relativePath);
+	return TempFiles::createSpecific("jaspResults.bin", _analysisId, root, relativePath);
 }
 
 void Engine::provideTempFileName(const std::string &extension, std::string &root, std::string &relativePath)
@@ -603,6 +712,12 @@ void Engine::provideTempFileName(const std::string &extension, std::string &root
 
 std::string Engine::callback(const std::string &results, int progress)
 {
+	if(_resourcesAbortReason == "")
+		_resourcesAbortReason = checkAnalysisResources();
+
+	if(_resourcesAbortReason != "")
+		return "{ \"status\" : \"aborted\" }";
+
 	receiveMessages();
 
 	if (_analysisStatus == Status::aborted || _analysisStatus == Status::toInit || _analysisStatus == Status::toRun)
@@ -618,21 +733,17 @@ std::string Engine::callback(const std::string &results, int progress)
 	{
 		_analysisResultsString = results;
 
-		Json::Reader().parse(_analysisResultsString, _analysisResults, false);
+		{
+			engineCounterTimer parseTimer(counters(), &engineCounters::serializationUs);
+			fastJson::parse(_analysisResultsString, _analysisResults);
+		}
 
 		_progress = progress;
 
 		sendAnalysisResults();
 	}
 	else if (progress >= 0 && _analysisStatus == Status::running)
-	{
-		_analysisResultsString	= "";
-		_analysisResults		= Json::nullValue;
-		_progress				= progress;
-
-		sendAnalysisResults();
-
-	}
+		reportProgress(progress);
 
 	if (_analysisStatus == Status::changed)
 	{
@@ -716,7 +827,7 @@ void Engine::sendEngineStopped()
 {
 	Json::Value rCodeResponse		= Json::objectValue;
 	rCodeResponse["typeRequest"]	= engineStateToString(_engineState);
-	sendString(rCodeResponse.toStyledString());
+	sendString(fastJson::write(rCodeResponse));
 }
 
 void Engine::pauseEngine()
@@ -743,7 +854,7 @@ void Engine::sendEnginePaused()
 	Json::Value rCodeResponse		= Json::objectValue;
 	rCodeResponse["typeRequest"]	= engineStateToString(engineState::paused);
 
-	sendString(rCodeResponse.toStyledString());
+	sendString(fastJson::write(rCodeResponse));
 }
 
 void Engine::resumeEngine()
@@ -759,7 +870,7 @@ void Engine::sendEngineResumed()
 	Json::Value rCodeResponse		= Json::objectValue;
 	rCodeResponse["typeRequest"]	= engineStateToString(engineState::resuming);
 
-	sendString(rCodeResponse.toStyledString());
+	sendString(fastJson::write(rCodeResponse));
 }
 
 void Engine::receiveLogCfg(const Json::Value & jsonRequest)
@@ -771,7 +882,7 @@ void Engine::receiveLogCfg(const Json::Value & jsonRequest)
 	Json::Value logCfgResponse		= Json::objectValue;
 	logCfgResponse["typeRequest"]	= engineStateToString(engineState::logCfg);
 
-	sendString(logCfgResponse.toStyledString());
+	sendString(fastJson::write(logCfgResponse));
 
 	_engineState = engineState::idle;
 }
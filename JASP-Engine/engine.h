@@ -23,6 +23,7 @@
 #include "ipcchannel.h"
 #include "processinfo.h"
 #include "jsonredirect.h"
+#include "analysisresources.h"
 
 /* The Engine represents the background processes.
  * It can be in a variety of states _currentEngineState and can run analyses, filters, compute columns and Rcode.
@@ -58,6 +59,13 @@ public:
 
 	bool paused() { return _engineState == engineState::paused; }
 
+	engineCounters * counters()										{ return _channel ? _channel->counters() : nullptr; }
+	void updateCounters(); ///< Samples the memory of the engine into counters(), at most a few times a second
+	void reportProgress(int progress); ///< Leaves the progress of the running analysis in shared memory for the desktop, instead of sending all the results again
+
+	std::string checkAnalysisResources()							{ return _resources.check();					}
+	Json::Value analysisResourceUsage(bool analysisFinished)		{ return _resources.usage(analysisFinished && _analysisStatus != Status::initing && _analysisStatus != Status::inited); }
+
 
 private: // Methods:
 	void receiveRCodeMessage(			const Json::Value & jsonRequest);
@@ -85,7 +93,7 @@ private: // Methods:
 	void rewriteImages();
 	void removeNonKeepFiles(const Json::Value & filesToKeepValue);
 
-	void sendAnalysisResults();
+	void sendAnalysisResults(bool withResourceUsage = false);
 	void sendFilterResult(		int filterRequestId,				const std::vector<bool> & filterResult, const std::string & warning = "");
 	void sendFilterError(		int filterRequestId,				const std::string & errorMessage);
 	void sendRCodeResult(		const std::string & rCodeResult,	int rCodeRequestId);
@@ -128,6 +136,9 @@ private: // Data:
 	Json::Value _imageOptions,
 				_analysisResults;
 
+	AnalysisResources	_resources;
+	std::string			_resourcesAbortReason;
+
 	IPCChannel *_channel = nullptr;
 
 	unsigned long _parentPID = 0;
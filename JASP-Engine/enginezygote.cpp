@@ -0,0 +1,200 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "enginezygote.h"
+
+#ifdef __linux__
+
+#include <csignal>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <sstream>
+
+#include "processinfo.h"
+#include "rbridge.h"
+#include "log.h"
+#include "fastjson.h"
+
+EngineZygote::EngineZygote(unsigned long parentPID, size_t channelNumber)
+	: _parentPID(parentPID), _memoryName("JASP-IPC-" + std::to_string(parentPID)), _channelNumber(channelNumber)
+{
+}
+
+EngineZygote::~EngineZygote()
+{
+	delete _channel;
+	_channel = nullptr;
+}
+
+int EngineZygote::run()
+{
+	_channel = new IPCChannel(_memoryName, _channelNumber, true);
+
+	Log::log() << "EngineZygote ready to fork engines" << std::endl;
+
+	while(!_stopped && ProcessInfo::isParentRunning())
+	{
+		std::string data;
+
+		reapEngines();
+
+		if(!_channel->receive(data, 100))
+			continue;
+
+		Json::Value request;
+		fastJson::parse(data, request);
+
+		switch(zygoteRequestFromString(request.get("typeRequest", Json::nullValue).asString()))
+		{
+		case zygoteRequest::forkEngine:
+		{
+			int slaveNo = request.get("slaveNo", -1).asInt();
+
+			if(forkEngine(slaveNo) == 0)
+				return slaveNo; //We are the child now, so go and be an Engine.
+
+			break;
+		}
+
+		case zygoteRequest::preloadPackages:
+			preloadPackages(request);
+			break;
+
+		case zygoteRequest::stopRequested:
+			_stopped = true;
+			break;
+		}
+	}
+
+	Log::log() << "EngineZygote stops." << std::endl;
+
+	return -1;
+}
+
+void EngineZygote::preloadPackages(const Json::Value & request)
+{
+	auto toRVector = [](const Json::Value & strings)
+	{
+		std::stringstream out;
+		out << "c(";
+
+		bool first = true;
+		for(const Json::Value & str : strings)
+		{
+			out << (first ? "" : ", ") << "'";
+			first = false;
+
+			//Package names and lib paths come from the modules, so escape whatever would end the R string early
+			for(char c : str.asString())
+				switch(c)
+				{
+				case '\\':	out << "\\\\";	break;
+				case '\'':	out << "\\'";	break;
+				case '\n':	out << "\\n";	break;
+				default:	out << c;		break;
+				}
+
+			out << "'";
+		}
+
+		out << ")";
+		return out.str();
+	};
+
+	std::string rCode	= ".preloadSharedPackages(modulePackages=" + toRVector(request.get("packages", Json::arrayValue)) + ", moduleLibPaths=" + toRVector(request.get("libPaths", Json::arrayValue)) + ")",
+				loaded	= jaspRCPP_evalRCode(rCode.c_str());
+
+	Log::log() << "EngineZygote preloaded the namespaces: " << loaded << std::endl;
+
+	Json::Value reply		= Json::objectValue;
+	reply["typeRequest"]	= zygoteRequestToString(zygoteRequest::preloadPackages);
+	reply["loaded"]			= loaded;
+
+	sendString(fastJson::write(reply));
+}
+
+int EngineZygote::forkEngine(int slaveNo)
+{
+	Json::Value reply		= Json::objectValue;
+	reply["typeRequest"]	= zygoteRequestToString(zygoteRequest::forkEngine);
+	reply["slaveNo"]		= slaveNo;
+
+	pid_t zygotePid	= getpid(),
+		  pid		= fork();
+
+	if(pid == 0)
+	{
+		//The channel belongs to the zygote, the Engine will open its own one.
+		_channel = nullptr;
+
+		prctl(PR_SET_PDEATHSIG, SIGKILL); //If the zygote goes, so do we.
+
+		if(getppid() != zygotePid) //It already went before the prctl, so nothing will kill us anymore
+			_exit(1);
+
+		Log::setLogFileName(Log::logFileNameBase + " Engine " + std::to_string(slaveNo) + ".log");
+
+		//Otherwise every fork would draw the exact same "random" numbers.
+		jaspRCPP_evalRCode("if(exists('.Random.seed', envir=globalenv())) rm('.Random.seed', envir=globalenv()); 'reseeded'");
+
+		return 0;
+	}
+
+	if(pid < 0)	Log::log() << "EngineZygote failed to fork engine " << slaveNo << std::endl;
+	else		Log::log() << "EngineZygote forked engine " << slaveNo << " with PID " << pid << std::endl;
+
+	if(pid > 0)
+		_engines[int(pid)] = slaveNo;
+
+	reply["pid"] = pid < 0 ? -1 : int(pid);
+	sendString(fastJson::write(reply));
+
+	return int(pid);
+}
+
+void EngineZygote::reapEngines()
+{
+	int		status;
+	pid_t	pid;
+
+	while((pid = waitpid(-1, &status, WNOHANG)) > 0)
+	{
+		if(_engines.count(int(pid)) == 0)
+			continue;
+
+		int	slaveNo		= _engines[int(pid)],
+			exitCode	= WIFEXITED(status)		? WEXITSTATUS(status)	: -1,
+			signalNo	= WIFSIGNALED(status)	? WTERMSIG(status)		: 0;
+
+		_engines.erase(int(pid));
+
+		Log::log() << "EngineZygote reaped engine " << slaveNo << " with PID " << pid << ", it exited with code " << exitCode << " and signal " << signalNo << std::endl;
+
+		try
+		{
+			boost::interprocess::managed_shared_memory control(boost::interprocess::open_only, IPCChannel::controlName(_memoryName, size_t(slaveNo)).c_str());
+			control.find_or_construct<engineExitStatus>("engineExitStatus")()->set(int(pid), exitCode, signalNo);
+		}
+		catch(boost::interprocess::interprocess_exception & e)
+		{
+			Log::log() << "EngineZygote could not report the exit of engine " << slaveNo << ": " << e.what() << std::endl;
+		}
+	}
+}
+
+#endif
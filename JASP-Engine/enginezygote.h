@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2013-2018 University of Amsterdam
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef ENGINEZYGOTE_H
+#define ENGINEZYGOTE_H
+
+#ifdef __linux__
+
+#include "enginedefinitions.h"
+#include "ipcchannel.h"
+#include "jsonredirect.h"
+#include <map>
+
+/* The EngineZygote is a jaspEngine that boots R and the JASP packages once and then only fork()s.
+ * Every fork is a ready-to-use Engine that shares the already initialized R with the zygote (copy-on-write),
+ * which makes starting extra engines or restarting crashed ones nearly free.
+ * Before the first fork the desktop asks it to preload the most used R packages (and those of the installed modules) so those are shared as well.
+ * It talks to the desktop over its own IPCChannel, one request and one reply at a time.
+ */
+class EngineZygote
+{
+public:
+	EngineZygote(unsigned long parentPID, size_t channelNumber);
+	~EngineZygote();
+
+	///Returns the slaveNo to run as when it returns in a forked child and -1 when the zygote itself is done.
+	int run();
+
+private:
+	int		forkEngine(int slaveNo);
+	void	preloadPackages(const Json::Value & request); ///< Loads the namespaces all engines need before the first fork, so they end up in the pages the engines share
+	void	sendString(std::string message) { _channel->send(message); }
+	void	reapEngines(); ///< Waits for the engines that are gone and leaves their exit status in their IPCChannel for the desktop
+
+private:
+	IPCChannel		*	_channel	= nullptr;
+	unsigned long		_parentPID	= 0;
+	std::string			_memoryName;
+	std::map<int, int>	_engines;				///< PID -> slaveNo of the engines we forked and did not reap yet
+	size_t				_channelNumber;
+	bool				_stopped	= false;
+};
+
+#endif
+#endif // ENGINEZYGOTE_H
@@ -16,6 +16,7 @@
 //
 
 #include "engine.h"
+#include "enginezygote.h"
 #include "timers.h"
 #include "log.h"
 
@@ -48,6 +49,7 @@ int main(int argc, char *argv[])
 						parentPID		= strtoul(argv[2], NULL, 10);
 		std::string		logFileBase		= argv[3],
 						logFileWhere	= argv[4];
+		bool			isZygote		= argc > 5 && std::string(argv[5]) == "zygote";
 
 #ifdef _WIN32
 		//openConsoleOutput(slaveNo, parentPID); //uncomment to have a console window open per Engine that shows you std out and cerr. (On windows only, on unixes you can just run JASP from a terminal)
@@ -55,9 +57,12 @@ int main(int argc, char *argv[])
 
 		Log::logFileNameBase = logFileBase;
 		Log::initRedirects();
-		Log::setLogFileName(logFileBase + " Engine " + std::to_string(slaveNo) + ".log");
+		Log::setLogFileName(logFileBase + (isZygote ? " EngineZygote" : " Engine " + std::to_string(slaveNo)) + ".log");
 		Log::setWhere(logTypeFromString(logFileWhere));
 
+		JaspTimer::setTraceFileName(logFileBase + (isZygote ? " EngineZygote" : " Engine " + std::to_string(slaveNo)) + ".trace.json");
+		JaspTimer::setProcessName(isZygote ? "jaspEngineZygote" : "jaspEngine " + std::to_string(slaveNo));
+
 		Log::log() << "Log and possible redirects initialized!" << std::endl;
 
 		Log::log() << "jaspEngine started and has slaveNo " << slaveNo << " and it's parent PID is " << parentPID << std::endl;
@@ -66,6 +71,31 @@ int main(int argc, char *argv[])
 
 		JASPTIMER_START(Engine Starting);
 		Engine e(slaveNo, parentPID);
+
+#ifdef __linux__
+		if(isZygote)
+		{
+			EngineZygote zygote(parentPID, slaveNo);
+			int forkedSlaveNo = zygote.run();
+
+			if(forkedSlaveNo < 0)
+			{
+				JASPTIMER_PRINTALL();
+				Log::log() << "jaspEngineZygote child of " << parentPID << " stops." << std::endl;
+				return 0;
+			}
+
+			slaveNo = static_cast<unsigned long>(forkedSlaveNo);
+			e.setSlaveNo(forkedSlaveNo);
+
+			//What the zygote traced before the fork is not part of what this engine did
+			JaspTimer::clear();
+			JaspTimer::setTraceFileName(logFileBase + " Engine " + std::to_string(slaveNo) + ".trace.json");
+			JaspTimer::setProcessName("jaspEngine " + std::to_string(slaveNo));
+			Log::log() << "jaspEngine forked from zygote and has slaveNo " << slaveNo << std::endl;
+		}
+#endif
+
 		e.run();
 
 		JASPTIMER_PRINTALL();
@@ -22,6 +22,7 @@
 #include "appinfo.h"
 #include "tempfiles.h"
 #include "log.h"
+#include "timers.h"
 
 DataSet		*rbridge_dataSet = NULL;
 RCallback	rbridge_callback = NULL;
@@ -29,9 +30,12 @@ boost::function<void(const std::string &, std::string &, std::string &)>	rbridge
 boost::function<void(std::string &, std::string &)>							rbridge_stateFileSource			= NULL,
 																			rbridge_jaspResultsFileSource	= NULL;
 boost::function<DataSet *()>	rbridge_dataSetSource = NULL;
-std::unordered_set<std::string> filterColumnsUsed;
+std::unordered_set<std::string> filterColumnsUsed,
+								filterColumnsToRead;	//The used columns that are not in .filterDataCache in R yet or changed since
+std::map<std::string, uint64_t>	filterColumnsCached;	//Fingerprints of the columns as they are in .filterDataCache
 std::vector<std::string>		columnNamesInDataSet;
 boost::function<size_t()>		rbridge_getDataSetRowCount = NULL;
+engineCounters				*	rbridge_counters = nullptr;
 
 boost::function<bool(const std::string&, const	std::vector<double>&)											> rbridge_setColumnDataAsScaleEngine		= NULL;
 boost::function<bool(const std::string&,		std::vector<int>&,			const std::map<int, std::string>&)	> rbridge_setColumnDataAsOrdinalEngine		= NULL;
@@ -54,7 +58,7 @@ size_t _logWriteFunction(const void * buf, size_t len)
 	return len;
 }
 
-void rbridge_init(sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction)
+void rbridge_init(sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction, resourceUsageFuncDef resourceUsageFunction, progressFuncDef progressFunction)
 {
 	RBridgeCallBacks callbacks = {
 		rbridge_readDataSet,
@@ -80,8 +84,12 @@ void rbridge_init(sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMes
 					&callbacks,
 					sendToDesktopFunction,
 					pollMessagesFunction,
+					resourceUsageFunction,
+					progressFunction,
 					[](){ Log::log().flush(); return 0;},
-					_logWriteFunction
+					_logWriteFunction,
+					[]() { return JaspTimer::startNs(); },
+					[](const char * name, uint64_t beganNs) { JaspTimer::complete(name, beganNs); }
 	);
 	Log::log() << "jaspRCPP_init was run and R_HOME: "<< jaspRCPP_runScriptReturnString("R.home('')") << std::endl;
 }
@@ -90,6 +98,7 @@ void rbridge_setDataSetSource(			boost::function<DataSet* ()> source)
 void rbridge_setFileNameSource(			boost::function<void (const std::string &, std::string &, std::string &)> source)	{	rbridge_fileNameSource			= source; }
 void rbridge_setStateFileSource(		boost::function<void (std::string &, std::string &)> source)						{	rbridge_stateFileSource			= source; }
 void rbridge_setJaspResultsFileSource(	boost::function<void (std::string &, std::string &)> source)						{	rbridge_jaspResultsFileSource	= source; }
+void rbridge_setCounters(				engineCounters * counters)															{	rbridge_counters				= counters; }
 
 void rbridge_setColumnDataAsScaleSource(		boost::function<bool(const std::string &, const std::vector<double>&)													> source)	{	rbridge_setColumnDataAsScaleEngine			= source; }
 void rbridge_setColumnDataAsOrdinalSource(		boost::function<bool(const std::string &,		std::vector<int>&,					const std::map<int, std::string>&)	> source)	{	rbridge_setColumnDataAsOrdinalEngine		= source; }
@@ -225,15 +234,15 @@ extern "C" RBridgeColumn* STDCALL rbridge_readDataSetForFiltering(size_t * colMa
 
 	Columns &columns = rbridge_dataSet->columns();
 
-	(*colMax) = filterColumnsUsed.size();
+	(*colMax) = filterColumnsToRead.size();
 
 	if(*colMax == 0)
 		return NULL;
 
 	RBridgeColumnType* colHeaders = (RBridgeColumnType*)calloc((*colMax), sizeof(RBridgeColumnType));
 
-	for(size_t iIn=0, iOut=0; iIn < columns.columnCount() && iOut < filterColumnsUsed.size(); iIn++)
-		if(filterColumnsUsed.count(columns[iIn].name()) > 0)
+	for(size_t iIn=0, iOut=0; iIn < columns.columnCount() && iOut < filterColumnsToRead.size(); iIn++)
+		if(filterColumnsToRead.count(columns[iIn].name()) > 0)
 		{
 			colHeaders[iOut].name = strdup(columns[iIn].name().c_str());
 			colHeaders[iOut].type = (int)columns[iIn].columnType();
@@ -259,6 +268,8 @@ extern "C" RBridgeColumn* STDCALL rbridge_readDataSet(RBridgeColumnType* colHead
 	if (colHeaders == NULL)
 		return NULL;
 
+	engineCounterTimer extractionTimer(rbridge_counters, &engineCounters::dataExtractionUs);
+
 	//if (rbridge_dataSet == NULL)
 		rbridge_dataSet = rbridge_dataSetSource();
 
@@ -770,6 +781,76 @@ void rbridge_findColumnsUsedInDataSet()
 	std::sort(columnNamesInDataSet.begin(), columnNamesInDataSet.end(), [](std::string & a, std::string & b) { return a.size() > b.size(); }); //from longer to shorter length columnNames to avoid problems with columnanems such as "Height Ratio" and "Height"
 }
 
+uint64_t rbridge_columnFingerprint(Column & column)
+{
+	//FNV-1a over everything that ends up in the R version of the column, only meant to notice changes between two filter runs
+	uint64_t	hash	= 14695981039346656037ULL;
+	auto		mix		= [&hash](uint64_t word) { hash ^= word; hash *= 1099511628211ULL; };
+
+	mix(column.columnType());
+	mix(column.rowCount());
+
+	if(column.columnType() == Column::ColumnTypeScale)
+		for(size_t row=0; row<column.rowCount(); row++)
+		{
+			double		value = column.AsDoubles[row];
+			uint64_t	bits;
+			memcpy(&bits, &value, sizeof(bits));
+			mix(bits);
+		}
+	else
+	{
+		for(size_t row=0; row<column.rowCount(); row++)
+			mix(static_cast<uint64_t>(column.AsInts[row]));
+
+		for(const Label & label : column.labels())
+		{
+			mix(static_cast<uint64_t>(label.value()));
+			mix(std::hash<std::string>()(label.text()));
+		}
+	}
+
+	return hash;
+}
+
+bool rbridge_readFilterData()
+{
+	//Only the used columns that changed since the previous filter are read into R, the others are taken from .filterDataCache
+	Columns							&	columns	= rbridge_dataSet->columns();
+	std::map<std::string, uint64_t>		nowCached;
+	std::stringstream					usedNames;
+
+	filterColumnsToRead.clear();
+
+	for(const std::string & col : filterColumnsUsed)
+	{
+		uint64_t fingerprint = rbridge_columnFingerprint(columns.get(col));
+
+		if(filterColumnsCached.count(col) == 0 || filterColumnsCached[col] != fingerprint)
+			filterColumnsToRead.insert(col);
+
+		nowCached[col] = fingerprint;
+		usedNames << (nowCached.size() > 1 ? ", " : "") << "'" << Base64::encode("X", col, Base64::RVarEncoding) << "'";
+	}
+
+	std::string readScript =
+			"if(!exists('.filterDataCache')) .filterDataCache <- list();\n"
+			"tryCatch({\n"
+			"	.filterDataRead <- .readFilterDatasetToEnd();\n"
+			"	for(.filterCol in names(.filterDataRead)) .filterDataCache[[.filterCol]] <- .filterDataRead[[.filterCol]];\n"
+			"	rm(.filterDataRead);\n"
+			"	.filterDataCache <- .filterDataCache[c(" + usedNames.str() + ")];\n"
+			"	data <- as.data.frame(.filterDataCache, optional=TRUE);\n"
+			"	'ok'\n"
+			"}, error = function(e) { .filterDataCache <<- list(); 'failed' })";
+
+	//The fingerprints only describe .filterDataCache once R actually has the columns, if reading failed everything is read again next time.
+	bool read			= std::string(jaspRCPP_runScriptReturnString(readScript.c_str())) == "ok";
+	filterColumnsCached	= read ? nowCached : std::map<std::string, uint64_t>();
+
+	return read;
+}
+
 std::vector<bool> rbridge_applyFilter(const std::string & filterCode, const std::string & generatedFilterCode)
 {
 	rbridge_dataSet = rbridge_dataSetSource();
@@ -791,8 +872,10 @@ std::vector<bool> rbridge_applyFilter(const std::string & filterCode, const std:
 
 	bool * arrayPointer = NULL;
 
-	std::string setupFilterEnv = "data     <- .readFilterDatasetToEnd();\n"
-								 "rowcount <- " + std::to_string(rowCount) +  ";\n"
+	if(!rbridge_readFilterData())
+		throw filterException("Could not read the columns used by the filter.");
+
+	std::string setupFilterEnv = "rowcount <- " + std::to_string(rowCount) +  ";\n"
 								 "attach(data);\n"
 								 "options(warn=1, showWarnCalls=TRUE, showErrorCalls=TRUE, show.error.messages=TRUE);\n";
 
@@ -802,6 +885,7 @@ std::vector<bool> rbridge_applyFilter(const std::string & filterCode, const std:
 
 	if(arrayLength < 0)
 	{
+		filterColumnsCached.clear(); //Who knows what a failing filter left behind in .filterDataCache
 		errorMsg = rbridge_decodeColumnNamesFromBase64(jaspRCPP_getLastErrorMsg());
 		throw filterException(errorMsg.c_str());
 	}
@@ -843,9 +927,11 @@ std::string rbridge_evalRCodeWhiteListed(const std::string & rCode)
 	try							{ R_FunctionWhiteList::scriptIsSafe(rCode64); }
 	catch(filterException e)	{ jaspRCPP_setErrorMsg(e.what()); return "script is not safe..";	}
 
-	if(filterColumnsUsed.size() > 0)	jaspRCPP_runScript("data <- .readFilterDatasetToEnd();\nattach(data);\noptions(warn=1, showWarnCalls=TRUE, showErrorCalls=TRUE, show.error.messages=TRUE)"); //first we load the data to be filtered
+	bool dataAttached = filterColumnsUsed.size() > 0 && rbridge_readFilterData();
+
+	if(dataAttached)	jaspRCPP_runScript("attach(data);\noptions(warn=1, showWarnCalls=TRUE, showErrorCalls=TRUE, show.error.messages=TRUE)"); //first we load the data to be filtered
 	std::string result = jaspRCPP_evalRCode(rCode64.c_str());
-	if(filterColumnsUsed.size() > 0)	jaspRCPP_runScript("detach(data)");	//and afterwards we make sure it is detached to avoid superfluous messages and possible clobbering of analyses
+	if(dataAttached)	jaspRCPP_runScript("detach(data)");	//and afterwards we make sure it is detached to avoid superfluous messages and possible clobbering of analyses
 
 	jaspRCPP_setErrorMsg(rbridge_decodeColumnNamesFromBase64(jaspRCPP_getLastErrorMsg()).c_str());
 
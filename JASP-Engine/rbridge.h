@@ -32,6 +32,7 @@
 #include <regex>
 #include <boost/function.hpp>
 #include "../JASP-Common/dataset.h"
+#include "../JASP-Common/enginecounters.h"
 #include "../JASP-R-Interface/jasprcpp_interface.h"
 #include "r_functionwhitelist.h"
 
@@ -63,12 +64,13 @@ extern "C" {
 
 	typedef boost::function<std::string (const std::string &, int progress)> RCallback;
 
-	void rbridge_init(sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction);
+	void rbridge_init(sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction, resourceUsageFuncDef resourceUsageFunction, progressFuncDef progressFunction);
 
 	void rbridge_setFileNameSource(			boost::function<void(const std::string &, std::string &, std::string &)> source);
 	void rbridge_setStateFileSource(		boost::function<void(std::string &, std::string &)> source);
 	void rbridge_setJaspResultsFileSource(	boost::function<void(std::string &, std::string &)> source);
 	void rbridge_setDataSetSource(			boost::function<DataSet *()> source);
+	void rbridge_setCounters(				engineCounters * counters); ///< Time spent in rbridge_readDataSet is added to counters->dataExtractionUs
 
 	std::string rbridge_runModuleCall(const std::string &name, const std::string &title, const std::string &moduleCall, const std::string &dataKey, const std::string &options, const std::string &stateKey, const std::string &perform, int ppi, int analysisID, int analysisRevision, const std::string &imageBackground);
 
@@ -91,5 +93,7 @@ extern "C" {
 	std::string			rbridge_evalRCodeWhiteListed(			const std::string & rCode);
 	bool				rbridge_columnUsedInFilter(				const char * columnName);
 	void				rbridge_findColumnsUsedInDataSet();
+	bool				rbridge_readFilterData();
+	uint64_t			rbridge_columnFingerprint(				Column & column);
 
 #endif // RBRIDGE_H
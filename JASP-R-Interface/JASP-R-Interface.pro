@@ -41,6 +41,8 @@ SOURCES += \
     jaspResults/src/jaspPlot.cpp \
     jaspResults/src/jaspResults.cpp \
     jaspResults/src/jaspTable.cpp \
+    jaspResults/src/jaspTableColumn.cpp \
+    jaspResults/src/jaspBinaryJson.cpp \
     jaspResults/src/jaspState.cpp
 
 HEADERS += \
@@ -61,6 +63,8 @@ HEADERS += \
     jaspResults/src/jaspPlot.h \
     jaspResults/src/jaspResults.h \
     jaspResults/src/jaspTable.h \
+    jaspResults/src/jaspTableColumn.h \
+    jaspResults/src/jaspBinaryJson.h \
     jaspResults/src/jaspModuleRegistration.h \
     jaspResults/src/jaspState.h
 
@@ -0,0 +1,237 @@
+#include "jaspBinaryJson.h"
+#include <cstring>
+
+const std::string jaspBinaryJson::magic = "JASPRESULTSBIN1\n";
+
+void jaspBinaryJson::need(const std::string & in, size_t pos, size_t bytes)
+{
+	if(pos + bytes > in.size())
+		throw std::runtime_error("jaspBinaryJson input is truncated");
+}
+
+void jaspBinaryJson::writeBigEndian(std::string & out, uint64_t value, int bytes)
+{
+	for(int byte=bytes - 1; byte >= 0; byte--)
+		out.push_back(static_cast<char>((value >> (byte * 8)) & 0xff));
+}
+
+uint64_t jaspBinaryJson::readBigEndian(const std::string & in, size_t & pos, int bytes)
+{
+	need(in, pos, bytes);
+
+	uint64_t value = 0;
+	for(int byte=0; byte<bytes; byte++)
+		value = (value << 8) | static_cast<unsigned char>(in[pos++]);
+
+	return value;
+}
+
+void jaspBinaryJson::writeSized(std::string & out, size_t size, unsigned char fix, size_t fixMax, unsigned char code8, unsigned char code16, unsigned char code32)
+{
+	if(size <= fixMax)						out.push_back(static_cast<char>(fix | size));
+	else if(code8 != 0 && size <= 0xff)		{ out.push_back(static_cast<char>(code8));	writeBigEndian(out, size, 1); }
+	else if(size <= 0xffff)					{ out.push_back(static_cast<char>(code16));	writeBigEndian(out, size, 2); }
+	else									{ out.push_back(static_cast<char>(code32));	writeBigEndian(out, size, 4); }
+}
+
+void jaspBinaryJson::writeString(std::string & out, const std::string & str)
+{
+	writeSized(out, str.size(), 0xa0, 31, 0xd9, 0xda, 0xdb);
+	out += str;
+}
+
+void jaspBinaryJson::writeMapHeader(std::string & out, size_t size)
+{
+	writeSized(out, size, 0x80, 15, 0, 0xde, 0xdf);
+}
+
+void jaspBinaryJson::writeBinary(std::string & out, const std::string & bytes)
+{
+	out.push_back(static_cast<char>(0xc6));
+	writeBigEndian(out, bytes.size(), 4);
+	out += bytes;
+}
+
+void jaspBinaryJson::write(std::string & out, const Json::Value & value)
+{
+	switch(value.type())
+	{
+	case Json::nullValue:		out.push_back(static_cast<char>(0xc0));							return;
+	case Json::booleanValue:	out.push_back(static_cast<char>(value.asBool() ? 0xc3 : 0xc2));	return;
+
+	case Json::intValue:
+	{
+#ifdef JSON_HAS_INT64
+		int64_t number = value.asLargestInt();
+#else
+		int64_t number = value.asInt();
+#endif
+		if(number >= 0 && number <= 0x7f)	out.push_back(static_cast<char>(number));
+		else								{ out.push_back(static_cast<char>(0xd3)); writeBigEndian(out, static_cast<uint64_t>(number), 8); }
+		return;
+	}
+
+	case Json::uintValue: //always the long form, so that it comes back as a uint and not an int
+	{
+#ifdef JSON_HAS_INT64
+		uint64_t number = value.asLargestUInt();
+#else
+		uint64_t number = value.asUInt();
+#endif
+		out.push_back(static_cast<char>(0xcf));
+		writeBigEndian(out, number, 8);
+		return;
+	}
+
+	case Json::realValue:
+	{
+		double		number	= value.asDouble();
+		uint64_t	bits;
+		memcpy(&bits, &number, sizeof(bits));
+
+		out.push_back(static_cast<char>(0xcb));
+		writeBigEndian(out, bits, 8);
+		return;
+	}
+
+	case Json::stringValue:
+		writeString(out, value.asString());
+		return;
+
+	case Json::arrayValue:
+		writeSized(out, value.size(), 0x90, 15, 0, 0xdc, 0xdd);
+		for(const Json::Value & element : value)
+			write(out, element);
+		return;
+
+	case Json::objectValue:
+		writeMapHeader(out, value.size());
+		for(const std::string & name : value.getMemberNames())
+		{
+			writeString(out, name);
+			write(out, value[name]);
+		}
+		return;
+	}
+}
+
+std::string jaspBinaryJson::readString(const std::string & in, size_t & pos)
+{
+	need(in, pos, 1);
+	unsigned char	code	= static_cast<unsigned char>(in[pos++]);
+	size_t			length	= 0;
+
+	if((code & 0xe0) == 0xa0)	length = code & 0x1f;
+	else if(code == 0xd9)		length = readBigEndian(in, pos, 1);
+	else if(code == 0xda)		length = readBigEndian(in, pos, 2);
+	else if(code == 0xdb)		length = readBigEndian(in, pos, 4);
+	else						throw std::runtime_error("jaspBinaryJson expected a string");
+
+	need(in, pos, length);
+	std::string str(in, pos, length);
+	pos += length;
+
+	return str;
+}
+
+size_t jaspBinaryJson::readMapHeader(const std::string & in, size_t & pos)
+{
+	need(in, pos, 1);
+	unsigned char code = static_cast<unsigned char>(in[pos++]);
+
+	if((code & 0xf0) == 0x80)	return code & 0x0f;
+	if(code == 0xde)			return readBigEndian(in, pos, 2);
+	if(code == 0xdf)			return readBigEndian(in, pos, 4);
+
+	throw std::runtime_error("jaspBinaryJson expected a map");
+}
+
+size_t jaspBinaryJson::readArrayHeader(const std::string & in, size_t & pos)
+{
+	need(in, pos, 1);
+	unsigned char code = static_cast<unsigned char>(in[pos++]);
+
+	if((code & 0xf0) == 0x90)	return code & 0x0f;
+	if(code == 0xdc)			return readBigEndian(in, pos, 2);
+	if(code == 0xdd)			return readBigEndian(in, pos, 4);
+
+	throw std::runtime_error("jaspBinaryJson expected an array");
+}
+
+void jaspBinaryJson::readBinary(const std::string & in, size_t & pos, size_t & start, size_t & length)
+{
+	need(in, pos, 1);
+	if(static_cast<unsigned char>(in[pos++]) != 0xc6)
+		throw std::runtime_error("jaspBinaryJson expected a binary blob");
+
+	length	= readBigEndian(in, pos, 4);
+	start	= pos;
+
+	need(in, pos, length);
+	pos += length;
+}
+
+Json::Value jaspBinaryJson::read(const std::string & in, size_t & pos)
+{
+	need(in, pos, 1);
+	unsigned char code = static_cast<unsigned char>(in[pos]);
+
+	if(code <= 0x7f)			{ pos++; return Json::Value(static_cast<int>(code));			}
+	if(code >= 0xe0)			{ pos++; return Json::Value(static_cast<int>(static_cast<signed char>(code)));	}
+	if((code & 0xe0) == 0xa0)	return Json::Value(readString(in, pos));
+
+	if((code & 0xf0) == 0x90 || code == 0xdc || code == 0xdd)
+	{
+		Json::Value	array(Json::arrayValue);
+		size_t		size = readArrayHeader(in, pos);
+
+		for(size_t i=0; i<size; i++)
+			array.append(read(in, pos));
+
+		return array;
+	}
+
+	if((code & 0xf0) == 0x80 || code == 0xde || code == 0xdf)
+	{
+		Json::Value	object(Json::objectValue);
+		size_t		size = readMapHeader(in, pos);
+
+		for(size_t i=0; i<size; i++)
+		{
+			std::string name	= readString(in, pos);
+			object[name]		= read(in, pos);
+		}
+
+		return object;
+	}
+
+	pos++;
+
+	switch(code)
+	{
+	case 0xc0:	return Json::nullValue;
+	case 0xc2:	return Json::Value(false);
+	case 0xc3:	return Json::Value(true);
+	case 0xd9:
+	case 0xda:
+	case 0xdb:	pos--; return Json::Value(readString(in, pos));
+
+#ifdef JSON_HAS_INT64
+	case 0xd3:	return Json::Value(static_cast<Json::Int64>(readBigEndian(in, pos, 8)));
+	case 0xcf:	return Json::Value(static_cast<Json::UInt64>(readBigEndian(in, pos, 8)));
+#else
+	case 0xd3:	return Json::Value(static_cast<Json::Int>(static_cast<int64_t>(readBigEndian(in, pos, 8))));
+	case 0xcf:	return Json::Value(static_cast<Json::UInt>(readBigEndian(in, pos, 8)));
+#endif
+
+	case 0xcb:
+	{
+		uint64_t	bits	= readBigEndian(in, pos, 8);
+		double		number;
+		memcpy(&number, &bits, sizeof(number));
+		return Json::Value(number);
+	}
+	}
+
+	throw std::runtime_error("jaspBinaryJson encountered an unknown type code");
+}
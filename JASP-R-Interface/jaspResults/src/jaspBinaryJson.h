@@ -0,0 +1,28 @@
+#pragma once
+#include "jaspObject.h"
+
+///Compact binary encoding of Json::Value following MessagePack, used to store jaspResults between runs.
+///Parsing and writing it is much cheaper than styled Json, and it has a bin type so that objects can be stored as separate blobs and copied around without decoding them.
+///Malformed input makes the read functions throw a std::runtime_error.
+class jaspBinaryJson
+{
+public:
+	static const std::string magic; ///Starts every file written by jaspResults::saveResults, without it the file is the old styled Json
+
+	static void			write(			std::string & out, const Json::Value & value);
+	static void			writeString(	std::string & out, const std::string & str);
+	static void			writeMapHeader(	std::string & out, size_t size);
+	static void			writeBinary(	std::string & out, const std::string & bytes);
+
+	static Json::Value	read(			const std::string & in, size_t & pos);
+	static std::string	readString(		const std::string & in, size_t & pos);
+	static size_t		readMapHeader(	const std::string & in, size_t & pos);
+	static void			readBinary(		const std::string & in, size_t & pos, size_t & start, size_t & length); ///Gives the location of the blob instead of a copy
+
+private:
+	static void			writeBigEndian(	std::string & out, uint64_t value, int bytes);
+	static uint64_t		readBigEndian(	const std::string & in, size_t & pos, int bytes);
+	static void			writeSized(		std::string & out, size_t size, unsigned char fix, size_t fixMax, unsigned char code8, unsigned char code16, unsigned char code32);
+	static size_t		readArrayHeader(const std::string & in, size_t & pos);
+	static void			need(			const std::string & in, size_t pos, size_t bytes);
+};
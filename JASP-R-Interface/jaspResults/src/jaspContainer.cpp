@@ -1,4 +1,5 @@
 #include "jaspContainer.h"
+#include "jaspBinaryJson.h"
 
 
 void jaspContainer::insert(std::string field, Rcpp::RObject value)
@@ -228,14 +229,21 @@ void jaspContainer::completeChildren()
 
 Json::Value jaspContainer::convertToJSON()
 {
-	Json::Value obj			= jaspObject::convertToJSON();
-	obj["data"]				= Json::objectValue;
-	obj["data_order"]		= Json::objectValue;
-	obj["order_increment"]	= _order_increment;
+	Json::Value obj	= convertToJSONWithoutChildren();
+	obj["data"]		= Json::objectValue;
 
 	for(auto d : _data)
 		obj["data"][d.first] = d.second->convertToJSON();
 
+	return obj;
+}
+
+Json::Value jaspContainer::convertToJSONWithoutChildren()
+{
+	Json::Value obj			= jaspObject::convertToJSON();
+	obj["data_order"]		= Json::objectValue;
+	obj["order_increment"]	= _order_increment;
+
 	for(auto d : _data_order)
 		if(_data.count(d.first) > 0) //no need to keep remembering lost items positions
 			obj["data_order"][d.first] = d.second;
@@ -243,6 +251,42 @@ Json::Value jaspContainer::convertToJSON()
 	return obj;
 }
 
+void jaspContainer::convertToBinary(std::string & out)
+{
+	//The container itself is always encoded again, but each child goes in a separate blob so that untouched ones are simply copied
+	jaspBinaryJson::write(out, convertToJSONWithoutChildren());
+	jaspBinaryJson::writeMapHeader(out, _data.size());
+
+	for(auto d : _data)
+	{
+		std::string child;
+		d.second->convertToBinary(child);
+
+		jaspBinaryJson::writeString(out, d.first);
+		jaspBinaryJson::writeBinary(out, child);
+	}
+}
+
+void jaspContainer::convertFromBinary_Children(const std::string & in, size_t & pos)
+{
+	size_t childCount = jaspBinaryJson::readMapHeader(in, pos);
+
+	for(size_t i=0; i<childCount; i++)
+	{
+		std::string	name	= jaspBinaryJson::readString(in, pos);
+		size_t		start, length;
+
+		jaspBinaryJson::readBinary(in, pos, start, length);
+
+		size_t childPos = start;
+		_data[name]		= jaspObject::convertFromBinary(in, childPos);
+		addChild(_data[name]);
+
+		if(childPos != start + length)
+			throw std::runtime_error("Stored jaspObject " + name + " does not fill its blob");
+	}
+}
+
 void jaspContainer::convertFromJSON_SetFields(Json::Value in)
 {
 	jaspObject::convertFromJSON_SetFields(in);
@@ -266,7 +310,7 @@ void jaspContainer::convertFromJSON_SetFields(Json::Value in)
 		_data_order[dataOrderEntry] = dataOrderIn.get(dataOrderEntry, -1).asInt();
 }
 
-void jaspContainer::checkDependenciesChildren(Json::Value currentOptions)
+void jaspContainer::checkDependenciesChildren(const jaspOptionFingerprints & currentOptions)
 {
 	std::vector<std::string> removeThese;
 	for(auto & d : _data)
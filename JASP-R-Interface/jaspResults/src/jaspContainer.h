@@ -38,9 +38,12 @@ public:
 
 	static jaspContainer * jaspContainerFromRcppList(Rcpp::List convertThis);
 
-	Json::Value convertToJSON() override;
-	void		convertFromJSON_SetFields(Json::Value in) override;
-	void		checkDependenciesChildren(Json::Value currentOptions) override;
+	Json::Value			convertToJSON() override;
+	virtual Json::Value	convertToJSONWithoutChildren(); ///Everything convertToJSON gives except "data"
+	void				convertFromJSON_SetFields(Json::Value in) override;
+	void				convertToBinary(std::string & out) override;
+	void				convertFromBinary_Children(const std::string & in, size_t & pos) override;
+	void		checkDependenciesChildren(const jaspOptionFingerprints & currentOptions) override;
 
 	void		completeChildren();
 	void		setError() override;
@@ -1,7 +1,9 @@
 #define ENUM_DECLARATION_CPP
 #include "jaspObject.h"
 #include "jaspJson.h"
+#include "jaspBinaryJson.h"
 #include <chrono>
+#include <cstring>
 
 #if defined(_WIN32) || !defined(JASP_R_INTERFACE_LIBRARY)
 #include "lib_json/json_value.cpp" //hacky way to get libjson in the code ^^
@@ -151,10 +153,18 @@ void jaspObject::notifyParentOfChanges()
 	std::cout << "notifyParentOfChanges()! parent is " << ( parent == NULL ? "NULL" : parent->title) << "\n" << std::flush;
 #endif
 
+	touch();
+
 	if(parent != NULL)
 		parent->childrenUpdatedCallback();
 }
 
+void jaspObject::convertToBinary(std::string & out)
+{
+	if(!_touched && _savedBinary.size() > 0)	out += _savedBinary;
+	else										jaspBinaryJson::write(out, convertToJSON());
+}
+
 void jaspObject::childrenUpdatedCallback()
 {
 #ifdef JASP_RESULTS_DEBUG_TRACES
@@ -275,66 +285,143 @@ void jaspObject::convertFromJSON_SetFields(Json::Value in)
 		_messages.push_back(msg.asString());
 
 	_optionMustBe.clear();
+	_optionMustBeFingerprints.clear();
 	Json::Value mustBe(in.get("optionMustBe", Json::objectValue));
 	for(auto & mustBeKey : mustBe.getMemberNames())
-		_optionMustBe[mustBeKey] = mustBe[mustBeKey];
+		setOptionMustBe(mustBeKey, mustBe[mustBeKey]);
 
 	_optionMustContain.clear();
+	_optionMustContainFingerprints.clear();
 	Json::Value mustContain(in.get("optionMustContain", Json::objectValue));
 	for(auto & mustContainKey : mustContain.getMemberNames())
-		_optionMustContain[mustContainKey] = mustContain[mustContainKey];
+		setOptionMustContain(mustContainKey, mustContain[mustContainKey]);
 
 }
 
 Json::Value jaspObject::currentOptions = Json::nullValue;
 
+void jaspOptionFingerprints::set(const Json::Value & options)
+{
+	_options.clear();
+	_elements.clear();
+
+	if(!options.isObject())
+		return;
+
+	for(const std::string & name : options.getMemberNames())
+	{
+		const Json::Value & option = options[name];
+
+		_options[name] = fingerprint(option);
+
+		if(option.isArray())
+			for(const Json::Value & element : option)
+				_elements[name].insert(fingerprint(element));
+	}
+}
+
+uint64_t jaspOptionFingerprints::option(const std::string & name) const
+{
+	static const uint64_t nullFingerprint = fingerprint(Json::nullValue);
+
+	auto found = _options.find(name);
+	return found == _options.end() ? nullFingerprint : found->second;
+}
+
+bool jaspOptionFingerprints::optionContains(const std::string & name, uint64_t element) const
+{
+	auto found = _elements.find(name);
+	return found != _elements.end() && found->second.count(element) > 0;
+}
+
+uint64_t jaspOptionFingerprints::fingerprint(const Json::Value & value)
+{
+	uint64_t	hash	= 14695981039346656037ULL ^ static_cast<uint64_t>(value.type()); //The type goes in first because operator== says an int is never equal to a double
+	auto		mix		= [&hash](uint64_t word) { hash ^= word + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+
+	switch(value.type())
+	{
+	case Json::intValue:
+	case Json::uintValue:
+	case Json::realValue:
+	{
+		double		number	= value.asDouble();
+		uint64_t	bits;
+		memcpy(&bits, &number, sizeof(bits));
+		mix(bits);
+		break;
+	}
+
+	case Json::stringValue:		mix(std::hash<std::string>()(value.asString()));	break;
+	case Json::booleanValue:	mix(value.asBool() ? 1 : 0);						break;
+
+	case Json::arrayValue:
+		mix(value.size());
+		for(const Json::Value & element : value)
+			mix(fingerprint(element));
+		break;
+
+	case Json::objectValue:
+		mix(value.size());
+		for(const std::string & name : value.getMemberNames()) //these are sorted so the order in which they were added does not matter, just like for operator==
+		{
+			mix(std::hash<std::string>()(name));
+			mix(fingerprint(value[name]));
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return hash;
+}
+
 void jaspObject::dependOnOptions(Rcpp::CharacterVector listOptions)
 {
 	if(currentOptions.isNull()) Rf_error("No options known!");
 
 	for(auto & nameOption : listOptions)
-		_optionMustBe[Rcpp::as<std::string>(nameOption)] = currentOptions.get(nameOption, Json::nullValue);
+		setOptionMustBe(Rcpp::as<std::string>(nameOption), currentOptions.get(nameOption, Json::nullValue));
 }
 
 void jaspObject::setOptionMustBeDependency(std::string optionName, Rcpp::RObject mustBeThis)
 {
-	_optionMustBe[optionName]	= jaspJson::RObject_to_JsonValue(mustBeThis);
+	setOptionMustBe(optionName, jaspJson::RObject_to_JsonValue(mustBeThis));
 }
 
 void jaspObject::setOptionMustContainDependency(std::string optionName, Rcpp::RObject mustContainThis)
 {
-	_optionMustContain[optionName] = jaspJson::RObject_to_JsonValue(mustContainThis);
+	setOptionMustContain(optionName, jaspJson::RObject_to_JsonValue(mustContainThis));
 }
 
 void jaspObject::copyDependenciesFromJaspObject(jaspObject * other)
 {
-	for(auto fieldVal : other->_optionMustBe)
+	for(auto & fieldVal : other->_optionMustBe)
 		_optionMustBe[fieldVal.first] = fieldVal.second;
 
-	for(auto fieldVal : other->_optionMustContain)
+	for(auto & fieldVal : other->_optionMustBeFingerprints)
+		_optionMustBeFingerprints[fieldVal.first] = fieldVal.second;
+
+	for(auto & fieldVal : other->_optionMustContain)
 		_optionMustContain[fieldVal.first] = fieldVal.second;
+
+	for(auto & fieldVal : other->_optionMustContainFingerprints)
+		_optionMustContainFingerprints[fieldVal.first] = fieldVal.second;
 }
 
-bool jaspObject::checkDependencies(Json::Value currentOptions)
+bool jaspObject::checkDependencies(const jaspOptionFingerprints & currentOptions)
 {
-	if((_optionMustBe.size() + _optionMustContain.size()) == 0)
+	if((_optionMustBeFingerprints.size() + _optionMustContainFingerprints.size()) == 0)
 		return true;
 
-	for(auto & keyval : _optionMustBe)
-		if(currentOptions.get(keyval.first, Json::nullValue) != keyval.second)
+	for(auto & keyval : _optionMustBeFingerprints)
+		if(currentOptions.option(keyval.first) != keyval.second)
 			return false;
 
-	for(auto & keyval : _optionMustContain)
-	{
-		bool foundIt = false;
-
-		for(auto & contains : currentOptions.get(keyval.first, Json::arrayValue))
-			if(contains == keyval.second)
-				foundIt = true;
-
-		if(!foundIt)
+	for(auto & keyval : _optionMustContainFingerprints)
+		if(!currentOptions.optionContains(keyval.first, keyval.second))
 			return false;
-	}
 
 	checkDependenciesChildren(currentOptions);
 
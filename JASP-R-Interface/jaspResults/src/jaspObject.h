@@ -3,6 +3,7 @@
 #include <set>
 #include <sstream>
 #include <queue>
+#include <cstdint>
 #include "enumutilities.h"
 #ifdef JASP_R_INTERFACE_LIBRARY
 #include "jsonredirect.h"
@@ -21,6 +22,21 @@ std::string					stringExtend(std::string & str, size_t len, char kar = ' ');
 std::string					stringRemove(std::string str, char kar = ' ');
 std::vector<std::string>	stringSplit(std::string str, char kar = ';');
 
+///Fingerprints of the top-level options, computed once per run so that the dependency checks of all objects compare 64-bit numbers instead of whole Json trees.
+class jaspOptionFingerprints
+{
+public:
+	void				set(const Json::Value & options);
+	uint64_t			option(const std::string & name)							const;
+	bool				optionContains(const std::string & name, uint64_t element)	const;
+
+	static uint64_t		fingerprint(const Json::Value & value); ///Equal for Json::Values that are equal according to operator==
+
+private:
+	std::map<std::string, uint64_t>				_options;
+	std::map<std::string, std::set<uint64_t>>	_elements;	///For array options, used by the optionMustContain checks
+};
+
 //Simple base-class for all JASP-objects, containing things like a title or a warning and stuff like that
 class jaspObject
 {
@@ -43,8 +59,8 @@ public:
 			std::string	getWarning()						{ return _warning; }
 			void		setWarning(std::string warning)		{ _warning = warning; _warningSet = true; }
 			bool		getError()							{ return _error; }
-	virtual void		setError()							{ _error = true; }
-	virtual void		setError(std::string message)		{ _errorMessage = message; _error = true; }
+	virtual void		setError()							{ _error = true; touch(); }
+	virtual void		setError(std::string message)		{ _errorMessage = message; _error = true; touch(); }
 
 			void		print()								{ try { jaspPrint(toString()); } catch(std::exception e) { jaspPrint(std::string("toString failed because of: ") + e.what()); } }
 			void		addMessage(std::string msg)			{ _messages.push_back(msg); }
@@ -55,8 +71,8 @@ public:
 			void		dependOnOptions(Rcpp::CharacterVector listOptions);
 			void		copyDependenciesFromJaspObject(jaspObject * other);
 
-			bool		checkDependencies(Json::Value currentOptions); //returns false if no longer valid and destroys children (if applicable) that are no longer valid
-	virtual	void		checkDependenciesChildren(Json::Value currentOptions) {}
+			bool		checkDependencies(const jaspOptionFingerprints & currentOptions); //returns false if no longer valid and destroys children (if applicable) that are no longer valid
+	virtual	void		checkDependenciesChildren(const jaspOptionFingerprints & currentOptions) {}
 
 			void		addCitation(std::string fullCitation);
 
@@ -108,6 +124,12 @@ public:
 	static	jaspObject *	convertFromJSON(Json::Value in);
 	virtual	void			convertFromJSON_SetFields(Json::Value in);
 
+	virtual	void			convertToBinary(std::string & out); ///Appends the object in jaspBinaryJson form, reusing the bytes it was loaded from when it wasn't touched since
+	static	jaspObject *	convertFromBinary(const std::string & in, size_t & pos);
+	virtual	void			convertFromBinary_Children(const std::string & in, size_t & pos) {}
+
+			void			touch() { _touched = true; _savedBinary.clear(); } ///Marks the object as changed since it was loaded, so convertToBinary encodes it again
+
 	Rcpp::DataFrame convertFactorsToCharacters(Rcpp::DataFrame df);
 
 	static Json::Value currentOptions;
@@ -129,6 +151,11 @@ protected:
 
 	std::map<std::string, Json::Value> _optionMustBe;
 	std::map<std::string, Json::Value> _optionMustContain;
+	std::map<std::string, uint64_t> _optionMustBeFingerprints;		///Kept in sync with _optionMustBe through setOptionMustBe
+	std::map<std::string, uint64_t> _optionMustContainFingerprints;	///Kept in sync with _optionMustContain through setOptionMustContain
+
+			void	setOptionMustBe(		const std::string & optionName, const Json::Value & mustBe)			{ _optionMustBe[optionName]			= mustBe;		_optionMustBeFingerprints[optionName]		= jaspOptionFingerprints::fingerprint(mustBe);		}
+			void	setOptionMustContain(	const std::string & optionName, const Json::Value & mustContain)	{ _optionMustContain[optionName]	= mustContain;	_optionMustContainFingerprints[optionName]	= jaspOptionFingerprints::fingerprint(mustContain);	}
 
 //Should add dependencies somehow here?
 
@@ -146,7 +173,9 @@ protected:
 	static std::set<jaspObject*> * allocatedObjects;
 
 private:
-	bool					_finalizedAlready = false;
+	bool					_finalizedAlready	= false,
+							_touched			= true;
+	std::string				_savedBinary;
 };
 
 
@@ -162,6 +191,7 @@ class jaspObject_Interface
 public:
 	jaspObject_Interface(jaspObject * dataObj) : myJaspObject(dataObj)
 	{
+		myJaspObject->touch(); //Once R can get at an object it might change it in any way
 #ifdef JASP_RESULTS_DEBUG_TRACES
 		std::cout << "Interface to " << dataObj->objectTitleString() << " is created!\n"<<std::flush;
 #endif
@@ -173,6 +203,7 @@ public:
 		std::cout << "Interface to " << copyMe->myJaspObject->objectTitleString() << " is copied!\n"<<std::flush;
 #endif
 		myJaspObject = copyMe->myJaspObject;
+		myJaspObject->touch();
 	}
 
 	void		print()								{ myJaspObject->print(); }
@@ -214,11 +245,11 @@ void jaspObjectFinalizer(jaspObject * obj);
 
 RCPP_EXPOSED_CLASS_NODECL(jaspObject_Interface)
 
-//#define JASP_R_INTERFACE_TIMERS
-
-#ifdef JASP_R_INTERFACE_TIMERS
-#define JASP_OBJECT_TIMERBEGIN			static int cumulativeTime = 0;	int startSerialize = getCurrentTimeMs();
-#define JASP_OBJECT_TIMEREND(ACTIVITY)	cumulativeTime += getCurrentTimeMs() - startSerialize;	std::cout << jaspObjectTypeToString(getType()) << " spent " << cumulativeTime << "ms " #ACTIVITY "!" << std::endl;
+//Inside JASP these go to the tracer of the jaspEngine through the functions it gave jaspResults::setTraceFuncs, the standalone jaspResults package has nothing to trace to.
+//They need jaspResults.h, which every file that uses them already includes.
+#ifdef JASP_R_INTERFACE_LIBRARY
+#define JASP_OBJECT_TIMERBEGIN			uint64_t jaspObjectTimerStart = jaspResults::traceBegin();
+#define JASP_OBJECT_TIMEREND(ACTIVITY)	jaspResults::traceEnd("jaspResults " #ACTIVITY, jaspObjectTimerStart);
 #else
 #define JASP_OBJECT_TIMERBEGIN			/* Doin' nothing */
 #define JASP_OBJECT_TIMEREND(ACTIVITY)	/* What you didn't start you need not stop */
@@ -1,9 +1,16 @@
 #include "jaspModuleRegistration.h"
+#include "jaspBinaryJson.h"
+#include "fastjson.h"
 #include <fstream>
 #include <cmath>
 
 sendFuncDef			jaspResults::_ipccSendFunc		= nullptr;
 pollMessagesFuncDef jaspResults::_ipccPollFunc		= nullptr;
+resourceUsageFuncDef jaspResults::_resourceUsageFunc	= nullptr;
+progressFuncDef		jaspResults::_progressFunc		= nullptr;
+traceBeginDef		jaspResults::_traceBeginFunc	= nullptr;
+traceEndDef			jaspResults::_traceEndFunc		= nullptr;
+std::string			jaspResults::_abortReason		= "";
 std::string			jaspResults::_saveResultsHere	= "";
 std::string			jaspResults::_baseCitation		= "";
 Rcpp::Environment*	jaspResults::_RStorageEnv		= nullptr;
@@ -21,6 +28,22 @@ void jaspResults::setPollMessagesFunc(pollMessagesFuncDef pollFunc)
 	_ipccPollFunc = pollFunc;
 }
 
+void jaspResults::setResourceUsageFunc(resourceUsageFuncDef resourceUsageFunc)
+{
+	_resourceUsageFunc = resourceUsageFunc;
+}
+
+void jaspResults::setProgressFunc(progressFuncDef progressFunc)
+{
+	_progressFunc = progressFunc;
+}
+
+void jaspResults::setTraceFuncs(traceBeginDef traceBeginFunc, traceEndDef traceEndFunc)
+{
+	_traceBeginFunc	= traceBeginFunc;
+	_traceEndFunc	= traceEndFunc;
+}
+
 void jaspResults::setBaseCitation(std::string baseCitation)
 {
 	_baseCitation = baseCitation;
@@ -93,10 +116,11 @@ void jaspResults::saveResults()
 		return;
 	}
 
-	std::ofstream saveHere(_saveResultsHere);
-	Json::Value json = convertToJSON();
+	std::string binary = jaspBinaryJson::magic;
+	convertToBinary(binary);
 
-	saveHere << json.toStyledString();
+	std::ofstream saveHere(_saveResultsHere, std::ios::binary);
+	saveHere.write(binary.data(), binary.size());
 	JASP_OBJECT_TIMEREND(saveResults)
 }
 
@@ -107,13 +131,44 @@ void jaspResults::loadResults()
 
 	if(_saveResultsHere == "") return;
 
-	std::ifstream loadThis(_saveResultsHere);
+	std::ifstream loadThis(_saveResultsHere, std::ios::binary);
+
+	if(!loadThis.is_open())
+	{
+		//Results stored by an older version are styled Json in jaspResults.json next to where the binary ones go now
+		std::string	jsonLocation	= _saveResultsHere;
+		size_t		extension		= jsonLocation.rfind(".bin");
+
+		if(extension == std::string::npos) return;
 
-	if(!loadThis.is_open()) return;
+		loadThis.open(jsonLocation.replace(extension, 4, ".json"), std::ios::binary);
+
+		if(!loadThis.is_open()) return;
+	}
+
+	std::string contents((std::istreambuf_iterator<char>(loadThis)), std::istreambuf_iterator<char>());
+
+	if(contents.compare(0, jaspBinaryJson::magic.size(), jaspBinaryJson::magic) == 0)
+	{
+		try
+		{
+			size_t pos = jaspBinaryJson::magic.size();
+			convertFromJSON_SetFields(jaspBinaryJson::read(contents, pos));
+			convertFromBinary_Children(contents, pos);
+		}
+		catch(std::runtime_error & e)
+		{
+			jaspPrint(std::string("Loading stored jaspResults failed because of: ") + e.what());
+		}
+
+		JASP_OBJECT_TIMEREND(loadResults);
+		return;
+	}
 
+	//Results stored by an older version are styled Json
 	Json::Value val;
 
-	Json::Reader().parse(loadThis, val);
+	Json::Reader().parse(contents, val);
 
 	if(!val.isObject()) return;
 
@@ -131,8 +186,9 @@ void jaspResults::changeOptions(std::string opts)
 
 void jaspResults::setOptions(std::string opts)
 {
-	Json::Reader().parse(opts, _currentOptions);
+	fastJson::parse(opts, _currentOptions);
 	jaspObject::currentOptions = _currentOptions;
+	_currentOptionFingerprints.set(_currentOptions);
 
 	if(_previousOptions != Json::nullValue)
 		pruneInvalidatedData();
@@ -140,7 +196,7 @@ void jaspResults::setOptions(std::string opts)
 
 void jaspResults::pruneInvalidatedData()
 {
-	checkDependenciesChildren(_currentOptions);
+	checkDependenciesChildren(_currentOptionFingerprints);
 }
 
 void jaspResults::send(std::string otherMsg)
@@ -149,8 +205,15 @@ void jaspResults::send(std::string otherMsg)
 	JASPprint("send was called!");
 #endif
 
+	//The progress of a full snapshot must reach the engine as well, otherwise the desktop keeps reading the last tick sent without results.
+	if(otherMsg == "" && _progressFunc != nullptr)
+		(*_progressFunc)(_response["progress"].asInt());
+
 	if(_ipccSendFunc != nullptr)
 		(*_ipccSendFunc)(otherMsg == "" ? constructResultJson() : otherMsg.c_str());
+
+	if(otherMsg == "")
+		_changedSinceSend = false;
 }
 
 void jaspResults::checkForAnalysisChanged()
@@ -158,7 +221,19 @@ void jaspResults::checkForAnalysisChanged()
 	if(_ipccPollFunc == nullptr)
 		return;
 
-	if((*_ipccPollFunc)())
+	bool changed = (*_ipccPollFunc)();
+
+	if(_abortReason != "")
+	{
+		//A validationError ends up as a normal errormessage in the results instead of a stacktrace
+		Rcpp::List condition	= Rcpp::List::create(Rcpp::Named("message") = _abortReason, Rcpp::Named("call") = R_NilValue);
+		condition.attr("class")	= Rcpp::CharacterVector::create("validationError", "error", "condition");
+
+		static Rcpp::Function stop("stop");
+		stop(condition);
+	}
+
+	if(changed)
 	{
 		setStatus("changed");
 	  static Rcpp::Function stop("stop");
@@ -175,6 +250,8 @@ void jaspResults::childrenUpdatedCallbackHandler()
 
 	checkForAnalysisChanged(); //can "throw" Rf_error
 
+	_changedSinceSend = true;
+
 	int curTime = getCurrentTimeMs();
 	if(_sendingFeedbackLastTime == -1 || (curTime - _sendingFeedbackLastTime) > _sendingFeedbackInterval)
 	{
@@ -202,8 +279,16 @@ const char * jaspResults::constructResultJson()
 		_response["results"]["errorMessage"] = "Analyis returned an error but no errormessage...";
 	}
 
+	if(_resourceUsageFunc != nullptr)
+	{
+		std::string status		= getStatus();
+		bool		finished	= status != "running" && status != "waiting" && status != "changed";
+
+		fastJson::parse((*_resourceUsageFunc)(finished), _response["resources"]);
+	}
+
 	static std::string msg;
-	msg = _response.toStyledString();
+	msg = fastJson::write(_response);
 
 #ifdef JASP_RESULTS_DEBUG_TRACES
 	std::cout << "Result JSON:\n" << msg << "\n\n" << std::flush;
@@ -366,9 +451,9 @@ Rcpp::List jaspResults::getKeepList()
 	return keep;
 }
 
-Json::Value jaspResults::convertToJSON()
+Json::Value jaspResults::convertToJSONWithoutChildren()
 {
-	Json::Value obj			= jaspContainer::convertToJSON();
+	Json::Value obj			= jaspContainer::convertToJSONWithoutChildren();
 
 	obj["relativePathKeep"] = _relativePathKeep;
 	obj["options"]			= _currentOptions;
@@ -383,6 +468,7 @@ void jaspResults::convertFromJSON_SetFields(Json::Value in)
 	_relativePathKeep	= in.get("relativePathKeep",	"null").asString();
 	_currentOptions		= in.get("options",				Json::objectValue);
 	_previousOptions	= _currentOptions;
+	_currentOptionFingerprints.set(_currentOptions);
 }
 
 void jaspResults::startProgressbar(int expectedTicks, int timeBetweenUpdatesInMs)
@@ -409,7 +495,8 @@ void jaspResults::progressbarTick()
 	int curTime = getCurrentTimeMs();
 	if(curTime - _progressbarLastUpdateTime > _progressbarBetweenUpdatesTime || progress == 100)
 	{
-		send();
+		if(_changedSinceSend || _progressFunc == nullptr)	send();
+		else												(*_progressFunc)(progress);
 		
 		if (progress == 100)
 			resetProgressbar();
@@ -455,6 +542,23 @@ jaspObject * jaspObject::convertFromJSON(Json::Value in)
 	return newObject;
 }
 
+jaspObject * jaspObject::convertFromBinary(const std::string & in, size_t & pos)
+{
+	size_t			start		= pos;
+	jaspObject *	newObject	= convertFromJSON(jaspBinaryJson::read(in, pos));
+
+	newObject->convertFromBinary_Children(in, pos);
+
+	if(newObject->getType() != jaspObjectType::container)
+	{
+		//Nothing changed yet, so saving it again can just copy these bytes
+		newObject->_savedBinary	= in.substr(start, pos - start);
+		newObject->_touched		= false;
+	}
+
+	return newObject;
+}
+
 Rcpp::RObject jaspResults::getObjectFromEnv(std::string envName)
 {
 	if(_RStorageEnv->exists(envName))
@@ -6,6 +6,10 @@
 #else
 typedef void (*sendFuncDef)(const char *);
 typedef bool (*pollMessagesFuncDef)();
+typedef const char * (*resourceUsageFuncDef)(bool analysisFinished);
+typedef void (*progressFuncDef)(int progress);
+typedef uint64_t (*traceBeginDef)();
+typedef void (*traceEndDef)(const char * name, uint64_t beganNs);
 //If you edit any function(signatures) or objects for JASP* Rcpp modules and you want to run it as an R-Package you should run Rcpp::compileAttributes from an R instance started in $PWD/JASP-R-Interface/jaspResults
 #endif
 
@@ -17,6 +21,12 @@ public:
 	//static functions to allow the values to be set before the constructor is called from R. Would be nicer to just run the constructor in C++ maybe?
 	static void setSendFunc(sendFuncDef sendFunc);
 	static void setPollMessagesFunc(pollMessagesFuncDef pollFunc);
+	static void setResourceUsageFunc(resourceUsageFuncDef resourceUsageFunc);
+	static void setProgressFunc(progressFuncDef progressFunc); ///< Lets a tick of the progressbar get to the desktop without sending all results again
+	static void setTraceFuncs(traceBeginDef traceBeginFunc, traceEndDef traceEndFunc); ///< The tracer of the jaspEngine (see timers.h), passed in because JASP-R-Interface does not link JASP-Common on every platform
+	static uint64_t traceBegin()									{ return _traceBeginFunc ? (*_traceBeginFunc)() : 0; }
+	static void		traceEnd(const char * name, uint64_t beganNs)	{ if(_traceEndFunc && beganNs) (*_traceEndFunc)(name, beganNs); }
+	static void setAbortReason(std::string reason) { _abortReason = reason; } ///< If not empty the analysis is stopped with reason as validation error the next time it checks for changes
 	static void setResponseData(int analysisID, int revision);
 	static void setSaveLocation(const char * newSaveLocation);
 	static void setBaseCitation(std::string baseCitation);
@@ -52,7 +62,7 @@ public:
 
 	std::string _relativePathKeep;
 
-	Json::Value convertToJSON() override;
+	Json::Value convertToJSONWithoutChildren() override;
 	void		convertFromJSON_SetFields(Json::Value in) override;
 
 	void startProgressbar(int expectedTicks, int timeBetweenUpdatesInMs = 500);
@@ -67,6 +77,11 @@ private:
 	static Json::Value				_response;
 	static sendFuncDef				_ipccSendFunc;
 	static pollMessagesFuncDef		_ipccPollFunc;
+	static resourceUsageFuncDef		_resourceUsageFunc;
+	static progressFuncDef			_progressFunc;
+	static traceBeginDef			_traceBeginFunc;
+	static traceEndDef				_traceEndFunc;
+	static std::string				_abortReason;
 	static std::string				_saveResultsHere;
 	static std::string				_baseCitation;
 	static bool						_insideJASP;
@@ -78,6 +93,8 @@ private:
 	Json::Value	_currentOptions		= Json::nullValue,
 				_previousOptions	= Json::nullValue;
 
+	jaspOptionFingerprints	_currentOptionFingerprints;
+
 	void addSerializedPlotObjsForStateFromJaspObject(jaspObject * obj, Rcpp::List & pngImgObj);
 	void addPlotPathsForKeepFromJaspObject(jaspObject * obj, Rcpp::List & pngPathImgObj);
 	void addSerializedOtherObjsForStateFromJaspObject(jaspObject * obj, Rcpp::List & cumulativeList);
@@ -90,6 +107,7 @@ private:
 			_progressbarBetweenUpdatesTime	= 500,
 			_sendingFeedbackLastTime		= -1,
 			_sendingFeedbackInterval		= 500;
+	bool	_changedSinceSend				= false; ///< Whether the results differ from what was sent last, otherwise a progressbar tick only needs to send its progress
 };
 
 void JASPresultFinalizer(jaspResults * obj);
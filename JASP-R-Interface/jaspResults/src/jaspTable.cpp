@@ -59,7 +59,7 @@ void jaspTable::setData(Rcpp::RObject newData)
 }
 
 
-void jaspTable::addOrSetColumnInData(std::vector<Json::Value> column, std::string colName)
+void jaspTable::addOrSetColumnInData(const jaspTableColumn & column, std::string colName)
 {
 	if(colName == "")
 		_data.push_back(column);
@@ -100,7 +100,7 @@ int jaspTable::getDesiredColumnIndexFromNameForColumnAdding(std::string colName)
 	return desiredIndex;
 }
 
-int jaspTable::pushbackToColumnInData(std::vector<Json::Value> column, std::string colName, int equalizedColumnsLength, int previouslyAddedUnnamed)
+int jaspTable::pushbackToColumnInData(const jaspTableColumn & column, std::string colName, int equalizedColumnsLength, int previouslyAddedUnnamed)
 {
 	int desiredColumnIndex = getDesiredColumnIndexFromNameForRowAdding(colName, previouslyAddedUnnamed);
 
@@ -114,8 +114,7 @@ int jaspTable::pushbackToColumnInData(std::vector<Json::Value> column, std::stri
 	if(_data[desiredColumnIndex].size() < equalizedColumnsLength)
 		_data[desiredColumnIndex].resize(equalizedColumnsLength);
 
-	for(auto element : column)
-		_data[desiredColumnIndex].push_back(element);
+	_data[desiredColumnIndex].append(column);
 
 	if(colName != "")
 		_colNames[desiredColumnIndex] = colName;
@@ -234,7 +233,7 @@ void jaspTable::addColumnsFromList(Rcpp::List newData)
 	extractRowNames(newData, true);
 
 	for(int col=0; col<newData.size(); col++)
-		addOrSetColumnInData(jaspJson::RcppVector_to_VectorJson((Rcpp::RObject)newData[col], false), localColNames.size() > col ? localColNames[col] : "");
+		addOrSetColumnInData(jaspTableColumn::fromRObject((Rcpp::RObject)newData[col], false), localColNames.size() > col ? localColNames[col] : "");
 }
 
 ///Logically we must assume that each entry in the list is a single element vector
@@ -248,10 +247,7 @@ void jaspTable::setColumnFromList(Rcpp::List column, int colIndex)
 	_data[colIndex].clear();
 
 	for(int row=0; row<column.size(); row++)
-	{
-		std::vector<Json::Value> jsonVec = jaspJson::RcppVector_to_VectorJson((Rcpp::RObject)column[row], false);
-		_data[colIndex].push_back(jsonVec.size() > 0 ? jsonVec[0u] : Json::nullValue);
-	}
+		_data[colIndex].appendCell(jaspTableColumn::fromRObject((Rcpp::RObject)column[row], false), 0);
 }
 
 int jaspTable::equalizeColumnsLengths()
@@ -261,20 +257,17 @@ int jaspTable::equalizeColumnsLengths()
 
 	size_t maximumFoundColumnLength = 0;
 
-	for(auto col : _data)
+	for(const auto & col : _data)
 		maximumFoundColumnLength = std::max(maximumFoundColumnLength, col.size());
 
-	for(auto col : _data)
-		for(int row = col.size(); row < maximumFoundColumnLength; row++)
-			col.push_back(Json::Value(Json::nullValue));
-
+	//The columns are not padded here, pushbackToColumnInData pads the ones it appends to and getCell fills in the rest.
 	return maximumFoundColumnLength;
 }
 
 Json::Value jaspTable::getCell(size_t col, size_t row)
 {
 	if(col < _data.size() && row < _data[col].size())
-		return _data[col][row];
+		return _data[col].cell(row);
 
 	bool amIExpected = col < _expectedColumnCount && row < _expectedRowCount;
 	return amIExpected ? Json::Value(".") : Json::nullValue;
@@ -1085,6 +1078,10 @@ Json::Value	jaspTable::rowsJson()
 		}
 	}
 
+	std::vector<std::string> colNames;
+	for(size_t col=0; col<std::max(_data.size(), _expectedColumnCount); col++)
+		colNames.push_back(getColName(col));
+
 	bool keepGoing = true;
 	for(size_t row=0; keepGoing; row++)
 	{
@@ -1096,11 +1093,11 @@ Json::Value	jaspTable::rowsJson()
 			if(_data[col].size() > row)
 				aColumnKeepsGoing = true;
 
-			aRow[getColName(col)] = getCell(col, row);
+			aRow[colNames[col]] = getCell(col, row);
 		}
 
 		for(size_t col=_data.size(); col<_expectedColumnCount; col++)
-			aRow[getColName(col)] = ".";
+			aRow[colNames[col]] = ".";
 
 		std::string rowName = getRowName(row);
 		if(footnotesPerRowCol.count(rowName) > 0)
@@ -1136,35 +1133,39 @@ std::string jaspTable::deriveColumnType(int col)
 	Json::ValueType workingType = Json::nullValue;
 	const std::string variousType = "various";
 
-	for(auto & cell : _data[col])
+	for(size_t row=0; row<_data[col].size(); row++)
+	{
+		Json::ValueType cellType = _data[col].cellJsonType(row);
+
 		switch(workingType)
 		{
 		case Json::nullValue:
-			workingType = cell.type();
+			workingType = cellType;
 			break;
 
 		case Json::stringValue:
 		case Json::booleanValue:
-			if(cell.type() != workingType)
+			if(cellType != workingType)
 				return variousType;
 			break;
 
 		case Json::intValue:
 		case Json::uintValue:
-			if(cell.type() == Json::realValue)
+			if(cellType == Json::realValue)
 				workingType = Json::realValue;
-			else if(cell.type() != workingType)
+			else if(cellType != workingType)
 				return variousType;
 			break;
 
 		case Json::realValue:
-			if(!(cell.type() == workingType || cell.type() == Json::intValue || cell.type() == Json::uintValue))
+			if(!(cellType == workingType || cellType == Json::intValue || cellType == Json::uintValue))
 				return variousType;
 			break;
 
 		default:
 			return "composite"; //arrays and objects are not really supported as cells at the moment but maybe we could add that in the future?
 		}
+	}
 
 	switch(workingType)
 	{
@@ -1230,15 +1231,8 @@ Json::Value jaspTable::convertToJSON()
 
 	Json::Value dataColumns(Json::arrayValue);
 
-	for(auto & col : _data)
-	{
-		Json::Value dataRows(Json::arrayValue);
-
-		for(auto & row : col)
-			dataRows.append(row);
-
-		dataColumns.append(dataRows);
-	}
+	for(const auto & col : _data)
+		dataColumns.append(col.toJSON());
 
 	obj["data"]	= dataColumns;
 
@@ -1282,14 +1276,7 @@ void jaspTable::convertFromJSON_SetFields(Json::Value in)
 	_data.clear();
 	Json::Value dataColumns(in.get("data",	Json::arrayValue));
 	for(auto & col : dataColumns)
-	{
-		std::vector<Json::Value> newCol;
-
-		for(auto & rowElem : col)
-			newCol.push_back(rowElem);
-
-		_data.push_back(newCol);
-	}
+		_data.push_back(jaspTableColumn(col));
 
 	_colRowCombinations.clear();
 	Json::Value colRowCombos(in.get("colRowCombinations",	Json::arrayValue));
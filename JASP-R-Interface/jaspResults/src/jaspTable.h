@@ -2,6 +2,7 @@
 #include "jaspObject.h"
 #include "jaspList.h"
 #include "jaspJson.h"
+#include "jaspTableColumn.h"
 
 struct jaspColRowCombination
 {
@@ -89,7 +90,7 @@ public:
 
 	std::string dataToString(std::string prefix) override;
 
-	void		complete() { if(_status == "running") _status = "complete"; }
+	void		complete() { if(_status == "running") { _status = "complete"; touch(); } }
 
 	Json::Value	metaEntry() override { return constructMetaEntry("table"); }
 	Json::Value	dataEntry() override;
@@ -133,8 +134,8 @@ private:
 	Json::Value convertToJSON()								override;
 	void		convertFromJSON_SetFields(Json::Value in)	override;
 
-	void	addOrSetColumnInData(std::vector<Json::Value> column, std::string colName="");
-	int		pushbackToColumnInData(std::vector<Json::Value> column, std::string colName, int equalizedColumnsLength, int previouslyAddedUnnamed);
+	void	addOrSetColumnInData(const jaspTableColumn & column, std::string colName="");
+	int		pushbackToColumnInData(const jaspTableColumn & column, std::string colName, int equalizedColumnsLength, int previouslyAddedUnnamed);
 
 	template<int RTYPE>	void setDataFromVector(Rcpp::Vector<RTYPE> newData)
 	{
@@ -142,10 +143,13 @@ private:
 		extractRowNames(newData, true);
 
 		_data.clear();
-		auto cols = jaspJson::RcppVector_to_VectorJson<RTYPE>(newData);
 
-		for(int col=0; col<cols.size(); col++)
-			addOrSetColumnInData(std::vector<Json::Value>({cols[col]}), localColNames.size() > col ? localColNames[col] : "");
+		for(int col=0; col<newData.size(); col++)
+		{
+			jaspTableColumn cell;
+			cell.appendEntry<RTYPE>(newData, col);
+			addOrSetColumnInData(cell, localColNames.size() > col ? localColNames[col] : "");
+		}
 	}
 
 	void setDataFromList(Rcpp::List newData)
@@ -155,7 +159,7 @@ private:
 
 		_data.clear();
 		for(size_t col=0; col<newData.size(); col++)
-			addOrSetColumnInData(jaspJson::RcppVector_to_VectorJson((Rcpp::RObject)newData[col]), localColNames.size() > col ? localColNames[col] : "");
+			addOrSetColumnInData(jaspTableColumn::fromRObject((Rcpp::RObject)newData[col]), localColNames.size() > col ? localColNames[col] : "");
 	}
 
 	template<int RTYPE> void setDataFromMatrix(Rcpp::Matrix<RTYPE> newData)
@@ -163,11 +167,9 @@ private:
 		std::vector<std::string> localColNames = extractElementOrColumnNames(newData);
 		extractRowNames(newData, true);
 
-		std::vector<std::vector<Json::Value>> jsonMat = jaspJson::RcppMatrix_to_Vector2Json<RTYPE>(newData);
-
 		_data.clear();
-		for(size_t col=0; col<jsonMat.size(); col++)
-			addOrSetColumnInData(jsonMat[col], localColNames.size() > col ? localColNames[col] : "");
+		for(int col=0; col<newData.ncol(); col++)
+			addOrSetColumnInData(jaspTableColumn::fromMatrixColumn<RTYPE>(newData.column(col)), localColNames.size() > col ? localColNames[col] : "");
 	}
 
 	void addColumnsFromList(Rcpp::List newData);
@@ -176,7 +178,7 @@ private:
 	{
 		setRowNamesWhereApplicable(extractElementOrColumnNames(newData));
 
-		_data.push_back(jaspJson::RcppVector_to_VectorJson<RTYPE>(newData));
+		_data.push_back(jaspTableColumn::fromVector<RTYPE>(newData));
 	}
 
 	template<int RTYPE>	void setColumnFromVector(Rcpp::Vector<RTYPE> newData, size_t col)
@@ -185,7 +187,7 @@ private:
 
 		if(_data.size() <= col)
 			_data.resize(col+1);
-		_data[col] = jaspJson::RcppVector_to_VectorJson<RTYPE>(newData);
+		_data[col] = jaspTableColumn::fromVector<RTYPE>(newData);
 	}
 
 	void setColumnFromList(Rcpp::List column, int colIndex);
@@ -195,26 +197,26 @@ private:
 		std::vector<std::string> localColNames = extractElementOrColumnNames(newData);
 		extractRowNames(newData, true);
 
-		std::vector<std::vector<Json::Value>> jsonMat = jaspJson::RcppMatrix_to_Vector2Json<RTYPE>(newData);
-
-		for(size_t col=0; col<jsonMat.size(); col++)
-			addOrSetColumnInData(jsonMat[col], localColNames.size() > col ? localColNames[col] : "");
+		for(int col=0; col<newData.ncol(); col++)
+			addOrSetColumnInData(jaspTableColumn::fromMatrixColumn<RTYPE>(newData.column(col)), localColNames.size() > col ? localColNames[col] : "");
 	}
 
 	template<int RTYPE>	void addRowFromVector(Rcpp::Vector<RTYPE> newData, Rcpp::CharacterVector newRowNames)
 	{
 		std::vector<std::string> localColNames = extractElementOrColumnNames(newData);
 
-		auto row = jaspJson::RcppVector_to_VectorJson<RTYPE>(newData);
-
 		int equalizedColumnsLength = equalizeColumnsLengths();
 		int previouslyAddedUnnamedCols = 0;
 
 		for(int row=0; row<newRowNames.size(); row++)
 			_rowNames[row + equalizedColumnsLength] = newRowNames[row];
 
-		for(int col=0; col<row.size(); col++)
-			previouslyAddedUnnamedCols = pushbackToColumnInData(std::vector<Json::Value>({row[col]}), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
+		for(int col=0; col<newData.size(); col++)
+		{
+			jaspTableColumn cell;
+			cell.appendEntry<RTYPE>(newData, col);
+			previouslyAddedUnnamedCols = pushbackToColumnInData(cell, localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
+		}
 
 	}
 
@@ -261,10 +263,10 @@ private:
 			if(Rcpp::is<Rcpp::List>(rij))
 				 localColNames = extractElementOrColumnNames<Rcpp::List>(Rcpp::as<Rcpp::List>(rij));
 
-			auto jsonRij = jaspJson::RcppVector_to_VectorJson(rij);
+			jaspTableColumn cells = jaspTableColumn::fromRObject(rij);
 
-			for(size_t col=0; col<jsonRij.size(); col++)
-				previouslyAddedUnnamedCols = pushbackToColumnInData(std::vector<Json::Value>({jsonRij[col]}), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
+			for(size_t col=0; col<cells.size(); col++)
+				previouslyAddedUnnamedCols = pushbackToColumnInData(cells.singleCell(col), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
 
 		}
 
@@ -281,8 +283,7 @@ private:
 		for(size_t col=0; col<newData.size(); col++)
 		{
 			Rcpp::RObject kolom			= (Rcpp::RObject)newData[col];
-			auto jsonKolom				= jaspJson::RcppVector_to_VectorJson(kolom);
-			previouslyAddedUnnamedCols	= pushbackToColumnInData(jsonKolom, localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
+			previouslyAddedUnnamedCols	= pushbackToColumnInData(jaspTableColumn::fromRObject(kolom), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
 		}
 
 	}
@@ -298,10 +299,8 @@ private:
 		for(int row=0; row<newRowNames.size(); row++)
 			_rowNames[row + equalizedColumnsLength] = newRowNames[row];
 
-		auto jsonMatrix = jaspJson::RcppMatrix_to_Vector2Json<RTYPE>(newData);
-
-		for(int col=0; col<jsonMatrix.size(); col++)
-			previouslyAddedUnnamedCols = pushbackToColumnInData(std::vector<Json::Value>({jsonMatrix[col]}), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
+		for(int col=0; col<newData.ncol(); col++)
+			previouslyAddedUnnamedCols = pushbackToColumnInData(jaspTableColumn::fromMatrixColumn<RTYPE>(newData.column(col)), localColNames.size() > col ? localColNames[col] : "", equalizedColumnsLength, previouslyAddedUnnamedCols);
 	}
 
 	void setRowNamesWhereApplicable(std::vector<std::string> rowNamesList)
@@ -386,7 +385,7 @@ public:
 
 private:
 	footnotes 								_footnotes;
-	std::vector<std::vector<Json::Value>>	_data;	//First columns, then rows.
+	std::vector<jaspTableColumn>			_data;	//First columns, then rows.
 	std::vector<jaspColRowCombination>		_colRowCombinations;
 	size_t									_expectedColumnCount	= 0,
 											_expectedRowCount		= 0;
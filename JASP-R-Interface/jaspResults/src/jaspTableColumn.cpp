@@ -0,0 +1,202 @@
+#include "jaspTableColumn.h"
+#include "jaspJson.h"
+
+jaspTableColumn::jaspTableColumn(const Json::Value & cells)
+{
+	reserve(cells.size());
+
+	for(const Json::Value & cell : cells)
+		push_back(cell);
+}
+
+void jaspTableColumn::clear()
+{
+	_types.clear();
+	_payloads.clear();
+	_strings.clear();
+	_jsons.clear();
+}
+
+void jaspTableColumn::resize(size_t rows)
+{
+	if(rows <= size())
+	{
+		//The strings and jsons of the removed rows stay behind until the next clear, but shrinking a column is rare
+		_types.resize(rows);
+		_payloads.resize(rows);
+		return;
+	}
+
+	reserve(rows);
+
+	while(size() < rows)
+		pushNull();
+}
+
+void jaspTableColumn::pushNull()
+{
+	cellPayload payload;
+	payload.index = 0;
+
+	_types.push_back(jaspTableCellType::null);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::pushReal(double value)
+{
+	cellPayload payload;
+	payload.real = value;
+
+	_types.push_back(jaspTableCellType::real);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::pushInteger(int value)
+{
+	cellPayload payload;
+	payload.integer = value;
+
+	_types.push_back(jaspTableCellType::integer);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::pushLogical(bool value)
+{
+	cellPayload payload;
+	payload.logical = value;
+
+	_types.push_back(jaspTableCellType::logical);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::pushString(const std::string & value)
+{
+	cellPayload payload;
+	payload.index = _strings.size();
+
+	_strings.push_back(value);
+	_types.push_back(jaspTableCellType::string);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::push_back(const Json::Value & cell)
+{
+	switch(cell.type())
+	{
+	case Json::nullValue:		pushNull();							return;
+	case Json::booleanValue:	pushLogical(cell.asBool());			return;
+	case Json::stringValue:		pushString(cell.asString());		return;
+	case Json::realValue:		pushReal(cell.asDouble());			return;
+	case Json::intValue:
+	case Json::uintValue:
+		if(cell.isInt())	pushInteger(cell.asInt());
+		else				pushReal(cell.asDouble());
+		return;
+	default:
+		break;
+	}
+
+	cellPayload payload;
+	payload.index = _jsons.size();
+
+	_jsons.push_back(cell);
+	_types.push_back(jaspTableCellType::json);
+	_payloads.push_back(payload);
+}
+
+void jaspTableColumn::append(const jaspTableColumn & other)
+{
+	reserve(size() + other.size());
+
+	for(size_t row=0; row<other.size(); row++)
+		appendCell(other, row);
+}
+
+void jaspTableColumn::appendCell(const jaspTableColumn & other, size_t row)
+{
+	if(row >= other.size())
+	{
+		pushNull();
+		return;
+	}
+
+	const cellPayload & payload = other._payloads[row];
+
+	switch(other._types[row])
+	{
+	case jaspTableCellType::null:		pushNull();									break;
+	case jaspTableCellType::real:		pushReal(payload.real);						break;
+	case jaspTableCellType::integer:	pushInteger(payload.integer);				break;
+	case jaspTableCellType::logical:	pushLogical(payload.logical);				break;
+	case jaspTableCellType::string:		pushString(other._strings[payload.index]);	break;
+	case jaspTableCellType::json:		push_back(other._jsons[payload.index]);		break;
+	}
+}
+
+Json::Value jaspTableColumn::cell(size_t row) const
+{
+	if(row >= size())
+		return Json::nullValue;
+
+	const cellPayload & payload = _payloads[row];
+
+	switch(_types[row])
+	{
+	case jaspTableCellType::real:		return Json::Value(payload.real);
+	case jaspTableCellType::integer:	return Json::Value(payload.integer);
+	case jaspTableCellType::logical:	return Json::Value(payload.logical);
+	case jaspTableCellType::string:		return Json::Value(_strings[payload.index]);
+	case jaspTableCellType::json:		return _jsons[payload.index];
+	default:							return Json::nullValue;
+	}
+}
+
+Json::ValueType jaspTableColumn::cellJsonType(size_t row) const
+{
+	if(row >= size())
+		return Json::nullValue;
+
+	switch(_types[row])
+	{
+	case jaspTableCellType::real:		return Json::realValue;
+	case jaspTableCellType::integer:	return Json::intValue;
+	case jaspTableCellType::logical:	return Json::booleanValue;
+	case jaspTableCellType::string:		return Json::stringValue;
+	case jaspTableCellType::json:		return _jsons[_payloads[row].index].type();
+	default:							return Json::nullValue;
+	}
+}
+
+Json::Value jaspTableColumn::toJSON() const
+{
+	Json::Value cells(Json::arrayValue);
+
+	for(size_t row=0; row<size(); row++)
+		cells.append(cell(row));
+
+	return cells;
+}
+
+jaspTableColumn jaspTableColumn::fromRObject(Rcpp::RObject obj, bool throwError)
+{
+	if(Rcpp::is<Rcpp::NumericVector>(obj))			return fromVector<REALSXP>((Rcpp::NumericVector)	obj);
+	else if(Rcpp::is<Rcpp::LogicalVector>(obj))		return fromVector<LGLSXP>((Rcpp::LogicalVector)		obj);
+	else if(Rcpp::is<Rcpp::IntegerVector>(obj))		return fromVector<INTSXP>((Rcpp::IntegerVector)		obj);
+	else if(Rcpp::is<Rcpp::StringVector>(obj))		return fromVector<STRSXP>((Rcpp::StringVector)		obj);
+	else if(Rcpp::is<Rcpp::CharacterVector>(obj))	return fromVector<STRSXP>((Rcpp::CharacterVector)	obj);
+	else if(Rcpp::is<Rcpp::List>(obj))
+	{
+		Rcpp::List		list = (Rcpp::List)obj;
+		jaspTableColumn	column;
+
+		for(int row=0; row<list.size(); row++)
+			column.push_back(jaspJson::RObject_to_JsonValue((Rcpp::RObject)list[row]));
+
+		return column;
+	}
+	else if(throwError) Rf_error("jaspTableColumn::fromRObject received an SEXP that is not a Vector of some kind.");
+
+	jaspTableColumn column;
+	column.pushString("");
+	return column;
+}
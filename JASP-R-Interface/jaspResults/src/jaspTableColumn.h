@@ -0,0 +1,109 @@
+#pragma once
+#include "jaspObject.h"
+#include <limits>
+#include "stringutils.h"
+
+enum class jaspTableCellType : unsigned char { null, real, integer, logical, string, json };
+
+///A column of table cells stored per type instead of as a vector of Json::Value, cells only become Json when the table is serialized.
+///Each row has a type and an 8 byte payload, strings and the occasional composite Json value (from a list) are kept aside and indexed from the payload.
+class jaspTableColumn
+{
+	union cellPayload
+	{
+		double	real;
+		int		integer;
+		bool	logical;
+		size_t	index;
+	};
+
+public:
+	jaspTableColumn() {}
+	jaspTableColumn(const Json::Value & cells);
+
+	size_t			size()						const	{ return _types.size(); }
+	bool			isNull(size_t row)			const	{ return row >= _types.size() || _types[row] == jaspTableCellType::null; }
+	void			clear();
+	void			resize(size_t rows);
+
+	void			pushNull();
+	void			pushReal(double value);
+	void			pushInteger(int value);
+	void			pushLogical(bool value);
+	void			pushString(const std::string & value);
+	void			push_back(const Json::Value & cell);
+
+	void			append(const jaspTableColumn & other);
+	void			appendCell(const jaspTableColumn & other, size_t row);
+	jaspTableColumn	singleCell(size_t row)		const	{ jaspTableColumn out; out.appendCell(*this, row); return out; }
+
+	Json::Value		cell(size_t row)			const;
+	Json::ValueType	cellJsonType(size_t row)	const;
+	Json::Value		toJSON()					const;
+
+	///Converts the entry like jaspJson::RVectorEntry_to_JsonValue would, so NA becomes "" and NaN and infinity become strings.
+	template<int RTYPE, typename CONTAINER> void appendEntry(CONTAINER & obj, int row) { appendEntry(obj, row, std::integral_constant<int, RTYPE>()); }
+
+	template<int RTYPE> static jaspTableColumn fromVector(Rcpp::Vector<RTYPE> obj)
+	{
+		jaspTableColumn column;
+		column.reserve(obj.size());
+
+		for(int row=0; row<obj.size(); row++)
+			column.appendEntry<RTYPE>(obj, row);
+
+		return column;
+	}
+
+	template<int RTYPE> static jaspTableColumn fromMatrixColumn(Rcpp::MatrixColumn<RTYPE> obj)
+	{
+		jaspTableColumn column;
+		column.reserve(obj.size());
+
+		for(int row=0; row<obj.size(); row++)
+			column.appendEntry<RTYPE>(obj, row);
+
+		return column;
+	}
+
+	static jaspTableColumn fromRObject(Rcpp::RObject obj, bool throwError = false);
+
+private:
+	void reserve(size_t rows) { _types.reserve(rows); _payloads.reserve(rows); }
+
+	template<typename CONTAINER> void appendEntry(CONTAINER & obj, int row, std::integral_constant<int, INTSXP>)
+	{
+		int val = obj[row];
+		if(val == NA_INTEGER)	pushString("");
+		else					pushInteger(val);
+	}
+
+	template<typename CONTAINER> void appendEntry(CONTAINER & obj, int row, std::integral_constant<int, LGLSXP>)
+	{
+		int val = obj[row];
+		if(val == NA_LOGICAL)	pushString("");
+		else					pushLogical(val != 0);
+	}
+
+	template<typename CONTAINER> void appendEntry(CONTAINER & obj, int row, std::integral_constant<int, STRSXP>)
+	{
+		if(obj[row] == NA_STRING)	pushString("");
+		else						pushString(stringUtils::escapeHtmlStuff((std::string)(obj[row])));
+	}
+
+	template<typename CONTAINER> void appendEntry(CONTAINER & obj, int row, std::integral_constant<int, REALSXP>)
+	{
+		double val = static_cast<double>(obj[row]);
+
+		if(R_IsNA(val))												pushString("");
+		else if(R_IsNaN(val))										pushString("NaN");
+		else if(val ==		std::numeric_limits<double>::infinity())	pushString("\u221E");
+		else if(val == -1 *	std::numeric_limits<double>::infinity())	pushString("-\u221E");
+		else														pushReal(val);
+	}
+
+	std::vector<jaspTableCellType>	_types;
+	std::vector<cellPayload>		_payloads;
+	std::vector<std::string>		_strings;
+	std::vector<Json::Value>		_jsons;		//arrays and objects are not really supported as cells but lists can contain them
+};
@@ -50,8 +50,9 @@ static std::string			_R_HOME = "";
 
 extern "C" {
 void STDCALL jaspRCPP_init(const char* buildYear, const char* version, RBridgeCallBacks* callbacks,
-	sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction,
-	logFlushDef logFlushFunction, logWriteDef logWriteFunction)
+	sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction, resourceUsageFuncDef resourceUsageFunction,
+	progressFuncDef progressFunction, logFlushDef logFlushFunction, logWriteDef logWriteFunction,
+	traceBeginDef traceBeginFunction, traceEndDef traceEndFunction)
 {
 
 	_logFlushFunction		= logFlushFunction;
@@ -108,6 +109,9 @@ void STDCALL jaspRCPP_init(const char* buildYear, const char* version, RBridgeCa
 
 	jaspResults::setSendFunc(sendToDesktopFunction);
 	jaspResults::setPollMessagesFunc(pollMessagesFunction);
+	jaspResults::setResourceUsageFunc(resourceUsageFunction);
+	jaspResults::setProgressFunc(progressFunction);
+	jaspResults::setTraceFuncs(traceBeginFunction, traceEndFunction);
 	jaspResults::setBaseCitation(baseCitation);
 	jaspResults::setInsideJASP();
 
@@ -383,6 +387,11 @@ const char*	STDCALL jaspRCPP_evalRCode(const char *rCode) {
 	return staticResult.c_str();
 }
 
+void STDCALL jaspRCPP_abortAnalysis(const char *reason)
+{
+	jaspResults::setAbortReason(reason);
+}
+
 } // extern "C"
 
 SEXP jaspRCPP_requestTempFileNameSEXP(SEXP extension)
@@ -38,6 +38,7 @@
 #endif
 
 #include <stdio.h>
+#include <stdint.h>
 
 extern "C" {
 
@@ -104,11 +105,15 @@ struct RBridgeCallBacks {
 
 typedef void	(*sendFuncDef)			(const char *);
 typedef bool	(*pollMessagesFuncDef)	();
+typedef const char*	(*resourceUsageFuncDef)	(bool analysisFinished);
+typedef void	(*progressFuncDef)		(int progress);
 typedef int		(*logFlushDef)			();
 typedef size_t	(*logWriteDef)			(const void * buf, size_t len);
+typedef uint64_t	(*traceBeginDef)	();										///< Returns 0 when tracing is off
+typedef void	(*traceEndDef)			(const char * name, uint64_t beganNs);	///< name must outlive the trace
 
 // Calls from rbridge to jaspRCPP
-RBRIDGE_TO_JASP_INTERFACE void			STDCALL jaspRCPP_init(const char* buildYear, const char* version, RBridgeCallBacks *calbacks, sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction, logFlushDef logFlushFunction, logWriteDef logWriteFunction);
+RBRIDGE_TO_JASP_INTERFACE void			STDCALL jaspRCPP_init(const char* buildYear, const char* version, RBridgeCallBacks *calbacks, sendFuncDef sendToDesktopFunction, pollMessagesFuncDef pollMessagesFunction, resourceUsageFuncDef resourceUsageFunction, progressFuncDef progressFunction, logFlushDef logFlushFunction, logWriteDef logWriteFunction, traceBeginDef traceBeginFunction, traceEndDef traceEndFunction);
 
 RBRIDGE_TO_JASP_INTERFACE const char*	STDCALL jaspRCPP_run(const char* name, const char* title, const char* rfile, bool requiresInit, const char* dataKey, const char* options, const char* resultsMeta, const char* stateKey, const char* perform, int ppi, int analysisID, int analysisRevision, bool usesJaspResults, const char* imageBackground);
 RBRIDGE_TO_JASP_INTERFACE const char*	STDCALL jaspRCPP_check();
@@ -122,6 +127,7 @@ RBRIDGE_TO_JASP_INTERFACE const char*	STDCALL jaspRCPP_runModuleCall(const char*
 RBRIDGE_TO_JASP_INTERFACE const char*	STDCALL jaspRCPP_check();
 
 RBRIDGE_TO_JASP_INTERFACE const char*	STDCALL jaspRCPP_evalRCode(const char *rCode);
+RBRIDGE_TO_JASP_INTERFACE void			STDCALL jaspRCPP_abortAnalysis(const char *reason); //Makes a jaspResults analysis stop with reason as error the next time it checks for changes, "" clears it
 
 RBRIDGE_TO_JASP_INTERFACE int			STDCALL jaspRCPP_runFilter(const char * filtercode, bool ** arraypointer); //arraypointer points to a pointer that will contain the resulting list of filter-booleans if jaspRCPP_runFilter returns > 0
 RBRIDGE_TO_JASP_INTERFACE void			STDCALL jaspRCPP_freeArrayPointer(bool ** arrayPointer);
@@ -60,12 +60,7 @@ windows {
 
 unix: QMAKE_CXXFLAGS += -Werror=return-type
 
-#want to use JASPTIMER_* ? set JASPTIMER_USED to true, run qmake and rebuild the objects that use these macros (or just rebuild everything to be sure)
-JASPTIMER_USED = false
-
-$$JASPTIMER_USED {
-    DEFINES += PROFILE_JASP
-}
+#JASPTIMER_* are always compiled in now, set the environment variable JASP_TRACE or use the engine performance window (Ctrl+Shift+E) to turn tracing on.
 
 exists(/app/lib/*)	{ INSTALLPATH = /app/bin
  } else	{